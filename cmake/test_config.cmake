@@ -2,11 +2,24 @@ include(CTest)
 
 include(cmake/get_cpm.cmake)
 include(cmake/CPM.cmake)
-CPMAddPackage(
-    NAME googletest
-    GITHUB_REPOSITORY google/googletest
-    VERSION 1.14.0
-    OPTIONS
-    "INSTALL_GTEST OFF"
-    "gtest_force_shared_crt ON"
-)
+if(BUFFER_MCU_TEST)
+    CPMAddPackage(
+        NAME googletest
+        GITHUB_REPOSITORY google/googletest
+        VERSION 1.14.0
+        OPTIONS
+        "INSTALL_GTEST OFF"
+        "gtest_force_shared_crt ON"
+    )
+endif()
+if(BUFFER_MCU_BENCH)
+    CPMAddPackage(
+        NAME benchmark
+        GITHUB_REPOSITORY google/benchmark
+        VERSION 1.8.3
+        OPTIONS
+        "BENCHMARK_ENABLE_TESTING OFF"
+        "BENCHMARK_ENABLE_INSTALL OFF"
+        "BENCHMARK_ENABLE_GTEST_TESTS OFF"
+    )
+endif()
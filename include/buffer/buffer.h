@@ -8,14 +8,45 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 // --- Public type
 
 /**
  * \brief Buffer size type
+ * \details uint16_t by default, selected at build time with
+ * BUF_SIZE_TYPE_UINT32 or BUF_SIZE_TYPE_SIZE_T (CMake BUFFER_MCU_SIZE_TYPE)
  */
+#if defined(BUF_SIZE_TYPE_SIZE_T)
+typedef size_t BUF_size_t;
+#elif defined(BUF_SIZE_TYPE_UINT32)
+typedef uint32_t BUF_size_t;
+#else
 typedef uint16_t BUF_size_t;
+#endif
+
+/**
+ * \brief Buffer byte order
+ */
+typedef enum {
+  BUF_ENDIAN_BIG    = 0, /*!< Big-endian, network byte order, default */
+  BUF_ENDIAN_LITTLE = 1, /*!< Little-endian */
+} BUF_Endian_t;
+
+#if defined(BUF_DIGEST_ENABLE)
+/**
+ * \brief Running digest state, \see buffer_digest.h
+ */
+typedef struct BUF_Digest_s BUF_Digest_t;
+#endif
+
+#if defined(BUF_STATS_ENABLE)
+/**
+ * \brief Instrumentation counters, \see buffer_stats.h
+ */
+typedef struct BUF_Stats_s BUF_Stats_t;
+#endif
 
 /**
  * \brief Buffer structure
@@ -26,6 +57,13 @@ typedef struct {
   BUF_size_t write_index; /*!< Write index */
   BUF_size_t read_index;  /*!< Read index */
   BUF_size_t size;        /*!< Buffer size */
+  uint8_t endian;         /*!< Byte order of Auto accessors, BUF_Endian_t */
+#if defined(BUF_DIGEST_ENABLE)
+  BUF_Digest_t* digest; /*!< Digest updated by writes, NULL if none */
+#endif
+#if defined(BUF_STATS_ENABLE)
+  BUF_Stats_t* stats; /*!< Counters updated by accesses, NULL if none */
+#endif
 } BUF_t;
 
 // --- Public function
@@ -35,6 +73,8 @@ typedef struct {
  * \param buffer Buffer to initialize
  * \param data Buffer data
  * \param size Buffer size
+ * \details Byte order is set to BUF_ENDIAN_BIG, digest and stats are
+ * detached
  */
 void BUF_InitEmpty(BUF_t* buffer, uint8_t* data, BUF_size_t size);
 
@@ -48,7 +88,8 @@ void BUF_InitFull(BUF_t* buffer, uint8_t* data, BUF_size_t size);
 
 /**
  * \brief Make buffer view on existing buffer
- * \details Update read_index, write_index and data starting pointer
+ * \details Update read_index, write_index and data starting pointer, byte
+ * order is inherited from src_buffer
  * \warning dst_buffer and src_buffer are sharing the same data
  * \param dst_buffer Destination buffer
  * \param src_buffer Source buffer
@@ -183,6 +224,15 @@ uint16_t BUF_GetUint16(const BUF_t* buffer, BUF_size_t index);
  */
 uint32_t BUF_GetUint32(const BUF_t* buffer, BUF_size_t index);
 
+/**
+ * \brief Get data by index without modify read_index and write_index
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index
+ * \see BUF_ReadUint64 \see BUF_WriteUint64
+ */
+uint64_t BUF_GetUint64(const BUF_t* buffer, BUF_size_t index);
+
 /**
  * \brief Get last data without modify read_index and write_index
  * \param buffer Buffer to check
@@ -217,6 +267,15 @@ uint8_t BUF_PutUint16(BUF_t* buffer, uint16_t data, BUF_size_t index);
  */
 uint8_t BUF_PutUint32(BUF_t* buffer, uint32_t data, BUF_size_t index);
 
+/**
+ * \brief Put 8 bytes in buffer at index
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutUint64(BUF_t* buffer, uint64_t data, BUF_size_t index);
+
 /**
  * \brief Read 1 byte from buffer
  * \param buffer Buffer to read
@@ -238,6 +297,14 @@ uint16_t BUF_ReadUint16(BUF_t* buffer);
  */
 uint32_t BUF_ReadUint32(BUF_t* buffer);
 
+/**
+ * \brief Read 8 bytes from buffer
+ * \param buffer Buffer to read
+ * \return data read
+ * \see BUF_InlineReadUint64
+ */
+uint64_t BUF_ReadUint64(BUF_t* buffer);
+
 /**
  * \brief Write 1 byte to buffer
  * \param buffer Buffer to write to
@@ -251,6 +318,8 @@ uint8_t BUF_WriteUint8(BUF_t* buffer, uint8_t data);
  * \param buffer Buffer to write to
  * \param data Data to write
  * \return written byte count, 0 if error
+ * \details All or nothing, write_index is untouched if not enough free space
+ * \see BUF_InlineWriteUint16
  */
 uint8_t BUF_WriteUint16(BUF_t* buffer, uint16_t data);
 
@@ -259,6 +328,8 @@ uint8_t BUF_WriteUint16(BUF_t* buffer, uint16_t data);
  * \param buffer Buffer to write to
  * \param data Data to write
  * \return written byte count, 0 if error
+ * \details All or nothing, write_index is untouched if not enough free space
+ * \see BUF_InlineWriteUint32
  */
 uint8_t BUF_WriteUint32(BUF_t* buffer, uint32_t data);
 
@@ -267,9 +338,111 @@ uint8_t BUF_WriteUint32(BUF_t* buffer, uint32_t data);
  * \param buffer Buffer to write to
  * \param data Data to write
  * \return written byte count, 0 if error
+ * \details All or nothing, write_index is untouched if not enough free space
+ * \see BUF_InlineWriteUint64
  */
 uint8_t BUF_WriteUint64(BUF_t* buffer, uint64_t data);
 
+/**
+ * \brief Get array of 2 bytes data by index without modify read_index and
+ * write_index
+ * \param buffer Buffer to get from
+ * \param data Array to fill
+ * \param count Array element count
+ * \param index Index to get from
+ * \return read byte count, 0 if error
+ * \details All or nothing, bounds are checked once for the whole array
+ */
+BUF_size_t BUF_GetUint16Array(const BUF_t* buffer,
+                              uint16_t* data,
+                              BUF_size_t count,
+                              BUF_size_t index);
+
+/**
+ * \brief Get array of 4 bytes data by index without modify read_index and
+ * write_index
+ * \param buffer Buffer to get from
+ * \param data Array to fill
+ * \param count Array element count
+ * \param index Index to get from
+ * \return read byte count, 0 if error
+ * \details All or nothing, bounds are checked once for the whole array
+ */
+BUF_size_t BUF_GetUint32Array(const BUF_t* buffer,
+                              uint32_t* data,
+                              BUF_size_t count,
+                              BUF_size_t index);
+
+/**
+ * \brief Put array of 2 bytes data in buffer at index
+ * \param buffer Buffer to put in
+ * \param data Array to put
+ * \param count Array element count
+ * \param index Index to put at
+ * \return written byte count, 0 if error
+ * \details All or nothing, bounds are checked once for the whole array
+ */
+BUF_size_t BUF_PutUint16Array(BUF_t* buffer,
+                              const uint16_t* data,
+                              BUF_size_t count,
+                              BUF_size_t index);
+
+/**
+ * \brief Put array of 4 bytes data in buffer at index
+ * \param buffer Buffer to put in
+ * \param data Array to put
+ * \param count Array element count
+ * \param index Index to put at
+ * \return written byte count, 0 if error
+ * \details All or nothing, bounds are checked once for the whole array
+ */
+BUF_size_t BUF_PutUint32Array(BUF_t* buffer,
+                              const uint32_t* data,
+                              BUF_size_t count,
+                              BUF_size_t index);
+
+/**
+ * \brief Read array of 2 bytes data from buffer
+ * \param buffer Buffer to read
+ * \param data Array to fill
+ * \param count Array element count
+ * \return read byte count, 0 if error
+ * \details All or nothing, bounds are checked once for the whole array
+ */
+BUF_size_t BUF_ReadUint16Array(BUF_t* buffer, uint16_t* data, BUF_size_t count);
+
+/**
+ * \brief Read array of 4 bytes data from buffer
+ * \param buffer Buffer to read
+ * \param data Array to fill
+ * \param count Array element count
+ * \return read byte count, 0 if error
+ * \details All or nothing, bounds are checked once for the whole array
+ */
+BUF_size_t BUF_ReadUint32Array(BUF_t* buffer, uint32_t* data, BUF_size_t count);
+
+/**
+ * \brief Write array of 2 bytes data to buffer
+ * \param buffer Buffer to write to
+ * \param data Array to write
+ * \param count Array element count
+ * \return written byte count, 0 if error
+ * \details All or nothing, bounds are checked once for the whole array
+ */
+BUF_size_t
+BUF_WriteUint16Array(BUF_t* buffer, const uint16_t* data, BUF_size_t count);
+
+/**
+ * \brief Write array of 4 bytes data to buffer
+ * \param buffer Buffer to write to
+ * \param data Array to write
+ * \param count Array element count
+ * \return written byte count, 0 if error
+ * \details All or nothing, bounds are checked once for the whole array
+ */
+BUF_size_t
+BUF_WriteUint32Array(BUF_t* buffer, const uint32_t* data, BUF_size_t count);
+
 /**
  * \brief Write string to buffer
  * \param buffer Buffer to write to
@@ -288,6 +461,16 @@ BUF_size_t BUF_WriteString(BUF_t* buffer, const char* string, BUF_size_t size);
  */
 BUF_size_t BUF_WriteRaw(BUF_t* buffer, const uint8_t* data, BUF_size_t size);
 
+/**
+ * \brief Read raw data from buffer
+ * \param buffer Buffer to read
+ * \param data Destination, must not overlap buffer data
+ * \param size Size to read
+ * \return read byte count, 0 if error
+ * \details All or nothing, one copy
+ */
+BUF_size_t BUF_ReadRaw(BUF_t* buffer, uint8_t* data, BUF_size_t size);
+
 /**
  * \brief Copy from src buffer read index to dst buffer write index
  * \param dst Destination buffer
@@ -303,6 +486,7 @@ BUF_size_t BUF_WriteCopy(BUF_t* dst, BUF_t* src, BUF_size_t size);
  * \param pattern Pattern to fill
  * \param size Size to fill
  * \return Size filled
+ * \details Size 0 is a no-op, not a failed write
  */
 BUF_size_t BUF_FillPattern(BUF_t* buffer, uint8_t pattern, BUF_size_t size);
 
@@ -329,3 +513,663 @@ uint8_t* BUF_GetDataNoConst(const BUF_t* buffer);
  * \return true if equal, false otherwise
  */
 bool BUF_Compare(const BUF_t* buffer1, const uint8_t* data, BUF_size_t size);
+
+// --- Public function, zero-copy
+
+/**
+ * \brief Get writable area at write_index, to fill in place
+ * \param buffer Buffer to write to
+ * \param size Contiguous free size at returned pointer, 0 if error
+ * \return Pointer at write_index, NULL if error or buffer full
+ * \details Nothing is written until BUF_Commit, e.g. DMA or read() target
+ * \see BUF_Commit
+ */
+uint8_t* BUF_Reserve(BUF_t* buffer, BUF_size_t* size);
+
+/**
+ * \brief Append bytes filled in place after BUF_Reserve
+ * \param buffer Buffer written to
+ * \param size Byte count filled, at most reserved size
+ * \return committed byte count, 0 if error
+ * \details All or nothing, write_index is untouched if size exceeds free
+ * size. Size 0 is a no-op, not a failed write
+ */
+BUF_size_t BUF_Commit(BUF_t* buffer, BUF_size_t size);
+
+/**
+ * \brief Get data to read at read_index, without copy
+ * \param buffer Buffer to read
+ * \param size Byte count to read at returned pointer, 0 if error
+ * \return Pointer at read_index, NULL if error or nothing to read
+ * \details read_index is untouched, pointer is valid until buffer is
+ * written at those indices again
+ * \see BUF_Consume
+ */
+const uint8_t* BUF_Peek(const BUF_t* buffer, BUF_size_t* size);
+
+/**
+ * \brief Mark data as read without copying it, e.g. after BUF_Peek
+ * \param buffer Buffer to consume
+ * \param size Size to consume
+ * \return consumed byte count, 0 if error
+ * \details All or nothing, read_index is untouched if size exceeds data to
+ * read. Size 0 is a no-op, not a failed read
+ */
+BUF_size_t BUF_Consume(BUF_t* buffer, BUF_size_t size);
+
+// --- Public function, compaction
+
+/**
+ * \brief Default BUF_CompactIfNeeded threshold, in percent of buffer size
+ * \details At 50% or more the bytes moved never exceed the bytes reclaimed,
+ * so the move cost is amortized O(1) per consumed byte
+ */
+#define BUF_COMPACT_THRESHOLD_DEFAULT 50U
+
+/**
+ * \brief Move data to read to the front, to reclaim read bytes as free space
+ * \param buffer Buffer to compact
+ * \return reclaimed byte count, i.e. previous read_index, 0 if error
+ * \details read_index becomes 0 and write_index the data to read count.
+ * Pointers from BUF_Peek or BUF_Reserve are invalid afterwards
+ */
+BUF_size_t BUF_Compact(BUF_t* buffer);
+
+/**
+ * \brief Compact only when read bytes reach threshold of buffer size
+ * \param buffer Buffer to compact
+ * \param threshold_percent Minimal read_index, in percent of buffer size,
+ * e.g. BUF_COMPACT_THRESHOLD_DEFAULT
+ * \return reclaimed byte count, 0 if error or below threshold
+ * \details A buffer with nothing to read is always rebased, no byte moves
+ */
+BUF_size_t BUF_CompactIfNeeded(BUF_t* buffer, uint8_t threshold_percent);
+
+// --- Public function, search
+
+/**
+ * \brief Index returned by BUF_Find* when nothing is found
+ */
+#define BUF_INDEX_NONE ((BUF_size_t) -1)
+
+/**
+ * \brief Largest byte set of BUF_FindAnyOf
+ */
+#define BUF_FIND_SET_MAX 8U
+
+/**
+ * \brief Find first occurrence of byte in data to read
+ * \param buffer Buffer to search
+ * \param value Byte to find
+ * \return Buffer index of byte, BUF_INDEX_NONE if not found or error
+ * \details read_index is untouched
+ */
+BUF_size_t BUF_FindByte(const BUF_t* buffer, uint8_t value);
+
+/**
+ * \brief Find first byte of data to read equal to one byte of set
+ * \param buffer Buffer to search
+ * \param set Bytes to find
+ * \param set_size Byte count of set, 1 to BUF_FIND_SET_MAX
+ * \return Buffer index of byte, BUF_INDEX_NONE if not found or error
+ */
+BUF_size_t
+BUF_FindAnyOf(const BUF_t* buffer, const uint8_t* set, uint8_t set_size);
+
+/**
+ * \brief Find first occurrence of pattern in data to read
+ * \param buffer Buffer to search
+ * \param pattern Bytes to find
+ * \param pattern_size Byte count of pattern, not 0
+ * \return Buffer index of pattern start, BUF_INDEX_NONE if not found or
+ * error
+ */
+BUF_size_t BUF_FindPattern(const BUF_t* buffer,
+                           const uint8_t* pattern,
+                           BUF_size_t pattern_size);
+
+/**
+ * \brief Extract next frame terminated by delimiter, without copy
+ * \param buffer Buffer to read
+ * \param frame View on frame bytes, delimiter excluded, as BUF_MakeViewFull
+ * \param delimiter Delimiter bytes, e.g. "\n" or "\r\n"
+ * \param delimiter_size Byte count of delimiter, not 0
+ * \return true if frame found, false if no complete frame or error
+ * \details read_index is moved after the delimiter. When no delimiter is
+ * found, read_index and frame are untouched, the partial frame stays to read
+ */
+bool BUF_NextFrame(BUF_t* buffer,
+                   BUF_t* frame,
+                   const uint8_t* delimiter,
+                   BUF_size_t delimiter_size);
+
+// --- Public function, little-endian
+
+/**
+ * \brief Get little-endian data by index without modify read_index and
+ * write_index
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index
+ * \see BUF_GetUint16
+ */
+uint16_t BUF_GetUint16LE(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Get little-endian data by index without modify read_index and
+ * write_index
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index
+ * \see BUF_GetUint32
+ */
+uint32_t BUF_GetUint32LE(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Get 8 bytes little-endian by index
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index
+ */
+uint64_t BUF_GetUint64LE(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Put 2 bytes little-endian in buffer at index
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutUint16LE(BUF_t* buffer, uint16_t data, BUF_size_t index);
+
+/**
+ * \brief Put 4 bytes little-endian in buffer at index
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutUint32LE(BUF_t* buffer, uint32_t data, BUF_size_t index);
+
+/**
+ * \brief Put 8 bytes little-endian at index
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutUint64LE(BUF_t* buffer, uint64_t data, BUF_size_t index);
+
+/**
+ * \brief Read 2 bytes little-endian from buffer
+ * \param buffer Buffer to read
+ * \return data read
+ */
+uint16_t BUF_ReadUint16LE(BUF_t* buffer);
+
+/**
+ * \brief Read 4 bytes little-endian from buffer
+ * \param buffer Buffer to read
+ * \return data read
+ */
+uint32_t BUF_ReadUint32LE(BUF_t* buffer);
+
+/**
+ * \brief Read 8 bytes little-endian
+ * \param buffer Buffer to read
+ * \return data read
+ */
+uint64_t BUF_ReadUint64LE(BUF_t* buffer);
+
+/**
+ * \brief Write 2 bytes little-endian to buffer
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ * \details All or nothing
+ */
+uint8_t BUF_WriteUint16LE(BUF_t* buffer, uint16_t data);
+
+/**
+ * \brief Write 4 bytes little-endian to buffer
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ * \details All or nothing
+ */
+uint8_t BUF_WriteUint32LE(BUF_t* buffer, uint32_t data);
+
+/**
+ * \brief Write 8 bytes little-endian to buffer
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ * \details All or nothing
+ */
+uint8_t BUF_WriteUint64LE(BUF_t* buffer, uint64_t data);
+
+// --- Public function, buffer byte order
+
+/**
+ * \brief Set byte order used by Auto accessors
+ * \param buffer Buffer to set
+ * \param endian Byte order
+ */
+void BUF_SetEndian(BUF_t* buffer, BUF_Endian_t endian);
+
+/**
+ * \brief Get byte order used by Auto accessors
+ * \param buffer Buffer to check
+ * \return Byte order, BUF_ENDIAN_BIG if buffer is NULL
+ */
+BUF_Endian_t BUF_GetEndian(const BUF_t* buffer);
+
+/**
+ * \brief Get data by index in buffer byte order
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index
+ * \see BUF_GetUint16 \see BUF_GetUint16LE
+ */
+uint16_t BUF_GetUint16Auto(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Get data by index in buffer byte order
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index
+ * \see BUF_GetUint32 \see BUF_GetUint32LE
+ */
+uint32_t BUF_GetUint32Auto(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Get data by index in buffer byte order
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index
+ * \see BUF_GetUint64 \see BUF_GetUint64LE
+ */
+uint64_t BUF_GetUint64Auto(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Put 2 bytes in buffer byte order at index
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutUint16Auto(BUF_t* buffer, uint16_t data, BUF_size_t index);
+
+/**
+ * \brief Put 4 bytes in buffer byte order at index
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutUint32Auto(BUF_t* buffer, uint32_t data, BUF_size_t index);
+
+/**
+ * \brief Put 8 bytes in buffer byte order at index
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutUint64Auto(BUF_t* buffer, uint64_t data, BUF_size_t index);
+
+/**
+ * \brief Read 2 bytes in buffer byte order
+ * \param buffer Buffer to read
+ * \return data read
+ */
+uint16_t BUF_ReadUint16Auto(BUF_t* buffer);
+
+/**
+ * \brief Read 4 bytes in buffer byte order
+ * \param buffer Buffer to read
+ * \return data read
+ */
+uint32_t BUF_ReadUint32Auto(BUF_t* buffer);
+
+/**
+ * \brief Read 8 bytes in buffer byte order
+ * \param buffer Buffer to read
+ * \return data read
+ */
+uint64_t BUF_ReadUint64Auto(BUF_t* buffer);
+
+/**
+ * \brief Write 2 bytes in buffer byte order
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ */
+uint8_t BUF_WriteUint16Auto(BUF_t* buffer, uint16_t data);
+
+/**
+ * \brief Write 4 bytes in buffer byte order
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ */
+uint8_t BUF_WriteUint32Auto(BUF_t* buffer, uint32_t data);
+
+/**
+ * \brief Write 8 bytes in buffer byte order
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ */
+uint8_t BUF_WriteUint64Auto(BUF_t* buffer, uint64_t data);
+
+// --- Public function, floating point
+
+/**
+ * \brief Get IEEE-754 single by index, big-endian
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index, 0 if error
+ */
+float BUF_GetFloat32(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Get IEEE-754 double by index, big-endian
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index, 0 if error
+ */
+double BUF_GetFloat64(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Put IEEE-754 single at index, big-endian
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutFloat32(BUF_t* buffer, float data, BUF_size_t index);
+
+/**
+ * \brief Put IEEE-754 double at index, big-endian
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutFloat64(BUF_t* buffer, double data, BUF_size_t index);
+
+/**
+ * \brief Read IEEE-754 single, big-endian
+ * \param buffer Buffer to read
+ * \return data read, 0 if error
+ */
+float BUF_ReadFloat32(BUF_t* buffer);
+
+/**
+ * \brief Read IEEE-754 double, big-endian
+ * \param buffer Buffer to read
+ * \return data read, 0 if error
+ */
+double BUF_ReadFloat64(BUF_t* buffer);
+
+/**
+ * \brief Write IEEE-754 single, big-endian
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ */
+uint8_t BUF_WriteFloat32(BUF_t* buffer, float data);
+
+/**
+ * \brief Write IEEE-754 double, big-endian
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ */
+uint8_t BUF_WriteFloat64(BUF_t* buffer, double data);
+
+/**
+ * \brief Get IEEE-754 single by index, little-endian
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index, 0 if error
+ */
+float BUF_GetFloat32LE(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Get IEEE-754 double by index, little-endian
+ * \param buffer Buffer to get from
+ * \param index Index to get
+ * \return Data at index, 0 if error
+ */
+double BUF_GetFloat64LE(const BUF_t* buffer, BUF_size_t index);
+
+/**
+ * \brief Put IEEE-754 single at index, little-endian
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutFloat32LE(BUF_t* buffer, float data, BUF_size_t index);
+
+/**
+ * \brief Put IEEE-754 double at index, little-endian
+ * \param buffer Buffer to put in
+ * \param data Data to put
+ * \param index Index to put at
+ * \return number of byte written
+ */
+uint8_t BUF_PutFloat64LE(BUF_t* buffer, double data, BUF_size_t index);
+
+/**
+ * \brief Read IEEE-754 single, little-endian
+ * \param buffer Buffer to read
+ * \return data read, 0 if error
+ */
+float BUF_ReadFloat32LE(BUF_t* buffer);
+
+/**
+ * \brief Read IEEE-754 double, little-endian
+ * \param buffer Buffer to read
+ * \return data read, 0 if error
+ */
+double BUF_ReadFloat64LE(BUF_t* buffer);
+
+/**
+ * \brief Write IEEE-754 single, little-endian
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ */
+uint8_t BUF_WriteFloat32LE(BUF_t* buffer, float data);
+
+/**
+ * \brief Write IEEE-754 double, little-endian
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ */
+uint8_t BUF_WriteFloat64LE(BUF_t* buffer, double data);
+
+/**
+ * \brief Read array of IEEE-754 singles, big-endian
+ * \param buffer Buffer to read
+ * \param data Array to fill
+ * \param count Element count
+ * \return read byte count, 0 if error
+ * \details All or nothing
+ */
+BUF_size_t BUF_ReadFloat32Array(BUF_t* buffer, float* data, BUF_size_t count);
+
+/**
+ * \brief Read array of IEEE-754 doubles, big-endian
+ * \param buffer Buffer to read
+ * \param data Array to fill
+ * \param count Element count
+ * \return read byte count, 0 if error
+ * \details All or nothing
+ */
+BUF_size_t BUF_ReadFloat64Array(BUF_t* buffer, double* data, BUF_size_t count);
+
+/**
+ * \brief Write array of IEEE-754 singles, big-endian
+ * \param buffer Buffer to write to
+ * \param data Array to write
+ * \param count Element count
+ * \return written byte count, 0 if error
+ * \details All or nothing
+ */
+BUF_size_t
+BUF_WriteFloat32Array(BUF_t* buffer, const float* data, BUF_size_t count);
+
+/**
+ * \brief Write array of IEEE-754 doubles, big-endian
+ * \param buffer Buffer to write to
+ * \param data Array to write
+ * \param count Element count
+ * \return written byte count, 0 if error
+ * \details All or nothing
+ */
+BUF_size_t
+BUF_WriteFloat64Array(BUF_t* buffer, const double* data, BUF_size_t count);
+
+/**
+ * \brief Read array of IEEE-754 singles, little-endian
+ * \param buffer Buffer to read
+ * \param data Array to fill
+ * \param count Element count
+ * \return read byte count, 0 if error
+ * \details All or nothing, plain copy on little-endian host
+ */
+BUF_size_t BUF_ReadFloat32ArrayLE(BUF_t* buffer, float* data, BUF_size_t count);
+
+/**
+ * \brief Read array of IEEE-754 doubles, little-endian
+ * \param buffer Buffer to read
+ * \param data Array to fill
+ * \param count Element count
+ * \return read byte count, 0 if error
+ * \details All or nothing, plain copy on little-endian host
+ */
+BUF_size_t BUF_ReadFloat64ArrayLE(BUF_t* buffer, double* data, BUF_size_t count);
+
+/**
+ * \brief Write array of IEEE-754 singles, little-endian
+ * \param buffer Buffer to write to
+ * \param data Array to write
+ * \param count Element count
+ * \return written byte count, 0 if error
+ * \details All or nothing, plain copy on little-endian host
+ */
+BUF_size_t
+BUF_WriteFloat32ArrayLE(BUF_t* buffer, const float* data, BUF_size_t count);
+
+/**
+ * \brief Write array of IEEE-754 doubles, little-endian
+ * \param buffer Buffer to write to
+ * \param data Array to write
+ * \param count Element count
+ * \return written byte count, 0 if error
+ * \details All or nothing, plain copy on little-endian host
+ */
+BUF_size_t
+BUF_WriteFloat64ArrayLE(BUF_t* buffer, const double* data, BUF_size_t count);
+
+// --- Public function, varint
+
+/**
+ * \brief Largest LEB128 encoding of a 32 bits value
+ */
+#define BUF_VARINT32_MAX_SIZE 5U
+
+/**
+ * \brief Largest LEB128 encoding of a 64 bits value
+ */
+#define BUF_VARINT64_MAX_SIZE 10U
+
+/**
+ * \brief Write unsigned LEB128 varint, 7 bits per byte, low group first
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 1 to BUF_VARINT32_MAX_SIZE, 0 if error
+ * \details All or nothing
+ */
+uint8_t BUF_WriteVarU32(BUF_t* buffer, uint32_t data);
+
+/**
+ * \brief Write unsigned LEB128 varint
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 1 to BUF_VARINT64_MAX_SIZE, 0 if error
+ * \details All or nothing
+ */
+uint8_t BUF_WriteVarU64(BUF_t* buffer, uint64_t data);
+
+/**
+ * \brief Write signed value as zigzag LEB128 varint
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ * \details Zigzag maps 0, -1, 1, -2... to 0, 1, 2, 3... so small negative
+ * values stay short. All or nothing
+ */
+uint8_t BUF_WriteVarS32(BUF_t* buffer, int32_t data);
+
+/**
+ * \brief Write signed value as zigzag LEB128 varint
+ * \param buffer Buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ * \details All or nothing
+ */
+uint8_t BUF_WriteVarS64(BUF_t* buffer, int64_t data);
+
+/**
+ * \brief Read unsigned LEB128 varint
+ * \param buffer Buffer to read
+ * \param data Data read, untouched if error
+ * \return read byte count, 0 if error
+ * \details Error if truncated or if value does not fit in 32 bits,
+ * read_index is then untouched
+ */
+uint8_t BUF_ReadVarU32(BUF_t* buffer, uint32_t* data);
+
+/**
+ * \brief Read unsigned LEB128 varint
+ * \param buffer Buffer to read
+ * \param data Data read, untouched if error
+ * \return read byte count, 0 if error
+ * \details Error if truncated or if value does not fit in 64 bits
+ */
+uint8_t BUF_ReadVarU64(BUF_t* buffer, uint64_t* data);
+
+/**
+ * \brief Read zigzag LEB128 varint
+ * \param buffer Buffer to read
+ * \param data Data read, untouched if error
+ * \return read byte count, 0 if error
+ */
+uint8_t BUF_ReadVarS32(BUF_t* buffer, int32_t* data);
+
+/**
+ * \brief Read zigzag LEB128 varint
+ * \param buffer Buffer to read
+ * \param data Data read, untouched if error
+ * \return read byte count, 0 if error
+ */
+uint8_t BUF_ReadVarS64(BUF_t* buffer, int64_t* data);
+
+/**
+ * \brief Read up to count unsigned LEB128 varints
+ * \param buffer Buffer to read
+ * \param data Array to fill
+ * \param count Max value count to read
+ * \return read value count, less than count if data to read ends or holds an
+ * invalid varint first
+ * \details With SSE2, continuation bits of 16 bytes are gathered at once, a
+ * run of 1 byte varints is widened in one step and longer ones are decoded
+ * from their end mask without a loop per byte
+ */
+BUF_size_t BUF_ReadVarU32Array(BUF_t* buffer, uint32_t* data, BUF_size_t count);
@@ -0,0 +1,419 @@
+/**
+ * \file buffer.hpp
+ * \brief Buffer for MCU, header-only C++ layer
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details buf::StaticBuffer<N> owns a BUF_t and its N bytes of storage,
+ * buf::Span is a handle on any BUF_t. Both work on the C structure itself,
+ * BUF_t* obtained with c_buf() can be passed to the functions of buffer.h and
+ * indices moved by either side are seen by the other.
+ *
+ * Accessors are inline and only compare indices, storage can not be NULL for
+ * StaticBuffer, so the compiler drops the checks it can prove. put<Offset>()
+ * and get<Offset>() of StaticBuffer are checked with static_assert only.
+ *
+ * StaticBuffer checks writes against N, not against size of the C buffer, so
+ * BUF_SetSize is not supported on its c_buf().
+ */
+
+#pragma once
+
+#if !defined(__cplusplus)
+#error "buffer.hpp is C++ only, use buffer.h from C"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+extern "C" {
+#include "buffer/buffer.h"
+#include "buffer/buffer_inline.h"
+}
+
+namespace buf {
+
+// --- Private
+
+namespace detail {
+
+/**
+ * \brief Integer types handled by write/read/put/get
+ */
+template <typename T>
+struct is_value : std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value> {};
+
+/**
+ * \brief Unsigned fixed width type of S bytes
+ */
+template <std::size_t S>
+struct uint_of;
+template <>
+struct uint_of<1> {
+  using type = std::uint8_t;
+};
+template <>
+struct uint_of<2> {
+  using type = std::uint16_t;
+};
+template <>
+struct uint_of<4> {
+  using type = std::uint32_t;
+};
+template <>
+struct uint_of<8> {
+  using type = std::uint64_t;
+};
+
+inline void store(std::uint8_t* dst, std::uint8_t value, BUF_Endian_t)
+{
+  *dst = value;
+}
+
+inline void store(std::uint8_t* dst, std::uint16_t value, BUF_Endian_t endian)
+{
+  if (endian == BUF_ENDIAN_LITTLE)
+  {
+    buf_store_le16(dst, value);
+  }
+  else
+  {
+    buf_store_be16(dst, value);
+  }
+}
+
+inline void store(std::uint8_t* dst, std::uint32_t value, BUF_Endian_t endian)
+{
+  if (endian == BUF_ENDIAN_LITTLE)
+  {
+    buf_store_le32(dst, value);
+  }
+  else
+  {
+    buf_store_be32(dst, value);
+  }
+}
+
+inline void store(std::uint8_t* dst, std::uint64_t value, BUF_Endian_t endian)
+{
+  if (endian == BUF_ENDIAN_LITTLE)
+  {
+    buf_store_le64(dst, value);
+  }
+  else
+  {
+    buf_store_be64(dst, value);
+  }
+}
+
+template <typename U>
+U load(const std::uint8_t* src, BUF_Endian_t endian);
+
+template <>
+inline std::uint8_t load<std::uint8_t>(const std::uint8_t* src, BUF_Endian_t)
+{
+  return *src;
+}
+
+template <>
+inline std::uint16_t load<std::uint16_t>(const std::uint8_t* src, BUF_Endian_t endian)
+{
+  return (endian == BUF_ENDIAN_LITTLE) ? buf_load_le16(src) : buf_load_be16(src);
+}
+
+template <>
+inline std::uint32_t load<std::uint32_t>(const std::uint8_t* src, BUF_Endian_t endian)
+{
+  return (endian == BUF_ENDIAN_LITTLE) ? buf_load_le32(src) : buf_load_be32(src);
+}
+
+template <>
+inline std::uint64_t load<std::uint64_t>(const std::uint8_t* src, BUF_Endian_t endian)
+{
+  return (endian == BUF_ENDIAN_LITTLE) ? buf_load_le64(src) : buf_load_be64(src);
+}
+
+/**
+ * \brief Append value
+ * \param buffer Buffer to write to
+ * \param data Data of buffer, not NULL, passed apart so that the compiler
+ * knows when it does not alias the indices
+ * \param size Size of data, a constant for StaticBuffer
+ * \param value Value to write
+ * \return true if written, false if not enough free space
+ */
+template <typename T, BUF_Endian_t E>
+inline bool write(BUF_t& buffer, std::uint8_t* data, BUF_size_t size, T value)
+{
+  using U          = typename uint_of<sizeof(T)>::type;
+  BUF_size_t index = buffer.write_index;
+  bool is_ok       = (static_cast<BUF_size_t>(size - index) >= sizeof(T));
+  if (is_ok)
+  {
+    store(&data[index], static_cast<U>(value), E);
+    buffer.write_index = static_cast<BUF_size_t>(index + sizeof(T));
+    buf_on_write(&buffer, static_cast<BUF_size_t>(sizeof(T)));
+  }
+  else
+  {
+    buf_on_write_failed(&buffer);
+  }
+  return is_ok;
+}
+
+/**
+ * \brief Consume value
+ * \param buffer Buffer to read from
+ * \param data Data of buffer, not NULL
+ * \return Value read, 0 if not enough data to read
+ */
+template <typename T, BUF_Endian_t E>
+inline T read(BUF_t& buffer, const std::uint8_t* data)
+{
+  using U          = typename uint_of<sizeof(T)>::type;
+  U value          = 0;
+  BUF_size_t index = buffer.read_index;
+  if (static_cast<BUF_size_t>(buffer.write_index - index) >= sizeof(T))
+  {
+    value             = load<U>(&data[index], E);
+    buffer.read_index = static_cast<BUF_size_t>(index + sizeof(T));
+    buf_on_read(&buffer, static_cast<BUF_size_t>(sizeof(T)));
+  }
+  else
+  {
+    buf_on_read_failed(&buffer);
+  }
+  return static_cast<T>(value);
+}
+
+} // namespace detail
+
+// --- Public
+
+/**
+ * \brief Handle on an existing BUF_t, e.g. received from C code
+ * \details Does not own the buffer nor its data
+ */
+class Span {
+public:
+  explicit Span(BUF_t& buffer) : buffer_(&buffer) {}
+
+  /**
+   * \brief Get C buffer, for buffer.h functions
+   */
+  BUF_t* c_buf() const
+  {
+    return buffer_;
+  }
+
+  BUF_size_t capacity() const
+  {
+    return buffer_->size;
+  }
+
+  BUF_size_t free_size() const
+  {
+    return BUF_GetFreeSize(buffer_);
+  }
+
+  BUF_size_t to_read_count() const
+  {
+    return BUF_GetToReadCount(buffer_);
+  }
+
+  void reset()
+  {
+    BUF_Reset(buffer_);
+  }
+
+  /**
+   * \brief Append value in E byte order
+   * \return true if written, false if no data or not enough free space
+   */
+  template <typename T, BUF_Endian_t E = BUF_ENDIAN_BIG>
+  bool write(T value)
+  {
+    static_assert(detail::is_value<T>::value, "T must be an integer type");
+    return (buffer_->data != nullptr) && detail::write<T, E>(*buffer_, buffer_->data, buffer_->size, value);
+  }
+
+  /**
+   * \brief Consume value in E byte order
+   * \return Value read, 0 if no data or not enough data to read
+   */
+  template <typename T, BUF_Endian_t E = BUF_ENDIAN_BIG>
+  T read()
+  {
+    static_assert(detail::is_value<T>::value, "T must be an integer type");
+    return (buffer_->data != nullptr) ? detail::read<T, E>(*buffer_, buffer_->data) : T{0};
+  }
+
+private:
+  BUF_t* buffer_;
+};
+
+/**
+ * \brief Buffer owning N bytes of storage
+ * \details Copy duplicates storage and indices, the C buffer of the copy
+ * points to its own storage, digest and stats are not shared with the copy.
+ * Capacity is always N, BUF_SetSize on c_buf() is not supported
+ */
+template <BUF_size_t N>
+class StaticBuffer {
+  static_assert(N > 0, "StaticBuffer needs storage");
+
+public:
+  /**
+   * \brief Empty buffer, same state as BUF_InitEmpty, initialized inline so
+   * the compiler knows the indices
+   */
+  StaticBuffer() : buffer_()
+  {
+    buffer_.data = storage_;
+    buffer_.size = N;
+  }
+
+  StaticBuffer(const StaticBuffer& other) : buffer_(other.buffer_)
+  {
+    std::memcpy(storage_, other.storage_, N);
+    attach_storage();
+  }
+
+  /**
+   * \brief Copy storage and indices, digest and stats of this buffer are
+   * detached
+   */
+  StaticBuffer& operator=(const StaticBuffer& other)
+  {
+    if (this != &other)
+    {
+      std::memcpy(storage_, other.storage_, N);
+      buffer_ = other.buffer_;
+      attach_storage();
+    }
+    return *this;
+  }
+
+  /**
+   * \brief Storage size
+   */
+  static constexpr BUF_size_t capacity()
+  {
+    return N;
+  }
+
+  /**
+   * \brief Get C buffer, for buffer.h functions
+   */
+  BUF_t* c_buf()
+  {
+    return &buffer_;
+  }
+
+  const BUF_t* c_buf() const
+  {
+    return &buffer_;
+  }
+
+  Span span()
+  {
+    return Span(buffer_);
+  }
+
+  std::uint8_t* data()
+  {
+    return storage_;
+  }
+
+  const std::uint8_t* data() const
+  {
+    return storage_;
+  }
+
+  BUF_size_t free_size() const
+  {
+    return static_cast<BUF_size_t>(N - buffer_.write_index);
+  }
+
+  BUF_size_t to_read_count() const
+  {
+    return static_cast<BUF_size_t>(buffer_.write_index - buffer_.read_index);
+  }
+
+  void reset()
+  {
+    buffer_.read_index  = 0;
+    buffer_.write_index = 0;
+  }
+
+  /**
+   * \brief Append value in E byte order
+   * \return true if written, false if not enough free space
+   */
+  template <typename T, BUF_Endian_t E = BUF_ENDIAN_BIG>
+  bool write(T value)
+  {
+    static_assert(detail::is_value<T>::value, "T must be an integer type");
+    static_assert(sizeof(T) <= N, "T does not fit in StaticBuffer");
+    return detail::write<T, E>(buffer_, storage_, N, value);
+  }
+
+  /**
+   * \brief Consume value in E byte order
+   * \return Value read, 0 if not enough data to read
+   */
+  template <typename T, BUF_Endian_t E = BUF_ENDIAN_BIG>
+  T read()
+  {
+    static_assert(detail::is_value<T>::value, "T must be an integer type");
+    static_assert(sizeof(T) <= N, "T does not fit in StaticBuffer");
+    return detail::read<T, E>(buffer_, storage_);
+  }
+
+  /**
+   * \brief Store value at fixed offset, no runtime check
+   * \details Indices are untouched, as BUF_PutUint*
+   */
+  template <BUF_size_t Offset, typename T, BUF_Endian_t E = BUF_ENDIAN_BIG>
+  void put(T value)
+  {
+    static_assert(detail::is_value<T>::value, "T must be an integer type");
+    static_assert((Offset <= N) && (sizeof(T) <= (N - Offset)), "Offset out of StaticBuffer");
+    detail::store(&storage_[Offset], static_cast<typename detail::uint_of<sizeof(T)>::type>(value), E);
+  }
+
+  /**
+   * \brief Load value at fixed offset, no runtime check
+   * \details Indices are untouched, as BUF_GetUint*
+   */
+  template <BUF_size_t Offset, typename T, BUF_Endian_t E = BUF_ENDIAN_BIG>
+  T get() const
+  {
+    static_assert(detail::is_value<T>::value, "T must be an integer type");
+    static_assert((Offset <= N) && (sizeof(T) <= (N - Offset)), "Offset out of StaticBuffer");
+    return static_cast<T>(detail::load<typename detail::uint_of<sizeof(T)>::type>(&storage_[Offset], E));
+  }
+
+private:
+  /**
+   * \brief Point copied C buffer to own storage, detach digest and stats of
+   * the source, whose running state would be updated by two buffers
+   */
+  void attach_storage()
+  {
+    buffer_.data = storage_;
+    buffer_.size = N;
+#if defined(BUF_DIGEST_ENABLE)
+    buffer_.digest = nullptr;
+#endif
+#if defined(BUF_STATS_ENABLE)
+    buffer_.stats = nullptr;
+#endif
+  }
+
+  BUF_t buffer_;
+  std::uint8_t storage_[N];
+};
+
+} // namespace buf
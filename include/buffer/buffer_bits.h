@@ -0,0 +1,459 @@
+/**
+ * \file buffer_bits.h
+ * \brief Buffer for MCU, bit-granular reader and writer
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details Fields of 1 to 64 bits are packed into or unpacked from a buffer
+ * through a 64 bits accumulator. The writer stores a whole 8 bytes word each
+ * time the accumulator is full, the reader refills it with one unaligned
+ * 8 bytes load, so the buffer is touched once per word instead of once per
+ * field.
+ *
+ * - BUF_BIT_MSB_FIRST: first field in most significant bits of first byte,
+ *   e.g. MPEG, H.264, most radio protocols
+ * - BUF_BIT_LSB_FIRST: first field in least significant bits of first byte,
+ *   e.g. DEFLATE, CAN signals in Intel layout
+ *
+ * Accumulated bits are not in the buffer until BUF_BitWriterFlush. The
+ * reader loads bytes ahead, BUF_BitReaderSync gives back the whole bytes not
+ * read yet before going on with byte accessors. Read stats of the buffer
+ * count the bytes consumed by the reader at BUF_BitReaderSync only.
+ *
+ * Functions are static inline, but the end of data load: a writer or reader
+ * kept in a local variable, whose address is not passed to out-of-line
+ * functions, has its accumulator and bit order in registers and constant
+ * field sizes folded in shifts and masks.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+#include "buffer/buffer_inline.h"
+
+// --- Public define
+
+/**
+ * \brief Largest field read without splitting, bits guaranteed by a refill
+ */
+#define BUF_BIT_REFILL_MIN 56U
+
+// --- Public type
+
+/**
+ * \brief Bit order inside bytes
+ */
+typedef enum {
+  BUF_BIT_MSB_FIRST = 0, /*!< Most significant bit first, default */
+  BUF_BIT_LSB_FIRST = 1, /*!< Least significant bit first */
+} BUF_BitOrder_t;
+
+/**
+ * \brief Bit writer, owned by caller
+ * \warning Do not use this structure directly, use BUF_BitWriter API instead
+ */
+typedef struct {
+  BUF_t* buffer; /*!< Buffer written to */
+  uint64_t acc;  /*!< Bits not stored yet */
+  uint8_t count; /*!< Bit count in acc, 0 to 63 */
+  uint8_t order; /*!< BUF_BitOrder_t */
+} BUF_BitWriter_t;
+
+/**
+ * \brief Bit reader, owned by caller
+ * \warning Do not use this structure directly, use BUF_BitReader API instead
+ */
+typedef struct {
+  BUF_t* buffer;    /*!< Buffer read from */
+  uint64_t acc;     /*!< Bits loaded and not read yet */
+  BUF_size_t start; /*!< read_index at init or last sync */
+  uint8_t count;    /*!< Bit count in acc, 0 to 63 */
+  uint8_t order;    /*!< BUF_BitOrder_t */
+} BUF_BitReader_t;
+
+// --- Public function
+
+/**
+ * \brief Load last bytes to read, less than 8, as a zero-padded word
+ * \param buffer Buffer, valid
+ * \param order Bit order, BUF_BitOrder_t
+ * \return big-endian word for BUF_BIT_MSB_FIRST, little-endian otherwise
+ * \details Refill of BUF_BitReaderGetBits at end of data, nothing is loaded
+ * past write_index. Kept out-of-line, the reader is not passed to it so it
+ * can stay in registers
+ */
+uint64_t BUF_BitReaderLoadTail(const BUF_t* buffer, uint8_t order);
+
+// --- Private inline function
+
+/**
+ * \brief Take bits out of accumulator
+ * \param reader Reader, not NULL
+ * \param size Bit count, 1 to BUF_BIT_REFILL_MIN, at most reader->count
+ * \return bits taken
+ */
+static inline uint64_t buf_bit_take(BUF_BitReader_t* reader, uint8_t size)
+{
+  uint64_t value;
+  if (reader->order == (uint8_t) BUF_BIT_MSB_FIRST)
+  {
+    value = reader->acc >> (64U - size);
+    reader->acc <<= size;
+  }
+  else
+  {
+    value = reader->acc & (((uint64_t) 1U << size) - 1U);
+    reader->acc >>= size;
+  }
+  reader->count = (uint8_t) (reader->count - size);
+  return value;
+}
+
+/**
+ * \brief Load whole bytes into accumulator, up to at least
+ * BUF_BIT_REFILL_MIN bits or end of data to read
+ * \param reader Reader, not NULL, less than 64 bits in accumulator
+ */
+static inline void buf_bit_refill(BUF_BitReader_t* reader)
+{
+  BUF_t* buffer = reader->buffer;
+
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    BUF_size_t to_read =
+      (BUF_size_t) (buffer->write_index - buffer->read_index);
+    BUF_size_t loaded = (BUF_size_t) ((63U - reader->count) >> 3U);
+    uint64_t word;
+
+    if (to_read >= 8U)
+    {
+      const uint8_t* src = &buffer->data[buffer->read_index];
+      word               = (reader->order == (uint8_t) BUF_BIT_MSB_FIRST)
+                             ? buf_load_be64(src)
+                             : buf_load_le64(src);
+    }
+    else
+    {
+      word = BUF_BitReaderLoadTail(buffer, reader->order);
+      if (loaded > to_read)
+      {
+        loaded = to_read;
+      }
+    }
+
+    // Bits past the last whole byte loaded are the next ones or zero, they
+    // are ORed again by next refill
+    if (reader->order == (uint8_t) BUF_BIT_MSB_FIRST)
+    {
+      reader->acc |= word >> reader->count;
+    }
+    else
+    {
+      reader->acc |= word << reader->count;
+    }
+    // Not accounted as read yet, part of it may be given back by sync
+    reader->count      = (uint8_t) (reader->count + (loaded << 3U));
+    buffer->read_index = (BUF_size_t) (buffer->read_index + loaded);
+  }
+}
+
+// --- Public inline function
+
+/**
+ * \brief Init bit writer at write_index of buffer
+ * \param writer Writer to init
+ * \param buffer Buffer to write to
+ * \param order Bit order
+ */
+static inline void BUF_BitWriterInit(BUF_BitWriter_t* writer,
+                                     BUF_t* buffer,
+                                     BUF_BitOrder_t order)
+{
+  if (writer != NULL)
+  {
+    writer->buffer = buffer;
+    writer->acc    = 0;
+    writer->count  = 0;
+    writer->order  = (uint8_t) order;
+  }
+}
+
+/**
+ * \brief Append field to writer
+ * \param writer Writer
+ * \param size Bit count, 0 to 64
+ * \param value Field, bits above size are ignored
+ * \return true if done, false if error or buffer is full, nothing is then
+ * written
+ * \details A whole 8 bytes word is stored when the accumulator is full,
+ * buffer must then have 8 bytes free
+ */
+static inline bool
+BUF_BitWriterPutBits(BUF_BitWriter_t* writer, uint8_t size, uint64_t value)
+{
+  bool is_ok = false;
+
+  if ((writer != NULL) && (writer->buffer != NULL)
+      && (writer->buffer->data != NULL) && (size <= 64U))
+  {
+    BUF_t* buffer = writer->buffer;
+    uint8_t room  = (uint8_t) (64U - writer->count);
+    if (size < 64U)
+    {
+      value &= ((uint64_t) 1U << size) - 1U;
+    }
+
+    if (size < room)
+    {
+      if (writer->order == (uint8_t) BUF_BIT_MSB_FIRST)
+      {
+        writer->acc = (writer->acc << size) | value;
+      }
+      else
+      {
+        writer->acc |= value << writer->count;
+      }
+      writer->count = (uint8_t) (writer->count + size);
+      is_ok         = true;
+    }
+    else if ((BUF_size_t) (buffer->size - buffer->write_index) >= 8U)
+    {
+      uint8_t rest = (uint8_t) (size - room);
+      uint8_t* dst = &buffer->data[buffer->write_index];
+      if (writer->order == (uint8_t) BUF_BIT_MSB_FIRST)
+      {
+        // Bits of acc above count are shifted out, no need to clear them
+        buf_store_be64(dst,
+                       (room == 64U)
+                         ? value
+                         : ((writer->acc << room) | (value >> rest)));
+        writer->acc = value;
+      }
+      else
+      {
+        buf_store_le64(dst, writer->acc | (value << writer->count));
+        writer->acc = (room == 64U) ? 0U : (value >> room);
+      }
+      writer->count = rest;
+      buffer->write_index += 8U;
+      buf_on_write(buffer, 8U);
+      is_ok = true;
+    }
+    else
+    {
+      buf_on_write_failed(buffer);
+    }
+  }
+
+  return is_ok;
+}
+
+/**
+ * \brief Pad with zero bits up to next byte boundary
+ * \param writer Writer
+ * \return true if done, false if buffer is full
+ */
+static inline bool BUF_BitWriterAlignToByte(BUF_BitWriter_t* writer)
+{
+  bool is_ok = false;
+  if (writer != NULL)
+  {
+    uint8_t padding = (uint8_t) ((8U - (writer->count & 7U)) & 7U);
+    is_ok           = BUF_BitWriterPutBits(writer, padding, 0U);
+  }
+  return is_ok;
+}
+
+/**
+ * \brief Align to byte and store accumulated bytes in buffer
+ * \param writer Writer
+ * \return true if done, false if buffer is full, nothing is then stored
+ * \details Writer stays usable, next field starts on a new byte
+ */
+static inline bool BUF_BitWriterFlush(BUF_BitWriter_t* writer)
+{
+  bool is_ok = false;
+
+  if ((writer != NULL) && BUF_BitWriterAlignToByte(writer))
+  {
+    BUF_t* buffer    = writer->buffer;
+    BUF_size_t bytes = (BUF_size_t) (writer->count >> 3U);
+    if ((BUF_size_t) (buffer->size - buffer->write_index) >= bytes)
+    {
+      uint64_t acc = writer->acc;
+      uint8_t* dst = &buffer->data[buffer->write_index];
+      BUF_size_t i = 0;
+      // Left-align MSB first bits, first byte is then the top one
+      if ((writer->order == (uint8_t) BUF_BIT_MSB_FIRST) && (bytes > 0U))
+      {
+        acc <<= 64U - writer->count;
+      }
+      for (i = 0; i < bytes; i++)
+      {
+        if (writer->order == (uint8_t) BUF_BIT_MSB_FIRST)
+        {
+          dst[i] = (uint8_t) (acc >> 56U);
+          acc <<= 8U;
+        }
+        else
+        {
+          dst[i] = (uint8_t) acc;
+          acc >>= 8U;
+        }
+      }
+      if (bytes > 0U)
+      {
+        buffer->write_index = (BUF_size_t) (buffer->write_index + bytes);
+        buf_on_write(buffer, bytes);
+      }
+      writer->acc   = 0;
+      writer->count = 0;
+      is_ok         = true;
+    }
+    else
+    {
+      buf_on_write_failed(buffer);
+    }
+  }
+
+  return is_ok;
+}
+
+/**
+ * \brief Init bit reader at read_index of buffer
+ * \param reader Reader to init
+ * \param buffer Buffer to read from
+ * \param order Bit order
+ */
+static inline void BUF_BitReaderInit(BUF_BitReader_t* reader,
+                                     BUF_t* buffer,
+                                     BUF_BitOrder_t order)
+{
+  if (reader != NULL)
+  {
+    reader->buffer = buffer;
+    reader->acc    = 0;
+    reader->start  = (buffer != NULL) ? buffer->read_index : 0U;
+    reader->count  = 0;
+    reader->order  = (uint8_t) order;
+  }
+}
+
+/**
+ * \brief Get bit count left to read
+ * \param reader Reader
+ * \return bit count, loaded bits included, 0 if error
+ */
+static inline size_t BUF_BitReaderGetRemaining(const BUF_BitReader_t* reader)
+{
+  size_t remaining = 0;
+  if ((reader != NULL) && (reader->buffer != NULL))
+  {
+    const BUF_t* buffer = reader->buffer;
+    remaining =
+      (size_t) reader->count
+      + ((size_t) (BUF_size_t) (buffer->write_index - buffer->read_index)
+         << 3U);
+  }
+  return remaining;
+}
+
+/**
+ * \brief Read field from reader
+ * \param reader Reader
+ * \param size Bit count, 0 to 64
+ * \return field, 0 if error or not enough bits left, nothing is then read
+ * \details Fields wider than BUF_BIT_REFILL_MIN bits are read as 32 bits
+ * then the rest
+ */
+static inline uint64_t BUF_BitReaderGetBits(BUF_BitReader_t* reader,
+                                            uint8_t size)
+{
+  uint64_t value = 0;
+
+  // Buffer is checked by refill only, bits in acc were loaded from it
+  if ((reader != NULL) && (size > 0U) && (size <= 64U))
+  {
+    if (size <= BUF_BIT_REFILL_MIN)
+    {
+      if (size > reader->count)
+      {
+        buf_bit_refill(reader);
+      }
+
+      if (size <= reader->count)
+      {
+        value = buf_bit_take(reader, size);
+      }
+      else
+      {
+        buf_on_read_failed(reader->buffer);
+      }
+    }
+    else if (BUF_BitReaderGetRemaining(reader) < size)
+    {
+      buf_on_read_failed(reader->buffer);
+    }
+    else
+    {
+      uint8_t low_size = (uint8_t) (size - 32U);
+      uint64_t high;
+      uint64_t low;
+      if (reader->count < 32U)
+      {
+        buf_bit_refill(reader);
+      }
+      high = buf_bit_take(reader, 32U);
+      if (reader->count < low_size)
+      {
+        buf_bit_refill(reader);
+      }
+      low = buf_bit_take(reader, low_size);
+      // First 32 bits read are the most significant ones in MSB order only
+      value = (reader->order == (uint8_t) BUF_BIT_MSB_FIRST)
+                ? ((high << low_size) | low)
+                : (high | (low << 32U));
+    }
+  }
+
+  return value;
+}
+
+/**
+ * \brief Skip bits up to next byte boundary
+ * \param reader Reader
+ */
+static inline void BUF_BitReaderAlignToByte(BUF_BitReader_t* reader)
+{
+  // Bytes are loaded whole, bits in acc past a byte boundary are the end of
+  // the current byte
+  if ((reader != NULL) && ((reader->count & 7U) != 0U))
+  {
+    (void) buf_bit_take(reader, (uint8_t) (reader->count & 7U));
+  }
+}
+
+/**
+ * \brief Align to byte and give back loaded bytes not read yet
+ * \param reader Reader
+ * \details read_index is then the byte following the last field read, byte
+ * accessors and a new reader can go on from there. Bytes consumed since init
+ * or last sync are accounted as read here
+ */
+static inline void BUF_BitReaderSync(BUF_BitReader_t* reader)
+{
+  if ((reader != NULL) && (reader->buffer != NULL))
+  {
+    BUF_t* buffer = reader->buffer;
+    BUF_BitReaderAlignToByte(reader);
+    buffer->read_index =
+      (BUF_size_t) (buffer->read_index - (reader->count >> 3U));
+    buf_on_read(buffer, (BUF_size_t) (buffer->read_index - reader->start));
+    reader->start = buffer->read_index;
+    reader->acc   = 0;
+    reader->count = 0;
+  }
+}
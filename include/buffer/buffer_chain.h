@@ -0,0 +1,127 @@
+/**
+ * \file buffer_chain.h
+ * \brief Buffer for MCU, scatter-gather chain of buffers
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details A chain references an ordered list of BUF_t segments, e.g. header,
+ * payload view and trailer, and reads them as one stream without copying
+ * them into a contiguous buffer. Segments are not owned by the chain.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#define BUF_CHAIN_HAS_IOVEC 1
+#endif
+
+// --- Public type
+
+/**
+ * \brief Buffer chain structure
+ * \warning Do not use this structure directly, use BUF_Chain API instead
+ */
+typedef struct {
+  BUF_t** segments; /*!< Segment array, provided by caller */
+  size_t capacity;  /*!< Segment array capacity */
+  size_t count;     /*!< Segment count */
+} BUF_Chain_t;
+
+// --- Public function
+
+/**
+ * \brief Buffer chain initialization
+ * \param chain Chain to initialize
+ * \param segments Segment array
+ * \param capacity Segment array capacity
+ */
+void BUF_ChainInit(BUF_Chain_t* chain, BUF_t** segments, size_t capacity);
+
+/**
+ * \brief Remove all segments from chain
+ * \param chain Chain to reset
+ * \details Segments themselves are untouched
+ */
+void BUF_ChainReset(BUF_Chain_t* chain);
+
+/**
+ * \brief Append segment at the end of chain
+ * \param chain Chain to append to
+ * \param segment Segment to append
+ * \return true if appended, false otherwise
+ */
+bool BUF_ChainAppend(BUF_Chain_t* chain, BUF_t* segment);
+
+/**
+ * \brief Get segment count
+ * \param chain Chain to check
+ * \return Segment count
+ */
+size_t BUF_ChainGetSegmentCount(const BUF_Chain_t* chain);
+
+/**
+ * \brief Get data to read in chain
+ * \param chain Chain to check
+ * \return Sum of data to read count of all segments
+ */
+size_t BUF_ChainGetToReadCount(const BUF_Chain_t* chain);
+
+/**
+ * \brief Read 1 byte from chain
+ * \param chain Chain to read
+ * \return data read
+ */
+uint8_t BUF_ChainReadUint8(BUF_Chain_t* chain);
+
+/**
+ * \brief Read 2 bytes from chain, may straddle segments
+ * \param chain Chain to read
+ * \return data read, 0 if not enough data
+ */
+uint16_t BUF_ChainReadUint16(BUF_Chain_t* chain);
+
+/**
+ * \brief Read 4 bytes from chain, may straddle segments
+ * \param chain Chain to read
+ * \return data read, 0 if not enough data
+ */
+uint32_t BUF_ChainReadUint32(BUF_Chain_t* chain);
+
+/**
+ * \brief Read raw data from chain, may straddle segments
+ * \param chain Chain to read
+ * \param data Destination
+ * \param size Size to read
+ * \return read byte count, 0 if error
+ * \details All or nothing
+ */
+size_t BUF_ChainReadRaw(BUF_Chain_t* chain, uint8_t* data, size_t size);
+
+/**
+ * \brief Mark data as read without copying it
+ * \param chain Chain to consume
+ * \param size Size to consume
+ * \return consumed byte count
+ * \details Typically called with the byte count accepted by writev
+ */
+size_t BUF_ChainConsume(BUF_Chain_t* chain, size_t size);
+
+#if defined(BUF_CHAIN_HAS_IOVEC)
+/**
+ * \brief Export data to read of each segment as iovec, without copy
+ * \param chain Chain to export
+ * \param iov iovec array to fill
+ * \param iov_count iovec array capacity
+ * \return iovec filled count, segments with nothing to read are skipped
+ * \details Read indices are untouched, \see BUF_ChainConsume
+ */
+size_t BUF_ChainExportIovec(const BUF_Chain_t* chain,
+                            struct iovec* iov,
+                            size_t iov_count);
+#endif
@@ -0,0 +1,139 @@
+/**
+ * \file buffer_crc.h
+ * \brief Buffer for MCU, CRC over buffer regions
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details
+ * - CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF, not reflected, no xorout
+ * - CRC-32 (ISO-HDLC, zlib): poly 0x04C11DB7 reflected, init and xorout
+ *   0xFFFFFFFF
+ * - CRC-32C (Castagnoli, iSCSI): poly 0x1EDC6F41 reflected, init and xorout
+ *   0xFFFFFFFF
+ *
+ * Portable path is slicing-by-8. On x86, CRC-32C uses the SSE4.2 crc32
+ * instruction and CRC-32 uses PCLMULQDQ folding when the compiler targets
+ * them (e.g. -msse4.2 -mpclmul or -march=native).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+
+// --- Public define
+
+/**
+ * \brief Initial value of BUF_Crc16CcittUpdate
+ */
+#define BUF_CRC16_CCITT_INIT 0xFFFFU
+
+/**
+ * \brief Initial value of BUF_Crc32Update and BUF_Crc32cUpdate
+ */
+#define BUF_CRC32_INIT 0x00000000U
+
+// --- Public function
+
+/**
+ * \brief Update CRC-16/CCITT-FALSE with raw data
+ * \param crc Current CRC, BUF_CRC16_CCITT_INIT to start
+ * \param data Data
+ * \param size Data size
+ * \return Updated CRC
+ */
+uint16_t BUF_Crc16CcittUpdate(uint16_t crc, const uint8_t* data, size_t size);
+
+/**
+ * \brief Update CRC-32 with raw data
+ * \param crc Current CRC, BUF_CRC32_INIT to start
+ * \param data Data
+ * \param size Data size
+ * \return Updated CRC, final value
+ */
+uint32_t BUF_Crc32Update(uint32_t crc, const uint8_t* data, size_t size);
+
+/**
+ * \brief Update CRC-32C with raw data
+ * \param crc Current CRC, BUF_CRC32_INIT to start
+ * \param data Data
+ * \param size Data size
+ * \return Updated CRC, final value
+ */
+uint32_t BUF_Crc32cUpdate(uint32_t crc, const uint8_t* data, size_t size);
+
+/**
+ * \brief CRC-16/CCITT-FALSE of data to read
+ * \param buffer Buffer to compute on, from read_index to write_index
+ * \return CRC, 0 if error
+ * \details read_index is untouched
+ */
+uint16_t BUF_Crc16Ccitt(const BUF_t* buffer);
+
+/**
+ * \brief CRC-16/CCITT-FALSE of buffer range
+ * \param buffer Buffer to compute on
+ * \param index Start index
+ * \param size Range size, range must lie in buffer size
+ * \return CRC, 0 if error
+ */
+uint16_t BUF_Crc16CcittRange(const BUF_t* buffer, BUF_size_t index, BUF_size_t size);
+
+/**
+ * \brief CRC-32 of data to read
+ * \param buffer Buffer to compute on, from read_index to write_index
+ * \return CRC, 0 if error
+ * \details read_index is untouched
+ */
+uint32_t BUF_Crc32(const BUF_t* buffer);
+
+/**
+ * \brief CRC-32 of buffer range
+ * \param buffer Buffer to compute on
+ * \param index Start index
+ * \param size Range size, range must lie in buffer size
+ * \return CRC, 0 if error
+ */
+uint32_t BUF_Crc32Range(const BUF_t* buffer, BUF_size_t index, BUF_size_t size);
+
+/**
+ * \brief CRC-32C of data to read
+ * \param buffer Buffer to compute on, from read_index to write_index
+ * \return CRC, 0 if error
+ * \details read_index is untouched
+ */
+uint32_t BUF_Crc32c(const BUF_t* buffer);
+
+/**
+ * \brief CRC-32C of buffer range
+ * \param buffer Buffer to compute on
+ * \param index Start index
+ * \param size Range size, range must lie in buffer size
+ * \return CRC, 0 if error
+ */
+uint32_t BUF_Crc32cRange(const BUF_t* buffer, BUF_size_t index, BUF_size_t size);
+
+/**
+ * \brief Append CRC-16/CCITT-FALSE of data to read, in buffer byte order
+ * \param buffer Buffer to write to
+ * \return written byte count, 0 if error
+ * \see BUF_SetEndian
+ */
+uint8_t BUF_WriteCrc16Ccitt(BUF_t* buffer);
+
+/**
+ * \brief Append CRC-32 of data to read, in buffer byte order
+ * \param buffer Buffer to write to
+ * \return written byte count, 0 if error
+ * \see BUF_SetEndian
+ */
+uint8_t BUF_WriteCrc32(BUF_t* buffer);
+
+/**
+ * \brief Append CRC-32C of data to read, in buffer byte order
+ * \param buffer Buffer to write to
+ * \return written byte count, 0 if error
+ * \see BUF_SetEndian
+ */
+uint8_t BUF_WriteCrc32c(BUF_t* buffer);
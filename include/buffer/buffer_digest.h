@@ -0,0 +1,84 @@
+/**
+ * \file buffer_digest.h
+ * \brief Buffer for MCU, running digest updated by buffer writes
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details A digest attached to a buffer is updated by every Write* call
+ * (integers, arrays, raw, copy, string and pattern) right after the bytes are
+ * stored, so the checksum of an outgoing frame needs no second pass. Put*
+ * calls write at an index and are not part of the digest.
+ *
+ * Only available when BUF_DIGEST_ENABLE is defined (CMake BUFFER_MCU_DIGEST),
+ * otherwise BUF_t has no digest field and writes have no digest cost.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+
+#if defined(BUF_DIGEST_ENABLE)
+
+// --- Public type
+
+/**
+ * \brief Digest algorithm
+ */
+typedef enum {
+  BUF_DIGEST_CRC32      = 0, /*!< CRC-32 (ISO-HDLC, zlib) */
+  BUF_DIGEST_FLETCHER16 = 1, /*!< Fletcher-16, modulo 255 */
+} BUF_DigestType_t;
+
+/**
+ * \brief Digest state, owned by caller
+ * \warning Do not use this structure directly, use BUF_Digest API instead
+ */
+struct BUF_Digest_s {
+  uint32_t state; /*!< Inverted CRC or Fletcher sums (sum2 << 16 | sum1) */
+  uint8_t type;   /*!< BUF_DigestType_t */
+};
+
+// --- Public function
+
+/**
+ * \brief Digest initialization
+ * \param digest Digest to initialize
+ * \param type Digest algorithm
+ */
+void BUF_DigestInit(BUF_Digest_t* digest, BUF_DigestType_t type);
+
+/**
+ * \brief Update digest with raw data
+ * \param digest Digest to update
+ * \param data Data
+ * \param size Data size
+ */
+void BUF_DigestUpdate(BUF_Digest_t* digest, const uint8_t* data, size_t size);
+
+/**
+ * \brief Get digest value of data so far
+ * \param digest Digest to check
+ * \return Digest value, 0 if error
+ * \details Digest is untouched, data can still be added
+ */
+uint32_t BUF_DigestGetValue(const BUF_Digest_t* digest);
+
+/**
+ * \brief Attach digest to buffer
+ * \param buffer Buffer to attach to
+ * \param digest Digest updated by next writes, NULL to detach
+ * \details Digest is not reset, data already in buffer is not added
+ */
+void BUF_AttachDigest(BUF_t* buffer, BUF_Digest_t* digest);
+
+/**
+ * \brief Get digest value of data written since attach or last finalize
+ * \param buffer Buffer to finalize
+ * \return Digest value, 0 if error or no digest attached
+ * \details Digest is restarted for the next frame and stays attached
+ */
+uint32_t BUF_FinalizeDigest(BUF_t* buffer);
+
+#endif
@@ -0,0 +1,682 @@
+/**
+ * \file buffer_inline.h
+ * \brief Buffer for MCU, inline accessors
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details Same behavior as the matching functions of buffer.h, exposed as
+ * static inline so callers can inline them across translation units.
+ * Out-of-line functions of buffer.c are built on top of these ones.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#include "buffer/buffer.h"
+#if defined(BUF_DIGEST_ENABLE)
+#include "buffer/buffer_digest.h"
+#endif
+#if defined(BUF_STATS_ENABLE)
+#include "buffer/buffer_stats.h"
+#endif
+
+// --- Host byte order
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) \
+  && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define BUF_HOST_LITTLE_ENDIAN 1
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) \
+  && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define BUF_HOST_BIG_ENDIAN 1
+#endif
+
+// --- Private inline function
+
+/**
+ * \brief Reverse byte order of 2 bytes value
+ */
+static inline uint16_t buf_bswap16(uint16_t value)
+{
+#if defined(__GNUC__)
+  return __builtin_bswap16(value);
+#else
+  return (uint16_t) ((uint16_t) (value << 8U) | (uint16_t) (value >> 8U));
+#endif
+}
+
+/**
+ * \brief Reverse byte order of 4 bytes value
+ */
+static inline uint32_t buf_bswap32(uint32_t value)
+{
+#if defined(__GNUC__)
+  return __builtin_bswap32(value);
+#else
+  return ((value & 0x000000FFU) << 24U) | ((value & 0x0000FF00U) << 8U)
+         | ((value & 0x00FF0000U) >> 8U) | ((value & 0xFF000000U) >> 24U);
+#endif
+}
+
+/**
+ * \brief Reverse byte order of 8 bytes value
+ */
+static inline uint64_t buf_bswap64(uint64_t value)
+{
+#if defined(__GNUC__)
+  return __builtin_bswap64(value);
+#else
+  return ((uint64_t) buf_bswap32((uint32_t) value) << 32U)
+         | (uint64_t) buf_bswap32((uint32_t) (value >> 32U));
+#endif
+}
+
+/**
+ * \brief Unaligned big-endian load of 2 bytes
+ */
+static inline uint16_t buf_load_be16(const uint8_t* src)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+  uint16_t value;
+  memcpy(&value, src, sizeof(value));
+#if defined(BUF_HOST_LITTLE_ENDIAN)
+  value = buf_bswap16(value);
+#endif
+  return value;
+#else
+  return (uint16_t) ((uint16_t) (src[0] << 8U) | src[1]);
+#endif
+}
+
+/**
+ * \brief Unaligned big-endian load of 4 bytes
+ */
+static inline uint32_t buf_load_be32(const uint8_t* src)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+  uint32_t value;
+  memcpy(&value, src, sizeof(value));
+#if defined(BUF_HOST_LITTLE_ENDIAN)
+  value = buf_bswap32(value);
+#endif
+  return value;
+#else
+  return ((uint32_t) src[0] << 24U) | ((uint32_t) src[1] << 16U)
+         | ((uint32_t) src[2] << 8U) | (uint32_t) src[3];
+#endif
+}
+
+/**
+ * \brief Unaligned big-endian load of 8 bytes
+ */
+static inline uint64_t buf_load_be64(const uint8_t* src)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+  uint64_t value;
+  memcpy(&value, src, sizeof(value));
+#if defined(BUF_HOST_LITTLE_ENDIAN)
+  value = buf_bswap64(value);
+#endif
+  return value;
+#else
+  return ((uint64_t) buf_load_be32(src) << 32U) | buf_load_be32(&src[4]);
+#endif
+}
+
+/**
+ * \brief Unaligned big-endian store of 2 bytes
+ */
+static inline void buf_store_be16(uint8_t* dst, uint16_t value)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+#if defined(BUF_HOST_LITTLE_ENDIAN)
+  value = buf_bswap16(value);
+#endif
+  memcpy(dst, &value, sizeof(value));
+#else
+  dst[0] = (uint8_t) (value >> 8U);
+  dst[1] = (uint8_t) (value);
+#endif
+}
+
+/**
+ * \brief Unaligned big-endian store of 4 bytes
+ */
+static inline void buf_store_be32(uint8_t* dst, uint32_t value)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+#if defined(BUF_HOST_LITTLE_ENDIAN)
+  value = buf_bswap32(value);
+#endif
+  memcpy(dst, &value, sizeof(value));
+#else
+  dst[0] = (uint8_t) (value >> 24U);
+  dst[1] = (uint8_t) (value >> 16U);
+  dst[2] = (uint8_t) (value >> 8U);
+  dst[3] = (uint8_t) (value);
+#endif
+}
+
+/**
+ * \brief Unaligned big-endian store of 8 bytes
+ */
+static inline void buf_store_be64(uint8_t* dst, uint64_t value)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+#if defined(BUF_HOST_LITTLE_ENDIAN)
+  value = buf_bswap64(value);
+#endif
+  memcpy(dst, &value, sizeof(value));
+#else
+  buf_store_be32(dst, (uint32_t) (value >> 32U));
+  buf_store_be32(&dst[4], (uint32_t) value);
+#endif
+}
+
+/**
+ * \brief Unaligned little-endian load of 2 bytes
+ */
+static inline uint16_t buf_load_le16(const uint8_t* src)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+  uint16_t value;
+  memcpy(&value, src, sizeof(value));
+#if defined(BUF_HOST_BIG_ENDIAN)
+  value = buf_bswap16(value);
+#endif
+  return value;
+#else
+  return (uint16_t) ((uint16_t) (src[1] << 8U) | src[0]);
+#endif
+}
+
+/**
+ * \brief Unaligned little-endian load of 4 bytes
+ */
+static inline uint32_t buf_load_le32(const uint8_t* src)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+  uint32_t value;
+  memcpy(&value, src, sizeof(value));
+#if defined(BUF_HOST_BIG_ENDIAN)
+  value = buf_bswap32(value);
+#endif
+  return value;
+#else
+  return ((uint32_t) src[3] << 24U) | ((uint32_t) src[2] << 16U)
+         | ((uint32_t) src[1] << 8U) | (uint32_t) src[0];
+#endif
+}
+
+/**
+ * \brief Unaligned little-endian load of 8 bytes
+ */
+static inline uint64_t buf_load_le64(const uint8_t* src)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+  uint64_t value;
+  memcpy(&value, src, sizeof(value));
+#if defined(BUF_HOST_BIG_ENDIAN)
+  value = buf_bswap64(value);
+#endif
+  return value;
+#else
+  return ((uint64_t) buf_load_le32(&src[4]) << 32U) | buf_load_le32(src);
+#endif
+}
+
+/**
+ * \brief Unaligned little-endian store of 2 bytes
+ */
+static inline void buf_store_le16(uint8_t* dst, uint16_t value)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+#if defined(BUF_HOST_BIG_ENDIAN)
+  value = buf_bswap16(value);
+#endif
+  memcpy(dst, &value, sizeof(value));
+#else
+  dst[0] = (uint8_t) (value);
+  dst[1] = (uint8_t) (value >> 8U);
+#endif
+}
+
+/**
+ * \brief Unaligned little-endian store of 4 bytes
+ */
+static inline void buf_store_le32(uint8_t* dst, uint32_t value)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+#if defined(BUF_HOST_BIG_ENDIAN)
+  value = buf_bswap32(value);
+#endif
+  memcpy(dst, &value, sizeof(value));
+#else
+  dst[0] = (uint8_t) (value);
+  dst[1] = (uint8_t) (value >> 8U);
+  dst[2] = (uint8_t) (value >> 16U);
+  dst[3] = (uint8_t) (value >> 24U);
+#endif
+}
+
+/**
+ * \brief Unaligned little-endian store of 8 bytes
+ */
+static inline void buf_store_le64(uint8_t* dst, uint64_t value)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN) || defined(BUF_HOST_BIG_ENDIAN)
+#if defined(BUF_HOST_BIG_ENDIAN)
+  value = buf_bswap64(value);
+#endif
+  memcpy(dst, &value, sizeof(value));
+#else
+  buf_store_le32(dst, (uint32_t) value);
+  buf_store_le32(&dst[4], (uint32_t) (value >> 32U));
+#endif
+}
+
+/**
+ * \brief Account bytes just written before write_index
+ * \param buffer Buffer written, not NULL
+ * \param size Byte count written
+ * \details Updates attached digest and stats, empty when both are disabled
+ */
+static inline void buf_on_write(BUF_t* buffer, BUF_size_t size)
+{
+#if defined(BUF_DIGEST_ENABLE)
+  if (buffer->digest != NULL)
+  {
+    BUF_DigestUpdate(buffer->digest,
+                     &buffer->data[buffer->write_index - size],
+                     size);
+  }
+#endif
+#if defined(BUF_STATS_ENABLE)
+  if (buffer->stats != NULL)
+  {
+    BUF_StatsAddWritten(buffer->stats, size, buffer->write_index);
+  }
+#endif
+  (void) buffer;
+  (void) size;
+}
+
+/**
+ * \brief Account bytes just read before read_index
+ * \param buffer Buffer read, not NULL
+ * \param size Byte count read
+ */
+static inline void buf_on_read(BUF_t* buffer, BUF_size_t size)
+{
+#if defined(BUF_STATS_ENABLE)
+  if (buffer->stats != NULL)
+  {
+    __atomic_add_fetch(&buffer->stats->bytes_read, size, __ATOMIC_RELAXED);
+  }
+#endif
+  (void) buffer;
+  (void) size;
+}
+
+/**
+ * \brief Account write refused or truncated for lack of space
+ * \param buffer Buffer written, may be NULL
+ */
+static inline void buf_on_write_failed(BUF_t* buffer)
+{
+#if defined(BUF_STATS_ENABLE)
+  if ((buffer != NULL) && (buffer->stats != NULL))
+  {
+    __atomic_add_fetch(&buffer->stats->write_failed, 1U, __ATOMIC_RELAXED);
+  }
+#endif
+  (void) buffer;
+}
+
+/**
+ * \brief Account read refused for lack of data
+ * \param buffer Buffer read, may be NULL
+ */
+static inline void buf_on_read_failed(BUF_t* buffer)
+{
+#if defined(BUF_STATS_ENABLE)
+  if ((buffer != NULL) && (buffer->stats != NULL))
+  {
+    __atomic_add_fetch(&buffer->stats->read_failed, 1U, __ATOMIC_RELAXED);
+  }
+#endif
+  (void) buffer;
+}
+
+/**
+ * \brief Account compare
+ * \param buffer Buffer compared, may be NULL
+ */
+static inline void buf_on_compare(const BUF_t* buffer)
+{
+#if defined(BUF_STATS_ENABLE)
+  if ((buffer != NULL) && (buffer->stats != NULL))
+  {
+    __atomic_add_fetch(&buffer->stats->compare_count, 1U, __ATOMIC_RELAXED);
+  }
+#endif
+  (void) buffer;
+}
+
+/**
+ * \brief Account view made on buffer
+ * \param buffer Source buffer of view, not NULL
+ */
+static inline void buf_on_view(const BUF_t* buffer)
+{
+#if defined(BUF_STATS_ENABLE)
+  if (buffer->stats != NULL)
+  {
+    __atomic_add_fetch(&buffer->stats->view_count, 1U, __ATOMIC_RELAXED);
+  }
+#endif
+  (void) buffer;
+}
+
+// --- Public inline function
+
+/**
+ * \brief Read 1 byte from buffer
+ * \see BUF_ReadUint8
+ */
+static inline uint8_t BUF_InlineReadUint8(BUF_t* buffer)
+{
+  uint8_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && (buffer->write_index > buffer->read_index))
+  {
+    read = buffer->data[buffer->read_index];
+    buffer->read_index += 1U;
+    buf_on_read(buffer, 1U);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Read 2 bytes from buffer
+ * \see BUF_ReadUint16
+ */
+static inline uint16_t BUF_InlineReadUint16(BUF_t* buffer)
+{
+  uint16_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->write_index - buffer->read_index) >= 2U))
+  {
+    read = buf_load_be16(&buffer->data[buffer->read_index]);
+    buffer->read_index += 2U;
+    buf_on_read(buffer, 2U);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Read 4 bytes from buffer
+ * \see BUF_ReadUint32
+ */
+static inline uint32_t BUF_InlineReadUint32(BUF_t* buffer)
+{
+  uint32_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->write_index - buffer->read_index) >= 4U))
+  {
+    read = buf_load_be32(&buffer->data[buffer->read_index]);
+    buffer->read_index += 4U;
+    buf_on_read(buffer, 4U);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Read 8 bytes from buffer
+ * \see BUF_ReadUint64
+ */
+static inline uint64_t BUF_InlineReadUint64(BUF_t* buffer)
+{
+  uint64_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->write_index - buffer->read_index) >= 8U))
+  {
+    read = buf_load_be64(&buffer->data[buffer->read_index]);
+    buffer->read_index += 8U;
+    buf_on_read(buffer, 8U);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Write 1 byte to buffer
+ * \see BUF_WriteUint8
+ */
+static inline uint8_t BUF_InlineWriteUint8(BUF_t* buffer, uint8_t data)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && (buffer->size > buffer->write_index))
+  {
+    buffer->data[buffer->write_index] = data;
+    buffer->write_index += 1U;
+    buf_on_write(buffer, 1U);
+    written = 1;
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
+
+/**
+ * \brief Write 2 bytes to buffer, all or nothing
+ * \see BUF_WriteUint16
+ */
+static inline uint8_t BUF_InlineWriteUint16(BUF_t* buffer, uint16_t data)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->size - buffer->write_index) >= 2U))
+  {
+    buf_store_be16(&buffer->data[buffer->write_index], data);
+    buffer->write_index += 2U;
+    buf_on_write(buffer, 2U);
+    written = 2;
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
+
+/**
+ * \brief Write 4 bytes to buffer, all or nothing
+ * \see BUF_WriteUint32
+ */
+static inline uint8_t BUF_InlineWriteUint32(BUF_t* buffer, uint32_t data)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->size - buffer->write_index) >= 4U))
+  {
+    buf_store_be32(&buffer->data[buffer->write_index], data);
+    buffer->write_index += 4U;
+    buf_on_write(buffer, 4U);
+    written = 4;
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
+
+/**
+ * \brief Write 8 bytes to buffer, all or nothing
+ * \see BUF_WriteUint64
+ */
+static inline uint8_t BUF_InlineWriteUint64(BUF_t* buffer, uint64_t data)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->size - buffer->write_index) >= 8U))
+  {
+    buf_store_be64(&buffer->data[buffer->write_index], data);
+    buffer->write_index += 8U;
+    buf_on_write(buffer, 8U);
+    written = 8;
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
+
+/**
+ * \brief Read 2 bytes little-endian from buffer
+ * \see BUF_ReadUint16LE
+ */
+static inline uint16_t BUF_InlineReadUint16LE(BUF_t* buffer)
+{
+  uint16_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->write_index - buffer->read_index) >= 2U))
+  {
+    read = buf_load_le16(&buffer->data[buffer->read_index]);
+    buffer->read_index += 2U;
+    buf_on_read(buffer, 2U);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Read 4 bytes little-endian from buffer
+ * \see BUF_ReadUint32LE
+ */
+static inline uint32_t BUF_InlineReadUint32LE(BUF_t* buffer)
+{
+  uint32_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->write_index - buffer->read_index) >= 4U))
+  {
+    read = buf_load_le32(&buffer->data[buffer->read_index]);
+    buffer->read_index += 4U;
+    buf_on_read(buffer, 4U);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Read 8 bytes little-endian from buffer
+ * \see BUF_ReadUint64LE
+ */
+static inline uint64_t BUF_InlineReadUint64LE(BUF_t* buffer)
+{
+  uint64_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->write_index - buffer->read_index) >= 8U))
+  {
+    read = buf_load_le64(&buffer->data[buffer->read_index]);
+    buffer->read_index += 8U;
+    buf_on_read(buffer, 8U);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Write 2 bytes little-endian to buffer, all or nothing
+ * \see BUF_WriteUint16LE
+ */
+static inline uint8_t BUF_InlineWriteUint16LE(BUF_t* buffer, uint16_t data)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->size - buffer->write_index) >= 2U))
+  {
+    buf_store_le16(&buffer->data[buffer->write_index], data);
+    buffer->write_index += 2U;
+    buf_on_write(buffer, 2U);
+    written = 2;
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
+
+/**
+ * \brief Write 4 bytes little-endian to buffer, all or nothing
+ * \see BUF_WriteUint32LE
+ */
+static inline uint8_t BUF_InlineWriteUint32LE(BUF_t* buffer, uint32_t data)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->size - buffer->write_index) >= 4U))
+  {
+    buf_store_le32(&buffer->data[buffer->write_index], data);
+    buffer->write_index += 4U;
+    buf_on_write(buffer, 4U);
+    written = 4;
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
+
+/**
+ * \brief Write 8 bytes little-endian to buffer, all or nothing
+ * \see BUF_WriteUint64LE
+ */
+static inline uint8_t BUF_InlineWriteUint64LE(BUF_t* buffer, uint64_t data)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->size - buffer->write_index) >= 8U))
+  {
+    buf_store_le64(&buffer->data[buffer->write_index], data);
+    buffer->write_index += 8U;
+    buf_on_write(buffer, 8U);
+    written = 8;
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
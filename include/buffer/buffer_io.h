@@ -0,0 +1,174 @@
+/**
+ * \file buffer_io.h
+ * \brief Buffer for MCU, POSIX file descriptor read and write
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details Fill free space or drain data to read of buffers straight from or
+ * to a file descriptor (pipe, socket, tty, file), without intermediate copy.
+ * Blocking and non-blocking descriptors are both handled: EINTR is retried,
+ * EAGAIN is reported as BUF_IO_AGAIN with the bytes moved so far, short
+ * writes are continued.
+ *
+ * BUF_MapFile sets a buffer over a memory-mapped file, so large captures are
+ * decoded without being read first and the page cache is shared between
+ * processes. Files larger than BUF_size_t can address are walked by windows
+ * with BUF_MapNext.
+ *
+ * Only available when BUF_IO_ENABLE is defined (CMake BUFFER_MCU_IO, ON by
+ * default on UNIX hosts), MCU targets without POSIX are not affected.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+
+#if defined(BUF_IO_ENABLE)
+
+// --- Public define
+
+/**
+ * \brief Largest buffer count of one BUF_ReadvFromFd or BUF_WritevToFd
+ * \details Bounds the iovec array on stack, extra buffers are ignored
+ */
+#ifndef BUF_IO_IOV_MAX
+#define BUF_IO_IOV_MAX 16U
+#endif
+
+/**
+ * \brief Largest mapped window of BUF_MapFile, in bytes
+ * \details Also bounded by BUF_size_t, rounded down to the page size, so it
+ * must be at least one page
+ */
+#ifndef BUF_MAP_WINDOW_MAX
+#define BUF_MAP_WINDOW_MAX ((size_t) 1U << 30U)
+#endif
+
+// --- Public type
+
+/**
+ * \brief Outcome of a file descriptor transfer
+ */
+typedef enum {
+  BUF_IO_OK    = 0, /*!< Transfer done, or nothing to transfer */
+  BUF_IO_AGAIN = 1, /*!< Non-blocking descriptor not ready, retry later */
+  BUF_IO_EOF   = 2, /*!< Read end of file, peer closed */
+  BUF_IO_ERROR = 3, /*!< Invalid parameter or system call error, see errno */
+} BUF_IoStatus_t;
+
+/**
+ * \brief Access to mapped file
+ */
+typedef enum {
+  BUF_MAP_READ_ONLY = 0, /*!< Shared read-only mapping, page cache shared */
+  BUF_MAP_PRIVATE   = 1, /*!< Copy-on-write mapping, file is never changed */
+} BUF_MapMode_t;
+
+/**
+ * \brief Mapped file, owned by caller
+ * \warning Do not use this structure directly, use BUF_MapFile API instead
+ */
+typedef struct {
+  uint8_t* window;    /*!< Mapped window, NULL if none */
+  size_t window_size; /*!< Mapped window size */
+  uint64_t offset;    /*!< File offset of window, multiple of page size */
+  uint64_t file_size; /*!< File size at BUF_MapFile */
+  int fd;             /*!< File descriptor, -1 if closed */
+  uint8_t mode;       /*!< BUF_MapMode_t */
+} BUF_Map_t;
+
+// --- Public function
+
+/**
+ * \brief Fill free space of buffer with one read()
+ * \param buffer Buffer to write to
+ * \param fd File descriptor to read from
+ * \param status Outcome, may be NULL
+ * \return byte count read, write_index is advanced by this count
+ * \details A full buffer returns 0 with BUF_IO_OK, nothing is read. One read
+ * only, so a blocking descriptor blocks at most once
+ */
+BUF_size_t BUF_ReadFromFd(BUF_t* buffer, int fd, BUF_IoStatus_t* status);
+
+/**
+ * \brief Drain data to read of buffer with write()
+ * \param buffer Buffer to read from
+ * \param fd File descriptor to write to
+ * \param status Outcome, may be NULL
+ * \return byte count written, read_index is advanced by this count
+ * \details Short writes are continued until all is written, or until
+ * BUF_IO_AGAIN or BUF_IO_ERROR. SIGPIPE is not masked
+ */
+BUF_size_t BUF_WriteToFd(BUF_t* buffer, int fd, BUF_IoStatus_t* status);
+
+/**
+ * \brief Fill free space of several buffers, in order, with one readv()
+ * \param buffers Buffers to write to
+ * \param count Buffer count, at most BUF_IO_IOV_MAX are used
+ * \param fd File descriptor to read from
+ * \param status Outcome, may be NULL
+ * \return total byte count read
+ * \details Each buffer is filled up before the next one, e.g. header then
+ * payload buffers
+ */
+size_t BUF_ReadvFromFd(BUF_t* buffers,
+                       size_t count,
+                       int fd,
+                       BUF_IoStatus_t* status);
+
+/**
+ * \brief Drain data to read of several buffers, in order, with writev()
+ * \param buffers Buffers to read from
+ * \param count Buffer count, at most BUF_IO_IOV_MAX are used
+ * \param fd File descriptor to write to
+ * \param status Outcome, may be NULL
+ * \return total byte count written
+ * \details Same short write handling as BUF_WriteToFd
+ */
+size_t BUF_WritevToFd(BUF_t* buffers,
+                      size_t count,
+                      int fd,
+                      BUF_IoStatus_t* status);
+
+// --- Public function, memory-mapped file
+
+/**
+ * \brief Map file and set buffer full over its first window
+ * \param map Mapping to open
+ * \param buffer Buffer to set, endian and attachments reset as BUF_InitFull
+ * \param path File path
+ * \param mode Read-only or private copy-on-write
+ * \return true if mapped, false if error, see errno
+ * \details Window is advised sequential and will-need. An empty file maps
+ * nothing and gives an empty buffer. A window holds at least one page, so a
+ * page size larger than BUF_size_t can address, e.g. 64 KiB pages with the
+ * default uint16_t, fails with EOVERFLOW: use BUF_SIZE_TYPE_UINT32 there
+ * \warning Put* on a BUF_MAP_READ_ONLY buffer faults, data is read-only
+ */
+bool BUF_MapFile(BUF_Map_t* map,
+                 BUF_t* buffer,
+                 const char* path,
+                 BUF_MapMode_t mode);
+
+/**
+ * \brief Slide window to data to read of buffer
+ * \param map Mapping opened by BUF_MapFile
+ * \param buffer Buffer set by BUF_MapFile or BUF_MapNext
+ * \return true if remapped, false if window already reaches end of file or
+ * error
+ * \details Next window starts at the page of read_index, bytes not read yet
+ * stay to read. Pointers in previous window are invalid afterwards
+ */
+bool BUF_MapNext(BUF_Map_t* map, BUF_t* buffer);
+
+/**
+ * \brief Unmap window and close file
+ * \param map Mapping to close
+ * \param buffer Buffer set over mapping, reset to no data, may be NULL
+ */
+void BUF_Unmap(BUF_Map_t* map, BUF_t* buffer);
+
+#endif
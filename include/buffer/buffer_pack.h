@@ -0,0 +1,214 @@
+/**
+ * \file buffer_pack.h
+ * \brief Buffer for MCU, generated struct serialization
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details A message struct is described once by a field list macro (member,
+ * element type, byte order, in wire order). BUF_PACK_DEFINE then generates
+ * static inline pack and unpack functions for this struct, which move the
+ * whole struct with one capacity check and one index update, instead of one
+ * checked call per field. Offsets, sizes and byte swaps are compile-time
+ * constants, so each field is one load, swap and store:
+ *
+ * \code
+ * typedef struct {
+ *   uint16_t id;
+ *   uint32_t timestamp;
+ *   int16_t axis[3];
+ * } msg_t;
+ *
+ * #define MSG_FIELDS(X)                          \
+ *   X(id, BUF_FIELD_UINT16, BUF_ENDIAN_BIG)        \
+ *   X(timestamp, BUF_FIELD_UINT32, BUF_ENDIAN_BIG) \
+ *   X(axis, BUF_FIELD_UINT16, BUF_ENDIAN_LITTLE)
+ *
+ * BUF_PACK_DEFINE(Msg, msg_t, MSG_FIELDS)
+ *
+ * MsgPack(&buffer, &msg);   // 12 bytes
+ * MsgUnpack(&buffer, &msg);
+ * \endcode
+ *
+ * An array member is moved whole, element type gives the swapped width.
+ * Signed and floating point members use the unsigned type of same width,
+ * their bytes are moved as is.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "buffer/buffer.h"
+#include "buffer/buffer_inline.h"
+
+// --- Public type
+
+/**
+ * \brief Field element type, value is the element size in bytes
+ */
+typedef enum {
+  BUF_FIELD_UINT8  = 1, /*!< uint8_t, int8_t, char */
+  BUF_FIELD_UINT16 = 2, /*!< uint16_t, int16_t */
+  BUF_FIELD_UINT32 = 4, /*!< uint32_t, int32_t, float */
+  BUF_FIELD_UINT64 = 8, /*!< uint64_t, int64_t, double */
+} BUF_FieldType_t;
+
+// --- Public define
+
+/**
+ * \brief Generate pack and unpack functions of a struct
+ * \param name Function prefix, generates name##GetSize, name##Pack and
+ * name##Unpack
+ * \param type Struct type
+ * \param FIELDS Field list macro, FIELDS(X) expands X(member, field_type,
+ * endian) for each member in wire order
+ * \details Generated functions:
+ * - BUF_size_t name##GetSize(void): packed size
+ * - BUF_size_t name##Pack(BUF_t* buffer, const type* src): write struct at
+ *   write_index, all or nothing, return written byte count, 0 if error
+ * - BUF_size_t name##Unpack(BUF_t* buffer, type* dst): read struct at
+ *   read_index, all or nothing, padding of dst untouched, return read byte
+ *   count, 0 if error
+ * \warning Member size must be a multiple of field_type, and packed size
+ * must fit in BUF_size_t
+ */
+#define BUF_PACK_DEFINE(name, type, FIELDS)                                   \
+  static inline BUF_size_t name##GetSize(void)                                \
+  {                                                                           \
+    const type* buf_pack_struct = NULL;                                       \
+    (void) buf_pack_struct;                                                   \
+    return (BUF_size_t) (0U FIELDS(BUF_PACK_SIZE_OF));                        \
+  }                                                                           \
+                                                                              \
+  static inline BUF_size_t name##Pack(BUF_t* buffer, const type* src)         \
+  {                                                                           \
+    BUF_size_t written = 0;                                                   \
+    BUF_size_t size    = name##GetSize();                                     \
+    if ((buffer != NULL) && (buffer->data != NULL) && (src != NULL)           \
+        && (size <= (BUF_size_t) (buffer->size - buffer->write_index)))       \
+    {                                                                         \
+      const type* buf_pack_struct = src;                                      \
+      uint8_t* buf_pack_wire      = &buffer->data[buffer->write_index];       \
+      FIELDS(BUF_PACK_STORE)                                                  \
+      written = size;                                                         \
+      buffer->write_index += written;                                         \
+      buf_on_write(buffer, written);                                          \
+    }                                                                         \
+    else                                                                      \
+    {                                                                         \
+      buf_on_write_failed(buffer);                                            \
+    }                                                                         \
+    return written;                                                           \
+  }                                                                           \
+                                                                              \
+  static inline BUF_size_t name##Unpack(BUF_t* buffer, type* dst)             \
+  {                                                                           \
+    BUF_size_t read = 0;                                                      \
+    BUF_size_t size = name##GetSize();                                        \
+    if ((buffer != NULL) && (buffer->data != NULL) && (dst != NULL)           \
+        && (size <= (BUF_size_t) (buffer->write_index - buffer->read_index))) \
+    {                                                                         \
+      type* buf_pack_struct       = dst;                                      \
+      const uint8_t* buf_pack_wire = &buffer->data[buffer->read_index];       \
+      FIELDS(BUF_PACK_LOAD)                                                   \
+      read = size;                                                            \
+      buffer->read_index += read;                                             \
+      buf_on_read(buffer, read);                                              \
+    }                                                                         \
+    else                                                                      \
+    {                                                                         \
+      buf_on_read_failed(buffer);                                             \
+    }                                                                         \
+    return read;                                                              \
+  }
+
+/**
+ * \brief Field list callback, add member size, see BUF_PACK_DEFINE
+ */
+#define BUF_PACK_SIZE_OF(member, field_type, endian) +sizeof(buf_pack_struct->member)
+
+/**
+ * \brief Field list callback, copy member to wire, see BUF_PACK_DEFINE
+ */
+#define BUF_PACK_STORE(member, field_type, endian)                          \
+  buf_pack_copy(buf_pack_wire,                                              \
+                (const uint8_t*) &buf_pack_struct->member,                  \
+                sizeof(buf_pack_struct->member),                            \
+                (field_type),                                               \
+                (endian));                                                  \
+  buf_pack_wire += sizeof(buf_pack_struct->member);
+
+/**
+ * \brief Field list callback, copy wire to member, see BUF_PACK_DEFINE
+ */
+#define BUF_PACK_LOAD(member, field_type, endian)                           \
+  buf_pack_copy((uint8_t*) &buf_pack_struct->member,                        \
+                buf_pack_wire,                                              \
+                sizeof(buf_pack_struct->member),                            \
+                (field_type),                                               \
+                (endian));                                                  \
+  buf_pack_wire += sizeof(buf_pack_struct->member);
+
+// --- Private inline function
+
+/**
+ * \brief Copy one member between struct and wire
+ * \param dst Wire bytes or struct member
+ * \param src Struct member or wire bytes
+ * \param size Member size
+ * \param type Element type
+ * \param endian Wire byte order
+ * \details Byte swap is its own inverse, so the same copy packs and unpacks.
+ * All parameters but dst and src are constants at each generated call, so
+ * the copy folds to moves and byte swaps
+ */
+static inline void buf_pack_copy(uint8_t* dst,
+                                 const uint8_t* src,
+                                 size_t size,
+                                 BUF_FieldType_t type,
+                                 BUF_Endian_t endian)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN)
+  bool is_swap = (endian == BUF_ENDIAN_BIG) && (type != BUF_FIELD_UINT8);
+#elif defined(BUF_HOST_BIG_ENDIAN)
+  bool is_swap = (endian == BUF_ENDIAN_LITTLE) && (type != BUF_FIELD_UINT8);
+#else
+  // Host byte order unknown at compile time, probe it
+  uint16_t probe      = 1U;
+  bool is_host_little = (*(const uint8_t*) &probe == 1U);
+  bool is_swap        = (endian != (is_host_little ? BUF_ENDIAN_LITTLE : BUF_ENDIAN_BIG))
+                 && (type != BUF_FIELD_UINT8);
+#endif
+  size_t i = 0;
+
+  for (i = 0; is_swap && (i < size); i += (size_t) type)
+  {
+    if (type == BUF_FIELD_UINT16)
+    {
+      uint16_t value;
+      memcpy(&value, &src[i], sizeof(value));
+      value = buf_bswap16(value);
+      memcpy(&dst[i], &value, sizeof(value));
+    }
+    else if (type == BUF_FIELD_UINT32)
+    {
+      uint32_t value;
+      memcpy(&value, &src[i], sizeof(value));
+      value = buf_bswap32(value);
+      memcpy(&dst[i], &value, sizeof(value));
+    }
+    else
+    {
+      uint64_t value;
+      memcpy(&value, &src[i], sizeof(value));
+      value = buf_bswap64(value);
+      memcpy(&dst[i], &value, sizeof(value));
+    }
+  }
+  if (!is_swap)
+  {
+    memcpy(dst, src, size);
+  }
+}
@@ -0,0 +1,149 @@
+/**
+ * \file buffer_pool.h
+ * \brief Buffer for MCU, fixed-block buffer pool
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details A pool carves a caller-provided arena into blocks of the same
+ * size. Each block holds a free-list link, a BUF_t and its data, so acquire
+ * and release are O(1) and need no allocator. The link of an acquired block
+ * is a sentinel, so a second release is rejected instead of corrupting the
+ * free list.
+ *
+ * BUF_PoolAcquire/BUF_PoolRelease are for one context. BUF_PoolAcquireAtomic/
+ * BUF_PoolReleaseAtomic are lock-free for several threads, the free-list
+ * head is an index tagged with a counter and swapped with a 64-bit
+ * compare-and-swap to be ABA safe. Do not mix both variants on one pool.
+ * The atomic variant is only available when BUF_POOL_ATOMIC_ENABLE is
+ * defined (CMake BUFFER_MCU_POOL_ATOMIC, ON by default with GCC or Clang).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+
+// --- Public define
+
+/**
+ * \brief Alignment of arena and of each part of a block
+ */
+#define BUF_POOL_ALIGNMENT 8U
+
+/**
+ * \brief Round size up to BUF_POOL_ALIGNMENT
+ */
+#define BUF_POOL_ALIGN(size) \
+  (((size_t) (size) + BUF_POOL_ALIGNMENT - 1U) & ~(size_t) (BUF_POOL_ALIGNMENT - 1U))
+
+/**
+ * \brief Block size in arena for a given buffer data size
+ */
+#define BUF_POOL_BLOCK_SIZE(data_size)                            \
+  (BUF_POOL_ALIGN(sizeof(uint32_t)) + BUF_POOL_ALIGN(sizeof(BUF_t)) \
+   + BUF_POOL_ALIGN(data_size))
+
+/**
+ * \brief Arena size for a given block count and buffer data size
+ */
+#define BUF_POOL_ARENA_SIZE(block_count, data_size) \
+  ((size_t) (block_count) * BUF_POOL_BLOCK_SIZE(data_size))
+
+// --- Public type
+
+/**
+ * \brief Buffer pool structure
+ * \warning Do not use this structure directly, use BUF_Pool API instead
+ */
+typedef struct {
+  uint8_t* arena;         /*!< Arena, provided by caller */
+  size_t block_size;      /*!< Block size in arena */
+  uint32_t block_count;   /*!< Block count */
+  BUF_size_t data_size;   /*!< Data size of each buffer */
+  uint64_t head;          /*!< Tag << 32 | first free block index + 1 */
+  size_t used_count;      /*!< Blocks currently acquired */
+  size_t high_water_mark; /*!< Maximum of used_count */
+  size_t failed_count;    /*!< Acquisitions failed because pool was empty */
+} BUF_Pool_t;
+
+// --- Public function
+
+/**
+ * \brief Buffer pool initialization
+ * \param pool Pool to initialize
+ * \param arena Arena, aligned on BUF_POOL_ALIGNMENT
+ * \param arena_size Arena size, \see BUF_POOL_ARENA_SIZE
+ * \param data_size Data size of each buffer
+ * \return true if initialized with at least one block, false otherwise
+ */
+bool BUF_PoolInit(BUF_Pool_t* pool,
+                  uint8_t* arena,
+                  size_t arena_size,
+                  BUF_size_t data_size);
+
+/**
+ * \brief Acquire a buffer from pool
+ * \param pool Pool to acquire from
+ * \return Empty buffer of data_size, NULL if pool is empty
+ */
+BUF_t* BUF_PoolAcquire(BUF_Pool_t* pool);
+
+/**
+ * \brief Release a buffer to pool
+ * \param pool Pool to release to
+ * \param buffer Buffer acquired from this pool
+ * \return true if released, false if buffer is not a block of pool or is
+ * already released
+ */
+bool BUF_PoolRelease(BUF_Pool_t* pool, BUF_t* buffer);
+
+#if defined(BUF_POOL_ATOMIC_ENABLE)
+
+/**
+ * \brief Acquire a buffer from pool, lock-free
+ * \param pool Pool to acquire from
+ * \return Empty buffer of data_size, NULL if pool is empty
+ * \details Requires lock-free 64-bit compare-and-swap, e.g. not ARMv6-M
+ */
+BUF_t* BUF_PoolAcquireAtomic(BUF_Pool_t* pool);
+
+/**
+ * \brief Release a buffer to pool, lock-free
+ * \param pool Pool to release to
+ * \param buffer Buffer acquired from this pool
+ * \return true if released, false if buffer is not a block of pool or is
+ * already released
+ */
+bool BUF_PoolReleaseAtomic(BUF_Pool_t* pool, BUF_t* buffer);
+
+#endif
+
+/**
+ * \brief Get block count
+ * \param pool Pool to check
+ * \return Block count
+ */
+size_t BUF_PoolGetBlockCount(const BUF_Pool_t* pool);
+
+/**
+ * \brief Get count of blocks currently acquired
+ * \param pool Pool to check
+ * \return Used block count
+ */
+size_t BUF_PoolGetUsedCount(const BUF_Pool_t* pool);
+
+/**
+ * \brief Get maximum count of blocks acquired at the same time
+ * \param pool Pool to check
+ * \return High-water mark
+ */
+size_t BUF_PoolGetHighWaterMark(const BUF_Pool_t* pool);
+
+/**
+ * \brief Get count of acquisitions failed because pool was empty
+ * \param pool Pool to check
+ * \return Failed acquisition count
+ */
+size_t BUF_PoolGetFailedCount(const BUF_Pool_t* pool);
@@ -0,0 +1,193 @@
+/**
+ * \file buffer_ring.h
+ * \brief Buffer for MCU, single-producer/single-consumer ring buffer
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details Lock-free when exactly one context writes (producer) and exactly
+ * one context reads (consumer), e.g. ISR to thread or core to core.
+ * Indices are free-running and masked on access, capacity must be a power
+ * of two.
+ *
+ * Only available when BUF_RING_ENABLE is defined (CMake BUFFER_MCU_RING, ON
+ * by default with GCC or Clang), as it needs __atomic builtins.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+
+#if defined(BUF_RING_ENABLE)
+
+// --- Public define
+
+/**
+ * \brief Alignment of producer and consumer sides to avoid false sharing
+ * \details Can be lowered on MCU without data cache to save RAM
+ */
+#ifndef BUF_CACHE_LINE_SIZE
+#define BUF_CACHE_LINE_SIZE 64U
+#endif
+
+/**
+ * \brief Align a member or an object on BUF_CACHE_LINE_SIZE
+ */
+#if defined(__cplusplus)
+#define BUF_CACHE_ALIGNED alignas(BUF_CACHE_LINE_SIZE)
+#elif defined(__GNUC__)
+#define BUF_CACHE_ALIGNED __attribute__((aligned(BUF_CACHE_LINE_SIZE)))
+#else
+#define BUF_CACHE_ALIGNED _Alignas(BUF_CACHE_LINE_SIZE)
+#endif
+
+// --- Public type
+
+/**
+ * \brief Ring buffer index owned by one side
+ * \warning Do not use this structure directly, use BUF_Ring API instead
+ */
+typedef struct {
+  BUF_size_t index;  /*!< Free-running index, written by owner side only */
+  BUF_size_t cached; /*!< Last seen index of the other side */
+} BUF_RingSide_t;
+
+/**
+ * \brief Ring buffer structure
+ * \details data and mask sit alone on the first line, only read after init.
+ * Each side starts its own line, so a write of one side index never
+ * invalidates the line the other side reads on every call
+ * \warning Do not use this structure directly, use BUF_Ring API instead
+ * \warning The ring must be aligned on BUF_CACHE_LINE_SIZE. Static and
+ * automatic objects are aligned by the compiler, heap objects need an
+ * aligned allocation, e.g. aligned_alloc(BUF_CACHE_LINE_SIZE, size)
+ */
+typedef struct {
+  uint8_t* data;                             /*!< Ring buffer data */
+  BUF_size_t mask;                           /*!< Ring buffer size - 1 */
+  BUF_CACHE_ALIGNED BUF_RingSide_t producer; /*!< Write side, index is the head */
+  BUF_CACHE_ALIGNED BUF_RingSide_t consumer; /*!< Read side, index is the tail */
+} BUF_Ring_t;
+
+// --- Public function
+
+/**
+ * \brief Ring buffer initialization
+ * \param ring Ring buffer to initialize
+ * \param data Ring buffer data
+ * \param size Ring buffer size, power of two up to half of BUF_size_t range
+ * \return true if initialized, false otherwise
+ */
+bool BUF_RingInit(BUF_Ring_t* ring, uint8_t* data, BUF_size_t size);
+
+/**
+ * \brief Reset ring buffer read index and write index
+ * \param ring Ring buffer to reset
+ * \warning Not thread safe, producer and consumer must be stopped
+ */
+void BUF_RingReset(BUF_Ring_t* ring);
+
+/**
+ * \brief Get ring buffer size
+ * \param ring Ring buffer to check
+ * \return Ring buffer size
+ */
+BUF_size_t BUF_RingGetSize(const BUF_Ring_t* ring);
+
+/**
+ * \brief Get free space in ring buffer
+ * \param ring Ring buffer to check
+ * \return Free space, may grow concurrently if called by producer
+ */
+BUF_size_t BUF_RingGetFreeSize(const BUF_Ring_t* ring);
+
+/**
+ * \brief Get data to read in ring buffer
+ * \param ring Ring buffer to check
+ * \return Data to read count, may grow concurrently if called by consumer
+ */
+BUF_size_t BUF_RingGetToReadCount(const BUF_Ring_t* ring);
+
+/**
+ * \brief Is ring buffer empty
+ * \param ring Ring buffer to check
+ * \return TRUE if empty, FALSE otherwise
+ */
+bool BUF_RingIsEmpty(const BUF_Ring_t* ring);
+
+/**
+ * \brief Is ring buffer full
+ * \param ring Ring buffer to check
+ * \return TRUE if full, FALSE otherwise
+ */
+bool BUF_RingIsFull(const BUF_Ring_t* ring);
+
+/**
+ * \brief Write 1 byte to ring buffer, producer side
+ * \param ring Ring buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ */
+uint8_t BUF_RingWriteUint8(BUF_Ring_t* ring, uint8_t data);
+
+/**
+ * \brief Write 2 bytes to ring buffer, producer side
+ * \param ring Ring buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ * \details All or nothing
+ */
+uint8_t BUF_RingWriteUint16(BUF_Ring_t* ring, uint16_t data);
+
+/**
+ * \brief Write 4 bytes to ring buffer, producer side
+ * \param ring Ring buffer to write to
+ * \param data Data to write
+ * \return written byte count, 0 if error
+ * \details All or nothing
+ */
+uint8_t BUF_RingWriteUint32(BUF_Ring_t* ring, uint32_t data);
+
+/**
+ * \brief Write raw data to ring buffer, producer side
+ * \param ring Ring buffer to write to
+ * \param data Data to write
+ * \param size Data size
+ * \return written byte count, 0 if error
+ * \details All or nothing, data is published to consumer at once
+ */
+BUF_size_t BUF_RingWriteRaw(BUF_Ring_t* ring, const uint8_t* data, BUF_size_t size);
+
+/**
+ * \brief Read 1 byte from ring buffer, consumer side
+ * \param ring Ring buffer to read
+ * \return data read
+ */
+uint8_t BUF_RingReadUint8(BUF_Ring_t* ring);
+
+/**
+ * \brief Read 2 bytes from ring buffer, consumer side
+ * \param ring Ring buffer to read
+ * \return data read, 0 if not enough data
+ */
+uint16_t BUF_RingReadUint16(BUF_Ring_t* ring);
+
+/**
+ * \brief Read 4 bytes from ring buffer, consumer side
+ * \param ring Ring buffer to read
+ * \return data read, 0 if not enough data
+ */
+uint32_t BUF_RingReadUint32(BUF_Ring_t* ring);
+
+/**
+ * \brief Read raw data from ring buffer, consumer side
+ * \param ring Ring buffer to read
+ * \param data Destination
+ * \param size Size to read
+ * \return read byte count, 0 if error
+ * \details All or nothing
+ */
+BUF_size_t BUF_RingReadRaw(BUF_Ring_t* ring, uint8_t* data, BUF_size_t size);
+
+#endif
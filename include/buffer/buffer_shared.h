@@ -0,0 +1,137 @@
+/**
+ * \file buffer_shared.h
+ * \brief Buffer for MCU, multi-producer append to one buffer
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details Several threads or ISRs append records to one BUF_t without a
+ * lock. Each append marks its start in a free in-flight entry, reserves its
+ * slot with an atomic fetch-add on the reservation offset, fills it in
+ * place, then frees the entry on commit. No producer ever waits for another
+ * one.
+ *
+ * The consumer calls BUF_SharedSync to move write_index of the buffer up
+ * to the published bytes, then reads them with the usual BUF API. Bytes are
+ * published up to the lowest start still in flight, so every slot below is
+ * filled and a slot is never seen half written, while a slow producer only
+ * holds back the bytes after its own slot. Records are laid out in
+ * reservation order, which is not the order of calls across producers.
+ *
+ * \code
+ * // Producers
+ * BUF_SharedWriteRaw(&shared, record, record_size);
+ * // Consumer
+ * if (BUF_SharedSync(&shared) > 0U) { BUF_WriteToFd(&buffer, fd, &status); }
+ * \endcode
+ *
+ * Only available when BUF_SHARED_ENABLE is defined (CMake BUFFER_MCU_SHARED,
+ * ON by default with GCC or Clang), as it needs __atomic builtins.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+
+#if defined(BUF_SHARED_ENABLE)
+
+// --- Public define
+
+/**
+ * \brief Largest count of appends in flight at the same time
+ * \details One entry per producer context that may be preempted between
+ * reserve and commit, a reservation fails when all entries are taken
+ */
+#ifndef BUF_SHARED_IN_FLIGHT_COUNT
+#define BUF_SHARED_IN_FLIGHT_COUNT 8U
+#endif
+
+// --- Public type
+
+/**
+ * \brief Shared append state, owned by caller
+ * \warning Do not use this structure directly, use BUF_Shared API instead
+ */
+typedef struct {
+  BUF_t* buffer;   /*!< Buffer appended to, write_index moved by consumer */
+  size_t reserved; /*!< Offset of next slot, fetch-add by producers */
+  size_t end;      /*!< Buffer size, or start of the slot that overflowed */
+  /*! Lower bound of start of each slot in flight, SIZE_MAX if free */
+  size_t in_flight[BUF_SHARED_IN_FLIGHT_COUNT];
+} BUF_Shared_t;
+
+/**
+ * \brief Slot reserved by a producer, filled in place then committed
+ */
+typedef struct {
+  uint8_t* data;   /*!< Slot data, NULL if not reserved */
+  BUF_size_t size; /*!< Slot size */
+  uint8_t entry;   /*!< In-flight entry held until commit */
+} BUF_SharedSlot_t;
+
+// --- Public function
+
+/**
+ * \brief Start shared append at write_index of buffer
+ * \param shared Shared append state to initialize
+ * \param buffer Buffer to append to
+ * \return true if initialized, false otherwise
+ * \warning Until BUF_SharedReset, the consumer may read the buffer but must
+ * not write, compact or reset it
+ */
+bool BUF_SharedInit(BUF_Shared_t* shared, BUF_t* buffer);
+
+/**
+ * \brief Reset buffer and shared append state, for reuse once read
+ * \param shared Shared append state
+ * \warning Not thread safe, producers must be stopped
+ */
+void BUF_SharedReset(BUF_Shared_t* shared);
+
+/**
+ * \brief Reserve a slot to fill in place, producer side
+ * \param shared Shared append state
+ * \param size Slot size
+ * \param slot Reserved slot, to pass to BUF_SharedCommit
+ * \return slot data of size bytes, NULL if buffer is full or all in-flight
+ * entries are taken
+ * \details A slot must be committed with BUF_SharedCommit, bytes from its
+ * start on are not published until then. A slot that is not reserved needs
+ * no commit and counts as a failed write of the buffer. Requires atomic
+ * fetch-add and compare-and-swap, e.g. not ARMv6-M
+ */
+uint8_t*
+BUF_SharedReserve(BUF_Shared_t* shared, BUF_size_t size, BUF_SharedSlot_t* slot);
+
+/**
+ * \brief Commit a slot filled after BUF_SharedReserve, producer side
+ * \param shared Shared append state
+ * \param slot Slot returned by BUF_SharedReserve, cleared once committed
+ * \return committed byte count, 0 if error
+ * \details A slot is committed once, a second commit returns 0
+ */
+BUF_size_t BUF_SharedCommit(BUF_Shared_t* shared, BUF_SharedSlot_t* slot);
+
+/**
+ * \brief Append raw data, producer side
+ * \param shared Shared append state
+ * \param data Data to write
+ * \param size Data size
+ * \return written byte count, 0 if error
+ * \details All or nothing, reserve, copy and commit
+ */
+BUF_size_t
+BUF_SharedWriteRaw(BUF_Shared_t* shared, const uint8_t* data, BUF_size_t size);
+
+/**
+ * \brief Move write_index of buffer to the published bytes, consumer side
+ * \param shared Shared append state
+ * \return newly published byte count, 0 if none
+ * \details Publishes up to the first slot still in flight. Digest and stats
+ * of the buffer are updated here, in buffer order
+ */
+BUF_size_t BUF_SharedSync(BUF_Shared_t* shared);
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * \file buffer_stats.h
+ * \brief Buffer for MCU, instrumentation counters
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details Stats attached to a buffer count bytes read and written, refused
+ * or truncated accesses, compares and views, and keep the high-water mark of
+ * write_index, to size buffers from production data. Counters are updated
+ * with relaxed atomics, one stats block can be shared by several buffers.
+ *
+ * Only available when BUF_STATS_ENABLE is defined (CMake BUFFER_MCU_STATS),
+ * otherwise BUF_t has no stats field and accesses have no stats cost.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "buffer/buffer.h"
+
+#if defined(BUF_STATS_ENABLE)
+
+#if !defined(__GNUC__)
+#error "BUF_Stats_t requires __atomic builtins (GCC or Clang)"
+#endif
+
+// --- Public type
+
+/**
+ * \brief Instrumentation counters, owned by caller
+ * \details Read them from a snapshot, \see BUF_StatsGetSnapshot
+ */
+struct BUF_Stats_s {
+  size_t write_index_high_water; /*!< Maximum write_index after a write */
+  size_t bytes_written;          /*!< Bytes written by Write* */
+  size_t bytes_read;             /*!< Bytes read by Read* and WriteCopy */
+  size_t write_failed;           /*!< Write* refused or truncated */
+  size_t read_failed;            /*!< Read* refused */
+  size_t compare_count;          /*!< BUF_Compare calls */
+  size_t view_count;             /*!< Views made on buffer */
+};
+
+// --- Public function
+
+/**
+ * \brief Reset all counters
+ * \param stats Stats to reset
+ * \warning Not atomic as a whole, concurrent updates may be lost
+ */
+void BUF_StatsInit(BUF_Stats_t* stats);
+
+/**
+ * \brief Attach stats to buffer
+ * \param buffer Buffer to attach to
+ * \param stats Stats updated by next accesses, NULL to detach
+ * \details Views made on buffer are not attached
+ */
+void BUF_AttachStats(BUF_t* buffer, BUF_Stats_t* stats);
+
+/**
+ * \brief Copy counters
+ * \param stats Stats to read
+ * \param snapshot Destination, each counter is loaded atomically
+ */
+void BUF_StatsGetSnapshot(const BUF_Stats_t* stats, BUF_Stats_t* snapshot);
+
+/**
+ * \brief Add written bytes and raise high-water mark
+ * \param stats Stats to update
+ * \param size Byte count written
+ * \param write_index write_index after the write
+ * \details Called by buffer accessors
+ */
+void BUF_StatsAddWritten(BUF_Stats_t* stats,
+                         BUF_size_t size,
+                         BUF_size_t write_index);
+
+#endif
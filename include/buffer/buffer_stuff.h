@@ -0,0 +1,115 @@
+/**
+ * \file buffer_stuff.h
+ * \brief Buffer for MCU, COBS, SLIP and HDLC byte stuffing
+ * \date 2024-04
+ * \author Nicolas Boutin
+ * \details Encoders consume all data to read of src as one frame and append
+ * the stuffed frame at write_index of dst, delimiter included:
+ * - COBS: zero-free blocks, frame ends with 0x00
+ * - SLIP (RFC 1055): frame ends with END 0xC0, END and ESC 0xDB escaped
+ * - HDLC (RFC 1662, asynchronous): frame between flags 0x7E, flag and
+ *   escape 0x7D escaped as byte XOR 0x20, no control character map, FCS is
+ *   left to the caller, e.g. BUF_WriteCrc16Ccitt before encoding
+ *
+ * Decoders are streaming: they consume src up to the end of the frame and
+ * keep their state in BUF_StuffDecoder_t, so a frame split over two reads
+ * is decoded by two calls. Runs of plain bytes are found with BUF_FindAnyOf
+ * or memchr and copied with memcpy.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "buffer/buffer.h"
+
+// --- Public type
+
+/**
+ * \brief Outcome of a decode call
+ */
+typedef enum {
+  BUF_STUFF_MORE  = 0, /*!< src consumed, frame continues in next data */
+  BUF_STUFF_FRAME = 1, /*!< Frame complete at end of dst */
+  BUF_STUFF_ERROR = 2, /*!< Invalid or aborted frame, or dst full */
+} BUF_StuffStatus_t;
+
+/**
+ * \brief Streaming decoder state, owned by caller
+ * \warning Do not use this structure directly, use BUF_StuffDecoderInit
+ */
+typedef struct {
+  BUF_size_t length;    /*!< Bytes decoded in current frame */
+  uint8_t run;          /*!< COBS bytes left in current block */
+  bool is_zero_pending; /*!< COBS zero to emit before next block */
+  bool is_escaped;      /*!< SLIP/HDLC escape byte received */
+  bool is_discarding;   /*!< Skipping to next delimiter after error */
+} BUF_StuffDecoder_t;
+
+// --- Public function
+
+/**
+ * \brief Init decoder, at frame start
+ * \param decoder Decoder to init
+ */
+void BUF_StuffDecoderInit(BUF_StuffDecoder_t* decoder);
+
+/**
+ * \brief Append COBS encoding of data to read of src, with 0x00 delimiter
+ * \param dst Buffer to write to
+ * \param src Buffer to read from, all data to read is consumed
+ * \return encoded byte count, 0 if error
+ * \details All or nothing, nothing is written or consumed if dst is too
+ * small. Worst case is n + n / 254 + 2 bytes
+ */
+BUF_size_t BUF_CobsEncode(BUF_t* dst, BUF_t* src);
+
+/**
+ * \brief Decode COBS bytes of src until end of frame
+ * \param dst Buffer to write frame to
+ * \param src Buffer to read from
+ * \param decoder Decoder state, kept between calls
+ * \return BUF_STUFF_FRAME when a frame is complete, src may still hold next
+ * frames. BUF_STUFF_MORE when src is consumed inside a frame.
+ * BUF_STUFF_ERROR when the frame is invalid or does not fit in dst, the
+ * caller drops the frame bytes already in dst and the decoder skips to the
+ * next delimiter
+ * \details Empty frames are skipped
+ */
+BUF_StuffStatus_t
+BUF_CobsDecode(BUF_t* dst, BUF_t* src, BUF_StuffDecoder_t* decoder);
+
+/**
+ * \brief Append SLIP encoding of data to read of src, with END delimiter
+ * \param dst Buffer to write to
+ * \param src Buffer to read from, all data to read is consumed
+ * \return encoded byte count, 0 if error
+ * \details All or nothing, worst case is 2 * n + 1 bytes
+ */
+BUF_size_t BUF_SlipEncode(BUF_t* dst, BUF_t* src);
+
+/**
+ * \brief Decode SLIP bytes of src until end of frame
+ * \details Same behavior as BUF_CobsDecode, ESC followed by END aborts the
+ * frame
+ */
+BUF_StuffStatus_t
+BUF_SlipDecode(BUF_t* dst, BUF_t* src, BUF_StuffDecoder_t* decoder);
+
+/**
+ * \brief Append HDLC encoding of data to read of src, between flags
+ * \param dst Buffer to write to
+ * \param src Buffer to read from, all data to read is consumed
+ * \return encoded byte count, 0 if error
+ * \details All or nothing, worst case is 2 * n + 2 bytes
+ */
+BUF_size_t BUF_HdlcEncode(BUF_t* dst, BUF_t* src);
+
+/**
+ * \brief Decode HDLC bytes of src until end of frame
+ * \details Same behavior as BUF_CobsDecode, escape followed by flag aborts
+ * the frame. A flag shared by two frames gives no empty frame
+ */
+BUF_StuffStatus_t
+BUF_HdlcDecode(BUF_t* dst, BUF_t* src, BUF_StuffDecoder_t* decoder);
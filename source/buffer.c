@@ -9,12 +9,76 @@
 #include <string.h>
 
 #include "buffer/buffer.h"
+#include "buffer/buffer_inline.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// --- Private define
+
+_Static_assert(sizeof(float) == 4U, "float must be IEEE-754 single");
+_Static_assert(sizeof(double) == 8U, "double must be IEEE-754 double");
 
 // --- Private function
 
 static BUF_size_t buf_Min(BUF_size_t left, BUF_size_t right);
 static bool
+buf_is_in_bounds(const BUF_t* buffer, BUF_size_t index, BUF_size_t length);
+static bool
 buf_is_memory_overlapping(const void* dest, const void* src, size_t length);
+static size_t buf_swap16_simd(uint8_t* dst, const uint8_t* src, size_t count);
+static size_t buf_swap32_simd(uint8_t* dst, const uint8_t* src, size_t count);
+static void buf_store_be16_array(uint8_t* dst, const uint16_t* src, size_t count);
+static void buf_store_be32_array(uint8_t* dst, const uint32_t* src, size_t count);
+static void buf_load_be16_array(uint16_t* dst, const uint8_t* src, size_t count);
+static void buf_load_be32_array(uint32_t* dst, const uint8_t* src, size_t count);
+static size_t buf_swap64_simd(uint8_t* dst, const uint8_t* src, size_t count);
+static void buf_copy_elements(uint8_t* dst,
+                              const uint8_t* src,
+                              size_t count,
+                              uint8_t width,
+                              BUF_Endian_t endian);
+static BUF_size_t buf_read_elements(BUF_t* buffer,
+                                    void* data,
+                                    BUF_size_t count,
+                                    uint8_t width,
+                                    BUF_Endian_t endian);
+static BUF_size_t buf_write_elements(BUF_t* buffer,
+                                     const void* data,
+                                     BUF_size_t count,
+                                     uint8_t width,
+                                     BUF_Endian_t endian);
+static float buf_float32_from_bits(uint32_t bits);
+static uint32_t buf_float32_to_bits(float value);
+static double buf_float64_from_bits(uint64_t bits);
+static uint64_t buf_float64_to_bits(double value);
+static uint8_t buf_varint_size(uint64_t value);
+static uint8_t buf_varint_encode(uint8_t* dst, uint64_t value);
+static uint8_t
+buf_varint_decode(const uint8_t* src, size_t size, uint8_t bits, uint64_t* value);
+static uint8_t buf_write_varint(BUF_t* buffer, uint64_t value);
+static uint8_t buf_read_varint(BUF_t* buffer, uint8_t bits, uint64_t* value);
+static uint64_t buf_zigzag_encode(int64_t value);
+static int64_t buf_zigzag_decode(uint64_t value);
+static size_t buf_varu32_decode_simd(uint32_t* dst,
+                                     size_t count,
+                                     const uint8_t* src,
+                                     size_t size,
+                                     size_t* consumed);
+static size_t buf_find_byte(const uint8_t* src, size_t size, uint8_t value);
+static size_t buf_find_any_of(const uint8_t* src,
+                              size_t size,
+                              const uint8_t* set,
+                              size_t set_size);
+static size_t buf_find_pattern(const uint8_t* src,
+                               size_t size,
+                               const uint8_t* pattern,
+                               size_t pattern_size);
 
 // --- Public functions
 
@@ -28,6 +92,13 @@ void BUF_InitEmpty(BUF_t* buffer, uint8_t* data, BUF_size_t size)
     buffer->size        = size;
     buffer->read_index  = 0;
     buffer->write_index = 0;
+    buffer->endian      = BUF_ENDIAN_BIG;
+#if defined(BUF_DIGEST_ENABLE)
+    buffer->digest = NULL;
+#endif
+#if defined(BUF_STATS_ENABLE)
+    buffer->stats = NULL;
+#endif
     if (data != NULL)
     {
       buffer->data = data;
@@ -52,9 +123,12 @@ void BUF_MakeViewFull(BUF_t* dst_buffer,
   if ((dst_buffer != NULL) && (src_buffer != NULL)
       && (src_buffer->data != NULL))
   {
-    if ((start_index < src_buffer->size) && (size <= src_buffer->size))
+    if ((start_index < src_buffer->size)
+        && buf_is_in_bounds(src_buffer, start_index, size))
     {
       BUF_InitFull(dst_buffer, &src_buffer->data[start_index], size);
+      dst_buffer->endian = src_buffer->endian;
+      buf_on_view(src_buffer);
     }
     else
     {
@@ -218,10 +292,9 @@ uint16_t BUF_GetUint16(const BUF_t* buffer, BUF_size_t index)
 {
   uint16_t value = 0;
   if ((buffer != NULL) && (buffer->data != NULL)
-      && ((index + 1) < buffer->size))
+      && buf_is_in_bounds(buffer, index, 2U))
   {
-    value = (uint16_t) ((uint16_t) (buffer->data[index] << 8U)
-                        | buffer->data[index + 1]);
+    value = buf_load_be16(&buffer->data[index]);
   }
   return value;
 }
@@ -230,12 +303,20 @@ uint32_t BUF_GetUint32(const BUF_t* buffer, BUF_size_t index)
 {
   uint32_t value = 0;
   if ((buffer != NULL) && (buffer->data != NULL)
-      && ((index + 3) < buffer->size))
+      && buf_is_in_bounds(buffer, index, 4U))
+  {
+    value = buf_load_be32(&buffer->data[index]);
+  }
+  return value;
+}
+
+uint64_t BUF_GetUint64(const BUF_t* buffer, BUF_size_t index)
+{
+  uint64_t value = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && buf_is_in_bounds(buffer, index, 8U))
   {
-    value = (uint32_t) ((uint32_t) (buffer->data[index] << 24U)
-                        | (uint32_t) (buffer->data[index + 1] << 16U)
-                        | (uint32_t) (buffer->data[index + 2] << 8U)
-                        | buffer->data[index + 3]);
+    value = buf_load_be64(&buffer->data[index]);
   }
   return value;
 }
@@ -265,11 +346,10 @@ uint8_t BUF_PutUint16(BUF_t* buffer, uint16_t data, BUF_size_t index)
 {
   uint8_t written = 0;
   if ((buffer != NULL) && (buffer->data != NULL)
-      && ((index + 1) < buffer->size))
+      && buf_is_in_bounds(buffer, index, 2U))
   {
-    buffer->data[index]     = (uint8_t) ((data & 0xFF00U) >> 8U);
-    buffer->data[index + 1] = (uint8_t) (data & 0xFFU);
-    written                 = 2;
+    buf_store_be16(&buffer->data[index], data);
+    written = 2;
   }
   return written;
 }
@@ -278,95 +358,201 @@ uint8_t BUF_PutUint32(BUF_t* buffer, uint32_t data, BUF_size_t index)
 {
   uint8_t written = 0;
   if ((buffer != NULL) && (buffer->data != NULL)
-      && ((index + 3) < buffer->size))
+      && buf_is_in_bounds(buffer, index, 4U))
   {
-    buffer->data[index]     = (uint8_t) ((data & 0xFF000000U) >> 24U);
-    buffer->data[index + 1] = (uint8_t) ((data & 0xFF0000U) >> 16U);
-    buffer->data[index + 2] = (uint8_t) ((data & 0xFF00U) >> 8U);
-    buffer->data[index + 3] = (uint8_t) (data & 0xFFU);
-    written                 = 4;
+    buf_store_be32(&buffer->data[index], data);
+    written = 4;
   }
   return written;
 }
 
-uint8_t BUF_ReadUint8(BUF_t* buffer)
+uint8_t BUF_PutUint64(BUF_t* buffer, uint64_t data, BUF_size_t index)
 {
-  uint8_t read = 0;
+  uint8_t written = 0;
   if ((buffer != NULL) && (buffer->data != NULL)
-      && (BUF_GetToReadCount(buffer) >= 1))
+      && buf_is_in_bounds(buffer, index, 8U))
   {
-    read = buffer->data[buffer->read_index];
-    buffer->read_index += 1;
+    buf_store_be64(&buffer->data[index], data);
+    written = 8;
   }
-  return read;
+  return written;
+}
+
+uint8_t BUF_ReadUint8(BUF_t* buffer)
+{
+  return BUF_InlineReadUint8(buffer);
 }
 
 uint16_t BUF_ReadUint16(BUF_t* buffer)
 {
-  uint16_t read = 0;
-  if ((buffer != NULL) && (BUF_GetToReadCount(buffer) >= 2))
+  return BUF_InlineReadUint16(buffer);
+}
+
+uint32_t BUF_ReadUint32(BUF_t* buffer)
+{
+  return BUF_InlineReadUint32(buffer);
+}
+
+uint64_t BUF_ReadUint64(BUF_t* buffer)
+{
+  return BUF_InlineReadUint64(buffer);
+}
+
+uint8_t BUF_WriteUint8(BUF_t* buffer, uint8_t data)
+{
+  return BUF_InlineWriteUint8(buffer, data);
+}
+
+uint8_t BUF_WriteUint16(BUF_t* buffer, uint16_t data)
+{
+  return BUF_InlineWriteUint16(buffer, data);
+}
+
+uint8_t BUF_WriteUint32(BUF_t* buffer, uint32_t data)
+{
+  return BUF_InlineWriteUint32(buffer, data);
+}
+
+uint8_t BUF_WriteUint64(BUF_t* buffer, uint64_t data)
+{
+  return BUF_InlineWriteUint64(buffer, data);
+}
+
+BUF_size_t BUF_GetUint16Array(const BUF_t* buffer,
+                              uint16_t* data,
+                              BUF_size_t count,
+                              BUF_size_t index)
+{
+  BUF_size_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (index <= buffer->size)
+      && (count <= ((buffer->size - index) / 2U)))
   {
-    read = (uint16_t) (BUF_ReadUint8(buffer) << 8U);
-    read |= BUF_ReadUint8(buffer);
+    buf_load_be16_array(data, &buffer->data[index], count);
+    read = (BUF_size_t) (count * 2U);
   }
   return read;
 }
 
-uint32_t BUF_ReadUint32(BUF_t* buffer)
+BUF_size_t BUF_GetUint32Array(const BUF_t* buffer,
+                              uint32_t* data,
+                              BUF_size_t count,
+                              BUF_size_t index)
 {
-  uint32_t read = 0;
-  if ((buffer != NULL) && (BUF_GetToReadCount(buffer) >= 4))
+  BUF_size_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (index <= buffer->size)
+      && (count <= ((buffer->size - index) / 4U)))
   {
-    read = (uint32_t) BUF_ReadUint8(buffer) << 24U;
-    read |= (uint32_t) BUF_ReadUint8(buffer) << 16U;
-    read |= (uint32_t) BUF_ReadUint8(buffer) << 8U;
-    read |= (uint32_t) BUF_ReadUint8(buffer);
+    buf_load_be32_array(data, &buffer->data[index], count);
+    read = (BUF_size_t) (count * 4U);
   }
   return read;
 }
 
-uint8_t BUF_WriteUint8(BUF_t* buffer, uint8_t data)
+BUF_size_t BUF_PutUint16Array(BUF_t* buffer,
+                              const uint16_t* data,
+                              BUF_size_t count,
+                              BUF_size_t index)
 {
-  uint8_t written = 0;
-  if ((buffer != NULL) && (buffer->data != NULL)
-      && (BUF_GetFreeSize(buffer) > 0))
+  BUF_size_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (index <= buffer->size)
+      && (count <= ((buffer->size - index) / 2U)))
   {
-    buffer->data[buffer->write_index] = data;
-    buffer->write_index++;
-    written = 1;
+    buf_store_be16_array(&buffer->data[index], data, count);
+    written = (BUF_size_t) (count * 2U);
   }
   return written;
 }
 
-uint8_t BUF_WriteUint16(BUF_t* buffer, uint16_t data)
+BUF_size_t BUF_PutUint32Array(BUF_t* buffer,
+                              const uint32_t* data,
+                              BUF_size_t count,
+                              BUF_size_t index)
 {
-  uint8_t written = 0;
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 8U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data));
+  BUF_size_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (index <= buffer->size)
+      && (count <= ((buffer->size - index) / 4U)))
+  {
+    buf_store_be32_array(&buffer->data[index], data, count);
+    written = (BUF_size_t) (count * 4U);
+  }
   return written;
 }
 
-uint8_t BUF_WriteUint32(BUF_t* buffer, uint32_t data)
+BUF_size_t BUF_ReadUint16Array(BUF_t* buffer, uint16_t* data, BUF_size_t count)
 {
-  uint8_t written = 0;
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 24U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 16U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 8U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data));
+  BUF_size_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (count <= (BUF_GetToReadCount(buffer) / 2U)))
+  {
+    buf_load_be16_array(data, &buffer->data[buffer->read_index], count);
+    read = (BUF_size_t) (count * 2U);
+    buffer->read_index += read;
+    buf_on_read(buffer, read);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+BUF_size_t BUF_ReadUint32Array(BUF_t* buffer, uint32_t* data, BUF_size_t count)
+{
+  BUF_size_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (count <= (BUF_GetToReadCount(buffer) / 4U)))
+  {
+    buf_load_be32_array(data, &buffer->data[buffer->read_index], count);
+    read = (BUF_size_t) (count * 4U);
+    buffer->read_index += read;
+    buf_on_read(buffer, read);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+BUF_size_t
+BUF_WriteUint16Array(BUF_t* buffer, const uint16_t* data, BUF_size_t count)
+{
+  BUF_size_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (count <= (BUF_GetFreeSize(buffer) / 2U)))
+  {
+    buf_store_be16_array(&buffer->data[buffer->write_index], data, count);
+    written = (BUF_size_t) (count * 2U);
+    buffer->write_index += written;
+    buf_on_write(buffer, written);
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
   return written;
 }
 
-uint8_t BUF_WriteUint64(BUF_t* buffer, uint64_t data)
+BUF_size_t
+BUF_WriteUint32Array(BUF_t* buffer, const uint32_t* data, BUF_size_t count)
 {
-  uint8_t written = 0;
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 56U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 48U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 40U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 32U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 24U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 16U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data >> 8U));
-  written += BUF_WriteUint8(buffer, (uint8_t) (data));
+  BUF_size_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (count <= (BUF_GetFreeSize(buffer) / 4U)))
+  {
+    buf_store_be32_array(&buffer->data[buffer->write_index], data, count);
+    written = (BUF_size_t) (count * 4U);
+    buffer->write_index += written;
+    buf_on_write(buffer, written);
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
   return written;
 }
 
@@ -385,10 +571,36 @@ BUF_size_t BUF_WriteRaw(BUF_t* buffer, const uint8_t* data, BUF_size_t size)
     memcpy(&buffer->data[buffer->write_index], data, size);
     buffer->write_index += size;
     written = size;
+    buf_on_write(buffer, size);
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
   }
   return written;
 }
 
+BUF_size_t BUF_ReadRaw(BUF_t* buffer, uint8_t* data, BUF_size_t size)
+{
+  BUF_size_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (size > 0) && (BUF_GetToReadCount(buffer) >= size)
+      && (buf_is_memory_overlapping(
+            &buffer->data[buffer->read_index], data, size)
+          == false))
+  {
+    memcpy(data, &buffer->data[buffer->read_index], size);
+    buffer->read_index += size;
+    read = size;
+    buf_on_read(buffer, size);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
 /**
  * \details Copy data from source.read_index to destination.write_index
  */
@@ -406,10 +618,17 @@ BUF_size_t BUF_WriteCopy(BUF_t* dst, BUF_t* src, BUF_size_t size)
     memcpy(&dst->data[dst->write_index], &src->data[src->read_index], to_copy);
     dst->write_index += to_copy;
     src->read_index += to_copy;
+    buf_on_write(dst, to_copy);
+    buf_on_read(src, to_copy);
+    if (dst_free_size < buf_Min(src_to_read_count, size))
+    {
+      buf_on_write_failed(dst);
+    }
   }
   else
   {
     to_copy = 0;
+    buf_on_write_failed(dst);
   }
   return to_copy;
 }
@@ -423,10 +642,16 @@ BUF_size_t BUF_FillPattern(BUF_t* buffer, uint8_t pattern, BUF_size_t size)
   {
     memset(&buffer->data[buffer->write_index], (int) pattern, to_fill);
     buffer->write_index += to_fill;
+    buf_on_write(buffer, to_fill);
+    if (to_fill < size)
+    {
+      buf_on_write_failed(buffer);
+    }
   }
-  else
+  else if (size > 0)
   {
     to_fill = 0;
+    buf_on_write_failed(buffer);
   }
   return to_fill;
 }
@@ -460,36 +685,1496 @@ bool BUF_Compare(const BUF_t* buf, const uint8_t* data, BUF_size_t size)
   {
     equal = (memcmp(buf->data, data, size) == 0);
   }
+  buf_on_compare(buf);
   return equal;
 }
 
-// --- Private functions
+// --- Public functions, zero-copy
 
-/**
- * \brief Get minimum value
- * \param left Left value
- * \param right Right value
- * \return Minimum value
- */
-static BUF_size_t buf_Min(BUF_size_t left, BUF_size_t right)
+uint8_t* BUF_Reserve(BUF_t* buffer, BUF_size_t* size)
 {
-  return (left <= right) ? left : right;
+  uint8_t* reserved  = NULL;
+  BUF_size_t to_fill = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && (buffer->size > buffer->write_index))
+  {
+    reserved = &buffer->data[buffer->write_index];
+    to_fill  = (BUF_size_t) (buffer->size - buffer->write_index);
+  }
+  if (size != NULL)
+  {
+    *size = to_fill;
+  }
+  return reserved;
 }
 
-static bool
-buf_is_memory_overlapping(const void* dest, const void* src, size_t length)
+BUF_size_t BUF_Commit(BUF_t* buffer, BUF_size_t size)
 {
-  bool is_overlapping = false;
+  BUF_size_t committed = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (size > 0)
+      && ((BUF_size_t) (buffer->size - buffer->write_index) >= size))
+  {
+    buffer->write_index += size;
+    committed = size;
+    buf_on_write(buffer, size);
+  }
+  else if (size > 0)
+  {
+    buf_on_write_failed(buffer);
+  }
+  return committed;
+}
 
-  if ((dest != NULL) && (src != NULL))
+const uint8_t* BUF_Peek(const BUF_t* buffer, BUF_size_t* size)
+{
+  const uint8_t* peeked = NULL;
+  BUF_size_t to_read    = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && (buffer->write_index > buffer->read_index))
   {
-    uintptr_t dest_start = (uintptr_t) dest;
-    uintptr_t dest_end   = dest_start + length;
-    uintptr_t src_start  = (uintptr_t) src;
-    uintptr_t src_end    = src_start + length;
+    peeked  = &buffer->data[buffer->read_index];
+    to_read = (BUF_size_t) (buffer->write_index - buffer->read_index);
+  }
+  if (size != NULL)
+  {
+    *size = to_read;
+  }
+  return peeked;
+}
 
-    is_overlapping = ((dest_start >= src_start) && (dest_start < src_end))
-                     || ((src_start >= dest_start) && (src_start < dest_end));
+BUF_size_t BUF_Consume(BUF_t* buffer, BUF_size_t size)
+{
+  BUF_size_t consumed = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (size > 0)
+      && ((BUF_size_t) (buffer->write_index - buffer->read_index) >= size))
+  {
+    buffer->read_index += size;
+    consumed = size;
+    buf_on_read(buffer, size);
   }
-  return is_overlapping;
+  else if (size > 0)
+  {
+    buf_on_read_failed(buffer);
+  }
+  return consumed;
+}
+
+// --- Public functions, compaction
+
+BUF_size_t BUF_Compact(BUF_t* buffer)
+{
+  BUF_size_t reclaimed = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (buffer->read_index > 0))
+  {
+    BUF_size_t count = (BUF_size_t) (buffer->write_index - buffer->read_index);
+    if (count > 0)
+    {
+      memmove(buffer->data, &buffer->data[buffer->read_index], count);
+    }
+    reclaimed           = buffer->read_index;
+    buffer->read_index  = 0;
+    buffer->write_index = count;
+  }
+  return reclaimed;
+}
+
+BUF_size_t BUF_CompactIfNeeded(BUF_t* buffer, uint8_t threshold_percent)
+{
+  BUF_size_t reclaimed = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (buffer->read_index > 0)
+      && ((buffer->read_index == buffer->write_index)
+          || (((uint64_t) buffer->read_index * 100U)
+              >= ((uint64_t) buffer->size * threshold_percent))))
+  {
+    reclaimed = BUF_Compact(buffer);
+  }
+  return reclaimed;
+}
+
+// --- Public functions, search
+
+BUF_size_t BUF_FindByte(const BUF_t* buffer, uint8_t value)
+{
+  BUF_size_t index = BUF_INDEX_NONE;
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    size_t count  = BUF_GetToReadCount(buffer);
+    size_t offset = buf_find_byte(&buffer->data[buffer->read_index], count, value);
+    if (offset < count)
+    {
+      index = (BUF_size_t) (buffer->read_index + offset);
+    }
+  }
+  return index;
+}
+
+BUF_size_t
+BUF_FindAnyOf(const BUF_t* buffer, const uint8_t* set, uint8_t set_size)
+{
+  BUF_size_t index = BUF_INDEX_NONE;
+  if ((buffer != NULL) && (buffer->data != NULL) && (set != NULL)
+      && (set_size > 0) && (set_size <= BUF_FIND_SET_MAX))
+  {
+    size_t count  = BUF_GetToReadCount(buffer);
+    size_t offset = buf_find_any_of(&buffer->data[buffer->read_index],
+                                    count,
+                                    set,
+                                    set_size);
+    if (offset < count)
+    {
+      index = (BUF_size_t) (buffer->read_index + offset);
+    }
+  }
+  return index;
+}
+
+BUF_size_t BUF_FindPattern(const BUF_t* buffer,
+                           const uint8_t* pattern,
+                           BUF_size_t pattern_size)
+{
+  BUF_size_t index = BUF_INDEX_NONE;
+  if ((buffer != NULL) && (buffer->data != NULL) && (pattern != NULL)
+      && (pattern_size > 0))
+  {
+    size_t count  = BUF_GetToReadCount(buffer);
+    size_t offset = buf_find_pattern(&buffer->data[buffer->read_index],
+                                     count,
+                                     pattern,
+                                     pattern_size);
+    if (offset < count)
+    {
+      index = (BUF_size_t) (buffer->read_index + offset);
+    }
+  }
+  return index;
+}
+
+bool BUF_NextFrame(BUF_t* buffer,
+                   BUF_t* frame,
+                   const uint8_t* delimiter,
+                   BUF_size_t delimiter_size)
+{
+  bool is_found    = false;
+  BUF_size_t index = BUF_FindPattern(buffer, delimiter, delimiter_size);
+  if ((frame != NULL) && (index != BUF_INDEX_NONE))
+  {
+    BUF_size_t start = buffer->read_index;
+    BUF_MakeViewFull(frame, buffer, start, (BUF_size_t) (index - start));
+    buffer->read_index = (BUF_size_t) (index + delimiter_size);
+    buf_on_read(buffer, (BUF_size_t) (buffer->read_index - start));
+    is_found = true;
+  }
+  return is_found;
+}
+
+// --- Public functions, little-endian
+
+uint16_t BUF_GetUint16LE(const BUF_t* buffer, BUF_size_t index)
+{
+  uint16_t value = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && buf_is_in_bounds(buffer, index, 2U))
+  {
+    value = buf_load_le16(&buffer->data[index]);
+  }
+  return value;
+}
+
+uint32_t BUF_GetUint32LE(const BUF_t* buffer, BUF_size_t index)
+{
+  uint32_t value = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && buf_is_in_bounds(buffer, index, 4U))
+  {
+    value = buf_load_le32(&buffer->data[index]);
+  }
+  return value;
+}
+
+uint64_t BUF_GetUint64LE(const BUF_t* buffer, BUF_size_t index)
+{
+  uint64_t value = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && buf_is_in_bounds(buffer, index, 8U))
+  {
+    value = buf_load_le64(&buffer->data[index]);
+  }
+  return value;
+}
+
+uint8_t BUF_PutUint16LE(BUF_t* buffer, uint16_t data, BUF_size_t index)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && buf_is_in_bounds(buffer, index, 2U))
+  {
+    buf_store_le16(&buffer->data[index], data);
+    written = 2;
+  }
+  return written;
+}
+
+uint8_t BUF_PutUint32LE(BUF_t* buffer, uint32_t data, BUF_size_t index)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && buf_is_in_bounds(buffer, index, 4U))
+  {
+    buf_store_le32(&buffer->data[index], data);
+    written = 4;
+  }
+  return written;
+}
+
+uint8_t BUF_PutUint64LE(BUF_t* buffer, uint64_t data, BUF_size_t index)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && buf_is_in_bounds(buffer, index, 8U))
+  {
+    buf_store_le64(&buffer->data[index], data);
+    written = 8;
+  }
+  return written;
+}
+
+uint16_t BUF_ReadUint16LE(BUF_t* buffer)
+{
+  return BUF_InlineReadUint16LE(buffer);
+}
+
+uint32_t BUF_ReadUint32LE(BUF_t* buffer)
+{
+  return BUF_InlineReadUint32LE(buffer);
+}
+
+uint64_t BUF_ReadUint64LE(BUF_t* buffer)
+{
+  return BUF_InlineReadUint64LE(buffer);
+}
+
+uint8_t BUF_WriteUint16LE(BUF_t* buffer, uint16_t data)
+{
+  return BUF_InlineWriteUint16LE(buffer, data);
+}
+
+uint8_t BUF_WriteUint32LE(BUF_t* buffer, uint32_t data)
+{
+  return BUF_InlineWriteUint32LE(buffer, data);
+}
+
+uint8_t BUF_WriteUint64LE(BUF_t* buffer, uint64_t data)
+{
+  return BUF_InlineWriteUint64LE(buffer, data);
+}
+
+// --- Public functions, buffer byte order
+
+void BUF_SetEndian(BUF_t* buffer, BUF_Endian_t endian)
+{
+  if (buffer != NULL)
+  {
+    buffer->endian = (uint8_t) endian;
+  }
+}
+
+BUF_Endian_t BUF_GetEndian(const BUF_t* buffer)
+{
+  BUF_Endian_t endian = BUF_ENDIAN_BIG;
+  if ((buffer != NULL) && (buffer->endian == (uint8_t) BUF_ENDIAN_LITTLE))
+  {
+    endian = BUF_ENDIAN_LITTLE;
+  }
+  return endian;
+}
+
+uint16_t BUF_GetUint16Auto(const BUF_t* buffer, BUF_size_t index)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_GetUint16LE(buffer, index)
+           : BUF_GetUint16(buffer, index);
+}
+
+uint32_t BUF_GetUint32Auto(const BUF_t* buffer, BUF_size_t index)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_GetUint32LE(buffer, index)
+           : BUF_GetUint32(buffer, index);
+}
+
+uint64_t BUF_GetUint64Auto(const BUF_t* buffer, BUF_size_t index)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_GetUint64LE(buffer, index)
+           : BUF_GetUint64(buffer, index);
+}
+
+uint8_t BUF_PutUint16Auto(BUF_t* buffer, uint16_t data, BUF_size_t index)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_PutUint16LE(buffer, data, index)
+           : BUF_PutUint16(buffer, data, index);
+}
+
+uint8_t BUF_PutUint32Auto(BUF_t* buffer, uint32_t data, BUF_size_t index)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_PutUint32LE(buffer, data, index)
+           : BUF_PutUint32(buffer, data, index);
+}
+
+uint8_t BUF_PutUint64Auto(BUF_t* buffer, uint64_t data, BUF_size_t index)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_PutUint64LE(buffer, data, index)
+           : BUF_PutUint64(buffer, data, index);
+}
+
+uint16_t BUF_ReadUint16Auto(BUF_t* buffer)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_InlineReadUint16LE(buffer)
+           : BUF_InlineReadUint16(buffer);
+}
+
+uint32_t BUF_ReadUint32Auto(BUF_t* buffer)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_InlineReadUint32LE(buffer)
+           : BUF_InlineReadUint32(buffer);
+}
+
+uint64_t BUF_ReadUint64Auto(BUF_t* buffer)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_InlineReadUint64LE(buffer)
+           : BUF_InlineReadUint64(buffer);
+}
+
+uint8_t BUF_WriteUint16Auto(BUF_t* buffer, uint16_t data)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_InlineWriteUint16LE(buffer, data)
+           : BUF_InlineWriteUint16(buffer, data);
+}
+
+uint8_t BUF_WriteUint32Auto(BUF_t* buffer, uint32_t data)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_InlineWriteUint32LE(buffer, data)
+           : BUF_InlineWriteUint32(buffer, data);
+}
+
+uint8_t BUF_WriteUint64Auto(BUF_t* buffer, uint64_t data)
+{
+  return (BUF_GetEndian(buffer) == BUF_ENDIAN_LITTLE)
+           ? BUF_InlineWriteUint64LE(buffer, data)
+           : BUF_InlineWriteUint64(buffer, data);
+}
+
+// --- Public functions, floating point
+
+float BUF_GetFloat32(const BUF_t* buffer, BUF_size_t index)
+{
+  return buf_float32_from_bits(BUF_GetUint32(buffer, index));
+}
+
+double BUF_GetFloat64(const BUF_t* buffer, BUF_size_t index)
+{
+  return buf_float64_from_bits(BUF_GetUint64(buffer, index));
+}
+
+uint8_t BUF_PutFloat32(BUF_t* buffer, float data, BUF_size_t index)
+{
+  return BUF_PutUint32(buffer, buf_float32_to_bits(data), index);
+}
+
+uint8_t BUF_PutFloat64(BUF_t* buffer, double data, BUF_size_t index)
+{
+  return BUF_PutUint64(buffer, buf_float64_to_bits(data), index);
+}
+
+float BUF_ReadFloat32(BUF_t* buffer)
+{
+  return buf_float32_from_bits(BUF_InlineReadUint32(buffer));
+}
+
+double BUF_ReadFloat64(BUF_t* buffer)
+{
+  return buf_float64_from_bits(BUF_InlineReadUint64(buffer));
+}
+
+uint8_t BUF_WriteFloat32(BUF_t* buffer, float data)
+{
+  return BUF_InlineWriteUint32(buffer, buf_float32_to_bits(data));
+}
+
+uint8_t BUF_WriteFloat64(BUF_t* buffer, double data)
+{
+  return BUF_InlineWriteUint64(buffer, buf_float64_to_bits(data));
+}
+
+float BUF_GetFloat32LE(const BUF_t* buffer, BUF_size_t index)
+{
+  return buf_float32_from_bits(BUF_GetUint32LE(buffer, index));
+}
+
+double BUF_GetFloat64LE(const BUF_t* buffer, BUF_size_t index)
+{
+  return buf_float64_from_bits(BUF_GetUint64LE(buffer, index));
+}
+
+uint8_t BUF_PutFloat32LE(BUF_t* buffer, float data, BUF_size_t index)
+{
+  return BUF_PutUint32LE(buffer, buf_float32_to_bits(data), index);
+}
+
+uint8_t BUF_PutFloat64LE(BUF_t* buffer, double data, BUF_size_t index)
+{
+  return BUF_PutUint64LE(buffer, buf_float64_to_bits(data), index);
+}
+
+float BUF_ReadFloat32LE(BUF_t* buffer)
+{
+  return buf_float32_from_bits(BUF_InlineReadUint32LE(buffer));
+}
+
+double BUF_ReadFloat64LE(BUF_t* buffer)
+{
+  return buf_float64_from_bits(BUF_InlineReadUint64LE(buffer));
+}
+
+uint8_t BUF_WriteFloat32LE(BUF_t* buffer, float data)
+{
+  return BUF_InlineWriteUint32LE(buffer, buf_float32_to_bits(data));
+}
+
+uint8_t BUF_WriteFloat64LE(BUF_t* buffer, double data)
+{
+  return BUF_InlineWriteUint64LE(buffer, buf_float64_to_bits(data));
+}
+
+BUF_size_t BUF_ReadFloat32Array(BUF_t* buffer, float* data, BUF_size_t count)
+{
+  return buf_read_elements(buffer, data, count, 4U, BUF_ENDIAN_BIG);
+}
+
+BUF_size_t BUF_ReadFloat64Array(BUF_t* buffer, double* data, BUF_size_t count)
+{
+  return buf_read_elements(buffer, data, count, 8U, BUF_ENDIAN_BIG);
+}
+
+BUF_size_t
+BUF_WriteFloat32Array(BUF_t* buffer, const float* data, BUF_size_t count)
+{
+  return buf_write_elements(buffer, data, count, 4U, BUF_ENDIAN_BIG);
+}
+
+BUF_size_t
+BUF_WriteFloat64Array(BUF_t* buffer, const double* data, BUF_size_t count)
+{
+  return buf_write_elements(buffer, data, count, 8U, BUF_ENDIAN_BIG);
+}
+
+BUF_size_t BUF_ReadFloat32ArrayLE(BUF_t* buffer, float* data, BUF_size_t count)
+{
+  return buf_read_elements(buffer, data, count, 4U, BUF_ENDIAN_LITTLE);
+}
+
+BUF_size_t BUF_ReadFloat64ArrayLE(BUF_t* buffer, double* data, BUF_size_t count)
+{
+  return buf_read_elements(buffer, data, count, 8U, BUF_ENDIAN_LITTLE);
+}
+
+BUF_size_t
+BUF_WriteFloat32ArrayLE(BUF_t* buffer, const float* data, BUF_size_t count)
+{
+  return buf_write_elements(buffer, data, count, 4U, BUF_ENDIAN_LITTLE);
+}
+
+BUF_size_t
+BUF_WriteFloat64ArrayLE(BUF_t* buffer, const double* data, BUF_size_t count)
+{
+  return buf_write_elements(buffer, data, count, 8U, BUF_ENDIAN_LITTLE);
+}
+
+// --- Public functions, varint
+
+uint8_t BUF_WriteVarU32(BUF_t* buffer, uint32_t data)
+{
+  return buf_write_varint(buffer, data);
+}
+
+uint8_t BUF_WriteVarU64(BUF_t* buffer, uint64_t data)
+{
+  return buf_write_varint(buffer, data);
+}
+
+uint8_t BUF_WriteVarS32(BUF_t* buffer, int32_t data)
+{
+  return buf_write_varint(buffer, buf_zigzag_encode(data));
+}
+
+uint8_t BUF_WriteVarS64(BUF_t* buffer, int64_t data)
+{
+  return buf_write_varint(buffer, buf_zigzag_encode(data));
+}
+
+uint8_t BUF_ReadVarU32(BUF_t* buffer, uint32_t* data)
+{
+  uint64_t value = 0;
+  uint8_t read   = 0;
+  if (data != NULL)
+  {
+    read = buf_read_varint(buffer, 32U, &value);
+  }
+  if (read != 0)
+  {
+    *data = (uint32_t) value;
+  }
+  return read;
+}
+
+uint8_t BUF_ReadVarU64(BUF_t* buffer, uint64_t* data)
+{
+  uint8_t read = 0;
+  if (data != NULL)
+  {
+    read = buf_read_varint(buffer, 64U, data);
+  }
+  return read;
+}
+
+uint8_t BUF_ReadVarS32(BUF_t* buffer, int32_t* data)
+{
+  uint64_t value = 0;
+  uint8_t read   = 0;
+  if (data != NULL)
+  {
+    read = buf_read_varint(buffer, 32U, &value);
+  }
+  if (read != 0)
+  {
+    *data = (int32_t) buf_zigzag_decode(value);
+  }
+  return read;
+}
+
+uint8_t BUF_ReadVarS64(BUF_t* buffer, int64_t* data)
+{
+  uint64_t value = 0;
+  uint8_t read   = 0;
+  if (data != NULL)
+  {
+    read = buf_read_varint(buffer, 64U, &value);
+  }
+  if (read != 0)
+  {
+    *data = buf_zigzag_decode(value);
+  }
+  return read;
+}
+
+/**
+ * \details SIMD path first, scalar decoding for the tail and for what it
+ * leaves
+ */
+BUF_size_t BUF_ReadVarU32Array(BUF_t* buffer, uint32_t* data, BUF_size_t count)
+{
+  BUF_size_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL))
+  {
+    const uint8_t* src = &buffer->data[buffer->read_index];
+    size_t size        = BUF_GetToReadCount(buffer);
+    size_t consumed    = 0;
+    size_t i      = buf_varu32_decode_simd(data, count, src, size, &consumed);
+    uint8_t length = 1;
+
+    while ((i < count) && (length != 0))
+    {
+      uint64_t value = 0;
+      length = buf_varint_decode(&src[consumed], size - consumed, 32U, &value);
+      if (length != 0)
+      {
+        data[i] = (uint32_t) value;
+        consumed += length;
+        i++;
+      }
+    }
+    read = (BUF_size_t) i;
+    buffer->read_index += (BUF_size_t) consumed;
+    if (consumed > 0)
+    {
+      buf_on_read(buffer, (BUF_size_t) consumed);
+    }
+  }
+  if (read < count)
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+// --- Private functions
+
+/**
+ * \brief Get minimum value
+ * \param left Left value
+ * \param right Right value
+ * \return Minimum value
+ */
+static BUF_size_t buf_Min(BUF_size_t left, BUF_size_t right)
+{
+  return (left <= right) ? left : right;
+}
+
+/**
+ * \brief Check that [index, index + length) lies in buffer
+ * \param buffer Buffer to check, not NULL
+ * \param index Start index
+ * \param length Length from index
+ * \return true if in bounds, false otherwise
+ * \details Never computes index + length, so it cannot wrap whatever the
+ * width of BUF_size_t
+ */
+static bool
+buf_is_in_bounds(const BUF_t* buffer, BUF_size_t index, BUF_size_t length)
+{
+  return (length <= buffer->size) && (index <= (buffer->size - length));
+}
+
+static bool
+buf_is_memory_overlapping(const void* dest, const void* src, size_t length)
+{
+  bool is_overlapping = false;
+
+  if ((dest != NULL) && (src != NULL))
+  {
+    uintptr_t dest_start = (uintptr_t) dest;
+    uintptr_t dest_end   = dest_start + length;
+    uintptr_t src_start  = (uintptr_t) src;
+    uintptr_t src_end    = src_start + length;
+
+    is_overlapping = ((dest_start >= src_start) && (dest_start < src_end))
+                     || ((src_start >= dest_start) && (src_start < dest_end));
+  }
+  return is_overlapping;
+}
+
+/**
+ * \brief Reverse byte order of 2 bytes elements with SIMD shuffle
+ * \param dst Destination bytes
+ * \param src Source bytes
+ * \param count Element count
+ * \return Element count processed, remaining elements are left to the caller
+ * \details x86 only, hence little-endian host
+ */
+static size_t buf_swap16_simd(uint8_t* dst, const uint8_t* src, size_t count)
+{
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i mask256 = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                           9, 8, 11, 10, 13, 12, 15, 14,
+                                           1, 0, 3, 2, 5, 4, 7, 6,
+                                           9, 8, 11, 10, 13, 12, 15, 14);
+  for (; (i + 16U) <= count; i += 16U)
+  {
+    __m256i value = _mm256_loadu_si256((const __m256i*) &src[i * 2U]);
+    _mm256_storeu_si256((__m256i*) &dst[i * 2U],
+                        _mm256_shuffle_epi8(value, mask256));
+  }
+#endif
+#if defined(__SSSE3__)
+  const __m128i mask128 = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                        9, 8, 11, 10, 13, 12, 15, 14);
+  for (; (i + 8U) <= count; i += 8U)
+  {
+    __m128i value = _mm_loadu_si128((const __m128i*) &src[i * 2U]);
+    _mm_storeu_si128((__m128i*) &dst[i * 2U], _mm_shuffle_epi8(value, mask128));
+  }
+#else
+  (void) dst;
+  (void) src;
+  (void) count;
+#endif
+  return i;
+}
+
+/**
+ * \brief Reverse byte order of 4 bytes elements with SIMD shuffle
+ * \param dst Destination bytes
+ * \param src Source bytes
+ * \param count Element count
+ * \return Element count processed, remaining elements are left to the caller
+ * \details x86 only, hence little-endian host
+ */
+static size_t buf_swap32_simd(uint8_t* dst, const uint8_t* src, size_t count)
+{
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i mask256 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                           11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4,
+                                           11, 10, 9, 8, 15, 14, 13, 12);
+  for (; (i + 8U) <= count; i += 8U)
+  {
+    __m256i value = _mm256_loadu_si256((const __m256i*) &src[i * 4U]);
+    _mm256_storeu_si256((__m256i*) &dst[i * 4U],
+                        _mm256_shuffle_epi8(value, mask256));
+  }
+#endif
+#if defined(__SSSE3__)
+  const __m128i mask128 = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                        11, 10, 9, 8, 15, 14, 13, 12);
+  for (; (i + 4U) <= count; i += 4U)
+  {
+    __m128i value = _mm_loadu_si128((const __m128i*) &src[i * 4U]);
+    _mm_storeu_si128((__m128i*) &dst[i * 4U], _mm_shuffle_epi8(value, mask128));
+  }
+#else
+  (void) dst;
+  (void) src;
+  (void) count;
+#endif
+  return i;
+}
+
+/**
+ * \brief Store host 2 bytes elements as big-endian bytes
+ */
+static void buf_store_be16_array(uint8_t* dst, const uint16_t* src, size_t count)
+{
+  size_t i = buf_swap16_simd(dst, (const uint8_t*) src, count);
+  for (; i < count; i++)
+  {
+    buf_store_be16(&dst[i * 2U], src[i]);
+  }
+}
+
+/**
+ * \brief Store host 4 bytes elements as big-endian bytes
+ */
+static void buf_store_be32_array(uint8_t* dst, const uint32_t* src, size_t count)
+{
+  size_t i = buf_swap32_simd(dst, (const uint8_t*) src, count);
+  for (; i < count; i++)
+  {
+    buf_store_be32(&dst[i * 4U], src[i]);
+  }
+}
+
+/**
+ * \brief Load big-endian bytes as host 2 bytes elements
+ */
+static void buf_load_be16_array(uint16_t* dst, const uint8_t* src, size_t count)
+{
+  size_t i = buf_swap16_simd((uint8_t*) dst, src, count);
+  for (; i < count; i++)
+  {
+    dst[i] = buf_load_be16(&src[i * 2U]);
+  }
+}
+
+/**
+ * \brief Load big-endian bytes as host 4 bytes elements
+ */
+static void buf_load_be32_array(uint32_t* dst, const uint8_t* src, size_t count)
+{
+  size_t i = buf_swap32_simd((uint8_t*) dst, src, count);
+  for (; i < count; i++)
+  {
+    dst[i] = buf_load_be32(&src[i * 4U]);
+  }
+}
+
+/**
+ * \brief Reverse byte order of 8 bytes elements with SIMD shuffle
+ * \param dst Destination bytes
+ * \param src Source bytes
+ * \param count Element count
+ * \return Element count processed, remaining elements are left to the caller
+ * \details x86 only, hence little-endian host
+ */
+static size_t buf_swap64_simd(uint8_t* dst, const uint8_t* src, size_t count)
+{
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i mask256 = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0,
+                                           15, 14, 13, 12, 11, 10, 9, 8,
+                                           7, 6, 5, 4, 3, 2, 1, 0,
+                                           15, 14, 13, 12, 11, 10, 9, 8);
+  for (; (i + 4U) <= count; i += 4U)
+  {
+    __m256i value = _mm256_loadu_si256((const __m256i*) &src[i * 8U]);
+    _mm256_storeu_si256((__m256i*) &dst[i * 8U],
+                        _mm256_shuffle_epi8(value, mask256));
+  }
+#endif
+#if defined(__SSSE3__)
+  const __m128i mask128 = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0,
+                                        15, 14, 13, 12, 11, 10, 9, 8);
+  for (; (i + 2U) <= count; i += 2U)
+  {
+    __m128i value = _mm_loadu_si128((const __m128i*) &src[i * 8U]);
+    _mm_storeu_si128((__m128i*) &dst[i * 8U], _mm_shuffle_epi8(value, mask128));
+  }
+#else
+  (void) dst;
+  (void) src;
+  (void) count;
+#endif
+  return i;
+}
+
+/**
+ * \brief Convert 4 or 8 bytes elements between host order and endian
+ * \param dst Destination bytes
+ * \param src Source bytes
+ * \param count Element count
+ * \param width Element size, 4 or 8
+ * \param endian Byte order of buffer side
+ * \details Plain copy when endian is host order, byte reversal otherwise.
+ * Reversal is its own inverse, so the same conversion serves reads and
+ * writes
+ */
+static void buf_copy_elements(uint8_t* dst,
+                              const uint8_t* src,
+                              size_t count,
+                              uint8_t width,
+                              BUF_Endian_t endian)
+{
+#if defined(BUF_HOST_LITTLE_ENDIAN)
+  bool is_host_order = (endian == BUF_ENDIAN_LITTLE);
+#elif defined(BUF_HOST_BIG_ENDIAN)
+  bool is_host_order = (endian == BUF_ENDIAN_BIG);
+#else
+  bool is_host_order = false;
+#endif
+
+  if (is_host_order)
+  {
+    memcpy(dst, src, count * width);
+  }
+  else if (width == 4U)
+  {
+    size_t i = buf_swap32_simd(dst, src, count);
+    for (; i < count; i++)
+    {
+      uint32_t value = 0;
+      memcpy(&value, &src[i * 4U], sizeof(value));
+      if (endian == BUF_ENDIAN_LITTLE)
+      {
+        buf_store_le32(&dst[i * 4U], value);
+      }
+      else
+      {
+        buf_store_be32(&dst[i * 4U], value);
+      }
+    }
+  }
+  else
+  {
+    size_t i = buf_swap64_simd(dst, src, count);
+    for (; i < count; i++)
+    {
+      uint64_t value = 0;
+      memcpy(&value, &src[i * 8U], sizeof(value));
+      if (endian == BUF_ENDIAN_LITTLE)
+      {
+        buf_store_le64(&dst[i * 8U], value);
+      }
+      else
+      {
+        buf_store_be64(&dst[i * 8U], value);
+      }
+    }
+  }
+}
+
+/**
+ * \brief Consume count elements of width bytes, all or nothing
+ */
+static BUF_size_t buf_read_elements(BUF_t* buffer,
+                                    void* data,
+                                    BUF_size_t count,
+                                    uint8_t width,
+                                    BUF_Endian_t endian)
+{
+  BUF_size_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (count <= (BUF_GetToReadCount(buffer) / width)))
+  {
+    buf_copy_elements(
+      (uint8_t*) data, &buffer->data[buffer->read_index], count, width, endian);
+    read = (BUF_size_t) (count * width);
+    buffer->read_index += read;
+    buf_on_read(buffer, read);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Append count elements of width bytes, all or nothing
+ */
+static BUF_size_t buf_write_elements(BUF_t* buffer,
+                                     const void* data,
+                                     BUF_size_t count,
+                                     uint8_t width,
+                                     BUF_Endian_t endian)
+{
+  BUF_size_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL) && (data != NULL)
+      && (count > 0) && (count <= (BUF_GetFreeSize(buffer) / width)))
+  {
+    buf_copy_elements(&buffer->data[buffer->write_index],
+                      (const uint8_t*) data,
+                      count,
+                      width,
+                      endian);
+    written = (BUF_size_t) (count * width);
+    buffer->write_index += written;
+    buf_on_write(buffer, written);
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
+
+/**
+ * \brief Reinterpret bits as IEEE-754 single
+ */
+static float buf_float32_from_bits(uint32_t bits)
+{
+  float value = 0.0F;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * \brief Reinterpret IEEE-754 single as bits
+ */
+static uint32_t buf_float32_to_bits(float value)
+{
+  uint32_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/**
+ * \brief Reinterpret bits as IEEE-754 double
+ */
+static double buf_float64_from_bits(uint64_t bits)
+{
+  double value = 0.0;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * \brief Reinterpret IEEE-754 double as bits
+ */
+static uint64_t buf_float64_to_bits(double value)
+{
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/**
+ * \brief Get LEB128 encoded size
+ * \param value Value to encode
+ * \return Byte count, 1 to BUF_VARINT64_MAX_SIZE
+ */
+static uint8_t buf_varint_size(uint64_t value)
+{
+  uint8_t size = 1;
+  while (value >= 0x80U)
+  {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+/**
+ * \brief Encode value as LEB128
+ * \param dst Destination, buf_varint_size(value) bytes
+ * \param value Value to encode
+ * \return Byte count written
+ */
+static uint8_t buf_varint_encode(uint8_t* dst, uint64_t value)
+{
+  uint8_t length = 0;
+  while (value >= 0x80U)
+  {
+    dst[length] = (uint8_t) (value | 0x80U);
+    value >>= 7;
+    length++;
+  }
+  dst[length] = (uint8_t) value;
+  return (uint8_t) (length + 1U);
+}
+
+/**
+ * \brief Decode one LEB128 varint
+ * \param src Encoded bytes
+ * \param size Readable byte count
+ * \param bits Width of value, 32 or 64
+ * \param value Decoded value, untouched if error
+ * \return Byte count decoded, 0 if truncated or value wider than bits
+ */
+static uint8_t
+buf_varint_decode(const uint8_t* src, size_t size, uint8_t bits, uint64_t* value)
+{
+  uint8_t max_length = (uint8_t) ((bits + 6U) / 7U);
+  size_t limit       = (size < max_length) ? size : max_length;
+  uint64_t result    = 0;
+  uint8_t length     = 0;
+  uint8_t byte       = 0x80U;
+
+  while ((length < limit) && ((byte & 0x80U) != 0U))
+  {
+    byte = src[length];
+    result |= (uint64_t) (byte & 0x7FU) << (7U * length);
+    length++;
+  }
+  // Last byte ends the varint and holds no bit over the value width
+  if (((byte & 0x80U) == 0U)
+      && ((length < max_length)
+          || ((byte >> (bits - (7U * (max_length - 1U)))) == 0U)))
+  {
+    *value = result;
+  }
+  else
+  {
+    length = 0;
+  }
+  return length;
+}
+
+/**
+ * \brief Append LEB128 varint, all or nothing
+ */
+static uint8_t buf_write_varint(BUF_t* buffer, uint64_t value)
+{
+  uint8_t written = 0;
+  uint8_t size    = buf_varint_size(value);
+  if ((buffer != NULL) && (buffer->data != NULL)
+      && ((BUF_size_t) (buffer->size - buffer->write_index) >= size))
+  {
+    written = buf_varint_encode(&buffer->data[buffer->write_index], value);
+    buffer->write_index += written;
+    buf_on_write(buffer, written);
+  }
+  else
+  {
+    buf_on_write_failed(buffer);
+  }
+  return written;
+}
+
+/**
+ * \brief Consume LEB128 varint, read_index untouched if error
+ * \details 1 byte varints, the most frequent, are decoded here
+ */
+static uint8_t buf_read_varint(BUF_t* buffer, uint8_t bits, uint64_t* value)
+{
+  uint8_t read = 0;
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    const uint8_t* src = &buffer->data[buffer->read_index];
+    BUF_size_t size = (BUF_size_t) (buffer->write_index - buffer->read_index);
+    if ((size > 0) && (src[0] < 0x80U))
+    {
+      *value = src[0];
+      read   = 1;
+    }
+    else
+    {
+      read = buf_varint_decode(src, size, bits, value);
+    }
+  }
+  if (read != 0)
+  {
+    buffer->read_index += read;
+    buf_on_read(buffer, read);
+  }
+  else
+  {
+    buf_on_read_failed(buffer);
+  }
+  return read;
+}
+
+/**
+ * \brief Map signed to unsigned, 0, -1, 1, -2... to 0, 1, 2, 3...
+ * \details Same result as the 32 bits mapping for values in int32_t range
+ */
+static uint64_t buf_zigzag_encode(int64_t value)
+{
+  return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+
+/**
+ * \brief Inverse of buf_zigzag_encode
+ */
+static int64_t buf_zigzag_decode(uint64_t value)
+{
+  return (int64_t) ((value >> 1) ^ (~(value & 1U) + 1U));
+}
+
+#if defined(__SSE2__)
+/**
+ * \brief Gather 7 bits groups of up to 5 little-endian bytes
+ * \param word Encoded bytes, bytes after the varint cleared
+ * \return Decoded value
+ */
+static uint32_t buf_varint_fold(uint64_t word)
+{
+  uint64_t value = word & UINT64_C(0x7F7F7F7F7F7F7F7F);
+  value          = (value & UINT64_C(0x007F007F007F007F))
+          | ((value & UINT64_C(0x7F007F007F007F00)) >> 1);
+  value = (value & UINT64_C(0x00003FFF00003FFF))
+          | ((value & UINT64_C(0x3FFF00003FFF0000)) >> 2);
+  value = (value & UINT64_C(0x000000000FFFFFFF))
+          | ((value & UINT64_C(0x0FFFFFFF00000000)) >> 4);
+  return (uint32_t) value;
+}
+#endif
+
+/**
+ * \brief Decode LEB128 varints 16 bytes at a time with SSE2
+ * \param dst Decoded values
+ * \param count Max value count
+ * \param src Encoded bytes
+ * \param size Readable byte count
+ * \param consumed Byte count decoded
+ * \return Value count decoded, remaining values are left to the caller
+ * \details movemask gives the continuation bits of 16 bytes. When all are
+ * clear, the 16 bytes are 16 values and are widened at once. Otherwise the
+ * varints starting in the first 8 bytes are decoded, length from the end
+ * mask, value from one 8 bytes load. Stops on a varint over 32 bits or
+ * longer than 5 bytes, for the caller to report. x86 only, hence
+ * little-endian host
+ */
+static size_t buf_varu32_decode_simd(uint32_t* dst,
+                                     size_t count,
+                                     const uint8_t* src,
+                                     size_t size,
+                                     size_t* consumed)
+{
+  size_t i   = 0;
+  size_t pos = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  bool is_done       = false;
+
+  while (!is_done && ((size - pos) >= 16U) && (i < count))
+  {
+    __m128i bytes = _mm_loadu_si128((const __m128i*) &src[pos]);
+    uint32_t ends = ~(uint32_t) _mm_movemask_epi8(bytes) & 0xFFFFU;
+
+    if ((ends == 0xFFFFU) && ((count - i) >= 16U))
+    {
+      __m128i low  = _mm_unpacklo_epi8(bytes, zero);
+      __m128i high = _mm_unpackhi_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i*) &dst[i], _mm_unpacklo_epi16(low, zero));
+      _mm_storeu_si128((__m128i*) &dst[i + 4U], _mm_unpackhi_epi16(low, zero));
+      _mm_storeu_si128((__m128i*) &dst[i + 8U], _mm_unpacklo_epi16(high, zero));
+      _mm_storeu_si128((__m128i*) &dst[i + 12U],
+                       _mm_unpackhi_epi16(high, zero));
+      i += 16U;
+      pos += 16U;
+    }
+    else
+    {
+      uint32_t offset = 0;
+      while (!is_done && (offset < 8U) && (i < count))
+      {
+        uint32_t end_mask = ends >> offset;
+        uint32_t length   = (uint32_t) __builtin_ctz(end_mask | 0x10000U) + 1U;
+        uint64_t word     = 0;
+        memcpy(&word, &src[pos + offset], sizeof(word));
+        if (length <= BUF_VARINT32_MAX_SIZE)
+        {
+          word &= (UINT64_C(1) << (length * 8U)) - 1U;
+        }
+        if ((length > BUF_VARINT32_MAX_SIZE) || ((word >> 32) > 0x0FU))
+        {
+          is_done = true;
+        }
+        else
+        {
+          dst[i] = buf_varint_fold(word);
+          offset += length;
+          i++;
+        }
+      }
+      pos += offset;
+    }
+  }
+#else
+  (void) dst;
+  (void) count;
+  (void) src;
+  (void) size;
+#endif
+  *consumed = pos;
+  return i;
+}
+
+/**
+ * \brief Find byte, 4 compares ORed before one movemask test
+ * \param src Bytes to search
+ * \param size Byte count
+ * \param value Byte to find
+ * \return Offset of byte, size if not found
+ * \details 128 bytes per test with AVX2, 64 with SSE2, the hit position is
+ * only computed in the block holding it
+ */
+static size_t buf_find_byte(const uint8_t* src, size_t size, uint8_t value)
+{
+  size_t found = size;
+  size_t i     = 0;
+#if defined(__AVX2__)
+  const __m256i needle256 = _mm256_set1_epi8((char) value);
+  for (; (found == size) && ((i + 128U) <= size); i += 128U)
+  {
+    __m256i match0 = _mm256_cmpeq_epi8(
+      _mm256_loadu_si256((const __m256i*) &src[i]), needle256);
+    __m256i match1 = _mm256_cmpeq_epi8(
+      _mm256_loadu_si256((const __m256i*) &src[i + 32U]), needle256);
+    __m256i match2 = _mm256_cmpeq_epi8(
+      _mm256_loadu_si256((const __m256i*) &src[i + 64U]), needle256);
+    __m256i match3 = _mm256_cmpeq_epi8(
+      _mm256_loadu_si256((const __m256i*) &src[i + 96U]), needle256);
+    __m256i any = _mm256_or_si256(_mm256_or_si256(match0, match1),
+                                  _mm256_or_si256(match2, match3));
+    if (_mm256_movemask_epi8(any) != 0)
+    {
+      uint64_t low = (uint32_t) _mm256_movemask_epi8(match0)
+                     | ((uint64_t) (uint32_t) _mm256_movemask_epi8(match1)
+                        << 32U);
+      uint64_t high = (uint32_t) _mm256_movemask_epi8(match2)
+                      | ((uint64_t) (uint32_t) _mm256_movemask_epi8(match3)
+                         << 32U);
+      found = (low != 0U) ? (i + (size_t) __builtin_ctzll(low))
+                          : (i + 64U + (size_t) __builtin_ctzll(high));
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i needle128 = _mm_set1_epi8((char) value);
+  for (; (found == size) && ((i + 64U) <= size); i += 64U)
+  {
+    __m128i match0 =
+      _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) &src[i]), needle128);
+    __m128i match1 = _mm_cmpeq_epi8(
+      _mm_loadu_si128((const __m128i*) &src[i + 16U]), needle128);
+    __m128i match2 = _mm_cmpeq_epi8(
+      _mm_loadu_si128((const __m128i*) &src[i + 32U]), needle128);
+    __m128i match3 = _mm_cmpeq_epi8(
+      _mm_loadu_si128((const __m128i*) &src[i + 48U]), needle128);
+    __m128i any = _mm_or_si128(_mm_or_si128(match0, match1),
+                               _mm_or_si128(match2, match3));
+    if (_mm_movemask_epi8(any) != 0)
+    {
+      uint64_t mask = (uint64_t) (uint32_t) _mm_movemask_epi8(match0)
+                      | ((uint64_t) (uint32_t) _mm_movemask_epi8(match1) << 16U)
+                      | ((uint64_t) (uint32_t) _mm_movemask_epi8(match2) << 32U)
+                      | ((uint64_t) (uint32_t) _mm_movemask_epi8(match3) << 48U);
+      found = i + (size_t) __builtin_ctzll(mask);
+    }
+  }
+  for (; (found == size) && ((i + 16U) <= size); i += 16U)
+  {
+    __m128i bytes = _mm_loadu_si128((const __m128i*) &src[i]);
+    uint32_t mask = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, needle128));
+    if (mask != 0U)
+    {
+      found = i + (size_t) __builtin_ctz(mask);
+    }
+  }
+#endif
+  if ((found == size) && (i < size))
+  {
+    const uint8_t* hit = memchr(&src[i], value, size - i);
+    if (hit != NULL)
+    {
+      found = (size_t) (hit - src);
+    }
+  }
+  return found;
+}
+
+/**
+ * \brief Find byte of set, one compare per set byte ORed before movemask
+ * \param src Bytes to search
+ * \param size Byte count
+ * \param set Bytes to find
+ * \param set_size Byte count of set, 1 to BUF_FIND_SET_MAX
+ * \return Offset of byte, size if not found
+ * \details Set is padded with its first byte to BUF_FIND_SET_MAX, the 8
+ * compares are written out so that needles stay in registers
+ */
+static size_t buf_find_any_of(const uint8_t* src,
+                              size_t size,
+                              const uint8_t* set,
+                              size_t set_size)
+{
+  size_t found = size;
+  size_t i     = 0;
+#if defined(__SSE2__)
+  uint8_t padded[BUF_FIND_SET_MAX];
+  for (size_t k = 0; k < BUF_FIND_SET_MAX; k++)
+  {
+    padded[k] = (k < set_size) ? set[k] : set[0];
+  }
+#endif
+#if defined(__AVX2__)
+  __m256i needles256[BUF_FIND_SET_MAX];
+  for (size_t k = 0; k < BUF_FIND_SET_MAX; k++)
+  {
+    needles256[k] = _mm256_set1_epi8((char) padded[k]);
+  }
+  for (; (found == size) && ((i + 32U) <= size); i += 32U)
+  {
+    __m256i bytes = _mm256_loadu_si256((const __m256i*) &src[i]);
+    __m256i match = _mm256_or_si256(
+      _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, needles256[0]),
+                        _mm256_cmpeq_epi8(bytes, needles256[1])),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, needles256[2]),
+                        _mm256_cmpeq_epi8(bytes, needles256[3]))),
+      _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, needles256[4]),
+                        _mm256_cmpeq_epi8(bytes, needles256[5])),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, needles256[6]),
+                        _mm256_cmpeq_epi8(bytes, needles256[7]))));
+    uint32_t mask = (uint32_t) _mm256_movemask_epi8(match);
+    if (mask != 0U)
+    {
+      found = i + (size_t) __builtin_ctz(mask);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  __m128i needles128[BUF_FIND_SET_MAX];
+  for (size_t k = 0; k < BUF_FIND_SET_MAX; k++)
+  {
+    needles128[k] = _mm_set1_epi8((char) padded[k]);
+  }
+  for (; (found == size) && ((i + 16U) <= size); i += 16U)
+  {
+    __m128i bytes = _mm_loadu_si128((const __m128i*) &src[i]);
+    __m128i match = _mm_or_si128(
+      _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, needles128[0]),
+                                _mm_cmpeq_epi8(bytes, needles128[1])),
+                   _mm_or_si128(_mm_cmpeq_epi8(bytes, needles128[2]),
+                                _mm_cmpeq_epi8(bytes, needles128[3]))),
+      _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, needles128[4]),
+                                _mm_cmpeq_epi8(bytes, needles128[5])),
+                   _mm_or_si128(_mm_cmpeq_epi8(bytes, needles128[6]),
+                                _mm_cmpeq_epi8(bytes, needles128[7]))));
+    uint32_t mask = (uint32_t) _mm_movemask_epi8(match);
+    if (mask != 0U)
+    {
+      found = i + (size_t) __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; (found == size) && (i < size); i++)
+  {
+    for (size_t k = 0; k < set_size; k++)
+    {
+      if (src[i] == set[k])
+      {
+        found = i;
+      }
+    }
+  }
+  return found;
+}
+
+/**
+ * \brief Find pattern, candidates from first and last pattern bytes
+ * \param src Bytes to search
+ * \param size Byte count
+ * \param pattern Bytes to find
+ * \param pattern_size Byte count of pattern, not 0
+ * \return Offset of pattern start, size if not found
+ * \details Positions where both first and last bytes match are found 32 or
+ * 16 at a time, then checked with memcmp. Rare false candidates keep the
+ * cost close to buf_find_byte
+ */
+static size_t buf_find_pattern(const uint8_t* src,
+                               size_t size,
+                               const uint8_t* pattern,
+                               size_t pattern_size)
+{
+  size_t found = size;
+  size_t i     = 0;
+  size_t last  = pattern_size - 1U;
+
+  if (pattern_size == 1U)
+  {
+    found = buf_find_byte(src, size, pattern[0]);
+  }
+  else
+  {
+#if defined(__AVX2__)
+    const __m256i first256 = _mm256_set1_epi8((char) pattern[0]);
+    const __m256i last256  = _mm256_set1_epi8((char) pattern[last]);
+    for (; (found == size) && ((i + last + 32U) <= size); i += 32U)
+    {
+      __m256i head  = _mm256_loadu_si256((const __m256i*) &src[i]);
+      __m256i tail  = _mm256_loadu_si256((const __m256i*) &src[i + last]);
+      uint32_t mask = (uint32_t) _mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(head, first256),
+                         _mm256_cmpeq_epi8(tail, last256)));
+      for (; (found == size) && (mask != 0U); mask &= mask - 1U)
+      {
+        size_t candidate = i + (size_t) __builtin_ctz(mask);
+        if (memcmp(&src[candidate], pattern, pattern_size) == 0)
+        {
+          found = candidate;
+        }
+      }
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i first128 = _mm_set1_epi8((char) pattern[0]);
+    const __m128i last128  = _mm_set1_epi8((char) pattern[last]);
+    for (; (found == size) && ((i + last + 16U) <= size); i += 16U)
+    {
+      __m128i head  = _mm_loadu_si128((const __m128i*) &src[i]);
+      __m128i tail  = _mm_loadu_si128((const __m128i*) &src[i + last]);
+      uint32_t mask = (uint32_t) _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(head, first128),
+                      _mm_cmpeq_epi8(tail, last128)));
+      for (; (found == size) && (mask != 0U); mask &= mask - 1U)
+      {
+        size_t candidate = i + (size_t) __builtin_ctz(mask);
+        if (memcmp(&src[candidate], pattern, pattern_size) == 0)
+        {
+          found = candidate;
+        }
+      }
+    }
+#endif
+    for (; (found == size) && ((i + last) < size); i++)
+    {
+      if ((src[i] == pattern[0]) && (memcmp(&src[i], pattern, pattern_size) == 0))
+      {
+        found = i;
+      }
+    }
+  }
+  return found;
 }
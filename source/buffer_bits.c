@@ -0,0 +1,34 @@
+/**
+ * \file buffer_bits.c
+ * \brief Buffer for MCU, bit-granular reader and writer
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <string.h>
+
+#include "buffer/buffer_bits.h"
+#include "buffer/buffer_inline.h"
+
+// --- Public functions
+
+uint64_t BUF_BitReaderLoadTail(const BUF_t* buffer, uint8_t order)
+{
+  uint8_t tail[8] = {0};
+  uint64_t word   = 0;
+
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    BUF_size_t to_read =
+      (BUF_size_t) (buffer->write_index - buffer->read_index);
+    if (to_read > sizeof(tail))
+    {
+      to_read = (BUF_size_t) sizeof(tail);
+    }
+    memcpy(tail, &buffer->data[buffer->read_index], to_read);
+    word = (order == (uint8_t) BUF_BIT_MSB_FIRST) ? buf_load_be64(tail)
+                                                  : buf_load_le64(tail);
+  }
+
+  return word;
+}
@@ -0,0 +1,214 @@
+/**
+ * \file buffer_chain.c
+ * \brief Buffer for MCU, scatter-gather chain of buffers
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "buffer/buffer_chain.h"
+#include "buffer/buffer_inline.h"
+
+// --- Private function
+
+static BUF_t* buf_chain_first_to_read(const BUF_Chain_t* chain);
+
+// --- Public functions
+
+void BUF_ChainInit(BUF_Chain_t* chain, BUF_t** segments, size_t capacity)
+{
+  if (chain != NULL)
+  {
+    chain->segments = segments;
+    chain->capacity = (segments != NULL) ? capacity : 0;
+    chain->count    = 0;
+  }
+}
+
+void BUF_ChainReset(BUF_Chain_t* chain)
+{
+  if (chain != NULL)
+  {
+    chain->count = 0;
+  }
+}
+
+bool BUF_ChainAppend(BUF_Chain_t* chain, BUF_t* segment)
+{
+  bool appended = false;
+  if ((chain != NULL) && (segment != NULL) && (chain->count < chain->capacity))
+  {
+    chain->segments[chain->count] = segment;
+    chain->count++;
+    appended = true;
+  }
+  return appended;
+}
+
+size_t BUF_ChainGetSegmentCount(const BUF_Chain_t* chain)
+{
+  size_t count = 0;
+  if (chain != NULL)
+  {
+    count = chain->count;
+  }
+  return count;
+}
+
+size_t BUF_ChainGetToReadCount(const BUF_Chain_t* chain)
+{
+  size_t to_read_count = 0;
+  if (chain != NULL)
+  {
+    for (size_t i = 0; i < chain->count; i++)
+    {
+      to_read_count += BUF_GetToReadCount(chain->segments[i]);
+    }
+  }
+  return to_read_count;
+}
+
+uint8_t BUF_ChainReadUint8(BUF_Chain_t* chain)
+{
+  return BUF_InlineReadUint8(buf_chain_first_to_read(chain));
+}
+
+/**
+ * \details Single load when the value lies in one segment
+ */
+uint16_t BUF_ChainReadUint16(BUF_Chain_t* chain)
+{
+  uint16_t read  = 0;
+  BUF_t* segment = buf_chain_first_to_read(chain);
+  uint8_t bytes[2];
+
+  if (BUF_GetToReadCount(segment) >= sizeof(bytes))
+  {
+    read = BUF_InlineReadUint16(segment);
+  }
+  else if (BUF_ChainReadRaw(chain, bytes, sizeof(bytes)) == sizeof(bytes))
+  {
+    read = buf_load_be16(bytes);
+  }
+  return read;
+}
+
+/**
+ * \details Single load when the value lies in one segment
+ */
+uint32_t BUF_ChainReadUint32(BUF_Chain_t* chain)
+{
+  uint32_t read  = 0;
+  BUF_t* segment = buf_chain_first_to_read(chain);
+  uint8_t bytes[4];
+
+  if (BUF_GetToReadCount(segment) >= sizeof(bytes))
+  {
+    read = BUF_InlineReadUint32(segment);
+  }
+  else if (BUF_ChainReadRaw(chain, bytes, sizeof(bytes)) == sizeof(bytes))
+  {
+    read = buf_load_be32(bytes);
+  }
+  return read;
+}
+
+size_t BUF_ChainReadRaw(BUF_Chain_t* chain, uint8_t* data, size_t size)
+{
+  size_t read = 0;
+  if ((chain != NULL) && (data != NULL) && (size > 0)
+      && (BUF_ChainGetToReadCount(chain) >= size))
+  {
+    for (size_t i = 0; (i < chain->count) && (read < size); i++)
+    {
+      BUF_t* segment = chain->segments[i];
+      size_t to_copy = BUF_GetToReadCount(segment);
+
+      if (to_copy > (size - read))
+      {
+        to_copy = size - read;
+      }
+      if (to_copy > 0)
+      {
+        memcpy(&data[read], &segment->data[segment->read_index], to_copy);
+        segment->read_index += (BUF_size_t) to_copy;
+        read += to_copy;
+      }
+    }
+  }
+  return read;
+}
+
+size_t BUF_ChainConsume(BUF_Chain_t* chain, size_t size)
+{
+  size_t consumed = 0;
+  if (chain != NULL)
+  {
+    for (size_t i = 0; (i < chain->count) && (consumed < size); i++)
+    {
+      BUF_t* segment    = chain->segments[i];
+      size_t to_consume = BUF_GetToReadCount(segment);
+
+      if (to_consume > (size - consumed))
+      {
+        to_consume = size - consumed;
+      }
+      if (to_consume > 0)
+      {
+        segment->read_index += (BUF_size_t) to_consume;
+        consumed += to_consume;
+      }
+    }
+  }
+  return consumed;
+}
+
+#if defined(BUF_CHAIN_HAS_IOVEC)
+size_t BUF_ChainExportIovec(const BUF_Chain_t* chain,
+                            struct iovec* iov,
+                            size_t iov_count)
+{
+  size_t filled = 0;
+  if ((chain != NULL) && (iov != NULL))
+  {
+    for (size_t i = 0; (i < chain->count) && (filled < iov_count); i++)
+    {
+      const BUF_t* segment = chain->segments[i];
+      BUF_size_t to_read   = BUF_GetToReadCount(segment);
+
+      if ((to_read > 0) && (segment->data != NULL))
+      {
+        iov[filled].iov_base = &segment->data[segment->read_index];
+        iov[filled].iov_len  = to_read;
+        filled++;
+      }
+    }
+  }
+  return filled;
+}
+#endif
+
+// --- Private functions
+
+/**
+ * \brief Get first segment with data left to read
+ * \param chain Chain to check
+ * \return Segment, NULL if none
+ */
+static BUF_t* buf_chain_first_to_read(const BUF_Chain_t* chain)
+{
+  BUF_t* segment = NULL;
+  if (chain != NULL)
+  {
+    for (size_t i = 0; (i < chain->count) && (segment == NULL); i++)
+    {
+      if (BUF_GetToReadCount(chain->segments[i]) > 0)
+      {
+        segment = chain->segments[i];
+      }
+    }
+  }
+  return segment;
+}
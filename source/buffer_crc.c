@@ -0,0 +1,379 @@
+/**
+ * \file buffer_crc.c
+ * \brief Buffer for MCU, CRC over buffer regions
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "buffer/buffer_crc.h"
+#include "buffer/buffer_inline.h"
+#include "buffer_crc_table.h"
+
+#if defined(__SSE4_2__) || (defined(__PCLMUL__) && defined(__SSE4_1__))
+#include <immintrin.h>
+#endif
+
+// --- Private define
+
+/**
+ * \brief Minimum size worth the PCLMULQDQ folding setup
+ */
+#define BUF_CRC_FOLD_MIN_SIZE 64U
+
+// --- Private function
+
+static bool buf_crc_is_range_valid(const BUF_t* buffer,
+                                   BUF_size_t index,
+                                   BUF_size_t size);
+static uint16_t buf_crc16_slice8(uint16_t crc, const uint8_t* data, size_t size);
+static uint32_t buf_crc32_slice8(uint32_t state,
+                                 const uint32_t table[8][256],
+                                 const uint8_t* data,
+                                 size_t size);
+#if defined(__SSE4_2__)
+static uint32_t buf_crc32c_sse42(uint32_t state, const uint8_t* data, size_t size);
+#endif
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+static uint32_t buf_crc32_pclmul(uint32_t state, const uint8_t* data, size_t size);
+#endif
+
+// --- Public functions
+
+uint16_t BUF_Crc16CcittUpdate(uint16_t crc, const uint8_t* data, size_t size)
+{
+  if (data != NULL)
+  {
+    crc = buf_crc16_slice8(crc, data, size);
+  }
+  return crc;
+}
+
+/**
+ * \details crc is the final value of the previous call, state is inverted
+ */
+uint32_t BUF_Crc32Update(uint32_t crc, const uint8_t* data, size_t size)
+{
+  uint32_t state = ~crc;
+  if (data != NULL)
+  {
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+    if (size >= BUF_CRC_FOLD_MIN_SIZE)
+    {
+      size_t folded = size & ~(size_t) 15U;
+      state         = buf_crc32_pclmul(state, data, folded);
+      data          = &data[folded];
+      size -= folded;
+    }
+#endif
+    state = buf_crc32_slice8(state, buf_crc32_table, data, size);
+  }
+  return ~state;
+}
+
+/**
+ * \details crc is the final value of the previous call, state is inverted
+ */
+uint32_t BUF_Crc32cUpdate(uint32_t crc, const uint8_t* data, size_t size)
+{
+  uint32_t state = ~crc;
+  if (data != NULL)
+  {
+#if defined(__SSE4_2__)
+    state = buf_crc32c_sse42(state, data, size);
+#else
+    state = buf_crc32_slice8(state, buf_crc32c_table, data, size);
+#endif
+  }
+  return ~state;
+}
+
+uint16_t BUF_Crc16Ccitt(const BUF_t* buffer)
+{
+  return BUF_Crc16CcittRange(buffer,
+                             BUF_GetReadIndex(buffer),
+                             BUF_GetToReadCount(buffer));
+}
+
+uint16_t BUF_Crc16CcittRange(const BUF_t* buffer, BUF_size_t index, BUF_size_t size)
+{
+  uint16_t crc = 0;
+  if (buf_crc_is_range_valid(buffer, index, size))
+  {
+    crc = BUF_Crc16CcittUpdate(BUF_CRC16_CCITT_INIT, &buffer->data[index], size);
+  }
+  return crc;
+}
+
+uint32_t BUF_Crc32(const BUF_t* buffer)
+{
+  return BUF_Crc32Range(buffer,
+                        BUF_GetReadIndex(buffer),
+                        BUF_GetToReadCount(buffer));
+}
+
+uint32_t BUF_Crc32Range(const BUF_t* buffer, BUF_size_t index, BUF_size_t size)
+{
+  uint32_t crc = 0;
+  if (buf_crc_is_range_valid(buffer, index, size))
+  {
+    crc = BUF_Crc32Update(BUF_CRC32_INIT, &buffer->data[index], size);
+  }
+  return crc;
+}
+
+uint32_t BUF_Crc32c(const BUF_t* buffer)
+{
+  return BUF_Crc32cRange(buffer,
+                         BUF_GetReadIndex(buffer),
+                         BUF_GetToReadCount(buffer));
+}
+
+uint32_t BUF_Crc32cRange(const BUF_t* buffer, BUF_size_t index, BUF_size_t size)
+{
+  uint32_t crc = 0;
+  if (buf_crc_is_range_valid(buffer, index, size))
+  {
+    crc = BUF_Crc32cUpdate(BUF_CRC32_INIT, &buffer->data[index], size);
+  }
+  return crc;
+}
+
+uint8_t BUF_WriteCrc16Ccitt(BUF_t* buffer)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    written = BUF_WriteUint16Auto(buffer, BUF_Crc16Ccitt(buffer));
+  }
+  return written;
+}
+
+uint8_t BUF_WriteCrc32(BUF_t* buffer)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    written = BUF_WriteUint32Auto(buffer, BUF_Crc32(buffer));
+  }
+  return written;
+}
+
+uint8_t BUF_WriteCrc32c(BUF_t* buffer)
+{
+  uint8_t written = 0;
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    written = BUF_WriteUint32Auto(buffer, BUF_Crc32c(buffer));
+  }
+  return written;
+}
+
+// --- Private functions
+
+/**
+ * \brief Check that [index, index + size) lies in buffer
+ * \param buffer Buffer to check
+ * \param index Start index
+ * \param size Range size
+ * \return true if valid, false otherwise
+ */
+static bool buf_crc_is_range_valid(const BUF_t* buffer,
+                                   BUF_size_t index,
+                                   BUF_size_t size)
+{
+  return (buffer != NULL) && (buffer->data != NULL) && (size <= buffer->size)
+         && (index <= (buffer->size - size));
+}
+
+/**
+ * \brief CRC-16/CCITT slicing-by-8, MSB first
+ * \param crc Current CRC
+ * \param data Data
+ * \param size Data size
+ * \return Updated CRC
+ */
+static uint16_t buf_crc16_slice8(uint16_t crc, const uint8_t* data, size_t size)
+{
+  const uint16_t(*table)[256] = buf_crc16_ccitt_table;
+
+  while (size >= 8U)
+  {
+    crc = table[7][data[0] ^ (crc >> 8U)] ^ table[6][data[1] ^ (crc & 0xFFU)]
+          ^ table[5][data[2]] ^ table[4][data[3]] ^ table[3][data[4]]
+          ^ table[2][data[5]] ^ table[1][data[6]] ^ table[0][data[7]];
+    data = &data[8];
+    size -= 8U;
+  }
+  while (size > 0)
+  {
+    crc  = (uint16_t) ((crc << 8U) ^ table[0][(crc >> 8U) ^ *data]);
+    data = &data[1];
+    size--;
+  }
+  return crc;
+}
+
+/**
+ * \brief Reflected CRC-32 slicing-by-8, LSB first
+ * \param state Current inverted CRC
+ * \param table Slicing-by-8 table of the polynomial
+ * \param data Data
+ * \param size Data size
+ * \return Updated inverted CRC
+ */
+static uint32_t buf_crc32_slice8(uint32_t state,
+                                 const uint32_t table[8][256],
+                                 const uint8_t* data,
+                                 size_t size)
+{
+  while (size >= 8U)
+  {
+    uint32_t low  = buf_load_le32(data) ^ state;
+    uint32_t high = buf_load_le32(&data[4]);
+
+    state = table[7][low & 0xFFU] ^ table[6][(low >> 8U) & 0xFFU]
+            ^ table[5][(low >> 16U) & 0xFFU] ^ table[4][low >> 24U]
+            ^ table[3][high & 0xFFU] ^ table[2][(high >> 8U) & 0xFFU]
+            ^ table[1][(high >> 16U) & 0xFFU] ^ table[0][high >> 24U];
+    data = &data[8];
+    size -= 8U;
+  }
+  while (size > 0)
+  {
+    state = (state >> 8U) ^ table[0][(state ^ *data) & 0xFFU];
+    data  = &data[1];
+    size--;
+  }
+  return state;
+}
+
+#if defined(__SSE4_2__)
+/**
+ * \brief CRC-32C with SSE4.2 crc32 instruction
+ * \param state Current inverted CRC
+ * \param data Data
+ * \param size Data size
+ * \return Updated inverted CRC
+ */
+static uint32_t buf_crc32c_sse42(uint32_t state, const uint8_t* data, size_t size)
+{
+#if defined(__x86_64__)
+  uint64_t state64 = state;
+  while (size >= 8U)
+  {
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    state64 = _mm_crc32_u64(state64, value);
+    data    = &data[8];
+    size -= 8U;
+  }
+  state = (uint32_t) state64;
+#endif
+  while (size >= 4U)
+  {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    state = _mm_crc32_u32(state, value);
+    data  = &data[4];
+    size -= 4U;
+  }
+  while (size > 0)
+  {
+    state = _mm_crc32_u8(state, *data);
+    data  = &data[1];
+    size--;
+  }
+  return state;
+}
+#endif
+
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+/**
+ * \brief CRC-32 with PCLMULQDQ folding
+ * \param state Current inverted CRC
+ * \param data Data
+ * \param size Data size, at least 64 and multiple of 16
+ * \return Updated inverted CRC
+ * \details Fold by 4 x 128 bits, then by 128 bits, then Barrett reduction.
+ * Constants are the bit-reflected ones of Intel "Fast CRC Computation for
+ * Generic Polynomials Using PCLMULQDQ Instruction".
+ */
+static uint32_t buf_crc32_pclmul(uint32_t state, const uint8_t* data, size_t size)
+{
+  const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+  const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163CD6124);
+  const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+  const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  __m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+  x1 = _mm_loadu_si128((const __m128i*) &data[0x00]);
+  x2 = _mm_loadu_si128((const __m128i*) &data[0x10]);
+  x3 = _mm_loadu_si128((const __m128i*) &data[0x20]);
+  x4 = _mm_loadu_si128((const __m128i*) &data[0x30]);
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) state));
+  data = &data[64];
+  size -= 64U;
+
+  // Fold 4 x 128 bits in parallel
+  while (size >= 64U)
+  {
+    x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*) &data[0x00]));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*) &data[0x10]));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*) &data[0x20]));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*) &data[0x30]));
+    data = &data[64];
+    size -= 64U;
+  }
+
+  // Fold into 128 bits
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // Fold remaining 128 bits blocks
+  while (size >= 16U)
+  {
+    x2 = _mm_loadu_si128((const __m128i*) data);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    data = &data[16];
+    size -= 16U;
+  }
+
+  // Fold 128 bits to 64 bits
+  x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask);
+  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits
+  x2 = _mm_and_si128(x1, mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return (uint32_t) _mm_extract_epi32(x1, 1);
+}
+#endif
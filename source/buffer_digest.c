@@ -0,0 +1,128 @@
+/**
+ * \file buffer_digest.c
+ * \brief Buffer for MCU, running digest updated by buffer writes
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stddef.h>
+
+#include "buffer/buffer_crc.h"
+#include "buffer/buffer_digest.h"
+
+#if defined(BUF_DIGEST_ENABLE)
+
+// --- Private define
+
+/**
+ * \brief Fletcher-16 bytes between modulo, sum2 stays below 2^32
+ */
+#define BUF_DIGEST_FLETCHER_BLOCK 4096U
+
+// --- Private function
+
+static uint32_t buf_digest_fletcher16(uint32_t state,
+                                      const uint8_t* data,
+                                      size_t size);
+
+// --- Public functions
+
+void BUF_DigestInit(BUF_Digest_t* digest, BUF_DigestType_t type)
+{
+  if (digest != NULL)
+  {
+    digest->type  = (uint8_t) type;
+    digest->state = 0;
+  }
+}
+
+/**
+ * \details CRC state is kept as the final value, see BUF_Crc32Update
+ */
+void BUF_DigestUpdate(BUF_Digest_t* digest, const uint8_t* data, size_t size)
+{
+  if ((digest != NULL) && (data != NULL))
+  {
+    if (digest->type == (uint8_t) BUF_DIGEST_FLETCHER16)
+    {
+      digest->state = buf_digest_fletcher16(digest->state, data, size);
+    }
+    else
+    {
+      digest->state = BUF_Crc32Update(digest->state, data, size);
+    }
+  }
+}
+
+uint32_t BUF_DigestGetValue(const BUF_Digest_t* digest)
+{
+  uint32_t value = 0;
+  if (digest != NULL)
+  {
+    if (digest->type == (uint8_t) BUF_DIGEST_FLETCHER16)
+    {
+      value = ((digest->state >> 8U) & 0xFF00U) | (digest->state & 0xFFU);
+    }
+    else
+    {
+      value = digest->state;
+    }
+  }
+  return value;
+}
+
+void BUF_AttachDigest(BUF_t* buffer, BUF_Digest_t* digest)
+{
+  if (buffer != NULL)
+  {
+    buffer->digest = digest;
+  }
+}
+
+uint32_t BUF_FinalizeDigest(BUF_t* buffer)
+{
+  uint32_t value = 0;
+  if ((buffer != NULL) && (buffer->digest != NULL))
+  {
+    value = BUF_DigestGetValue(buffer->digest);
+    BUF_DigestInit(buffer->digest, (BUF_DigestType_t) buffer->digest->type);
+  }
+  return value;
+}
+
+// --- Private functions
+
+/**
+ * \brief Fletcher-16 update, modulo deferred to block end
+ * \param state Current sums, sum2 << 16 | sum1, both reduced
+ * \param data Data
+ * \param size Data size
+ * \return Updated sums, reduced
+ */
+static uint32_t buf_digest_fletcher16(uint32_t state,
+                                      const uint8_t* data,
+                                      size_t size)
+{
+  uint32_t sum1 = state & 0xFFFFU;
+  uint32_t sum2 = state >> 16U;
+
+  while (size > 0)
+  {
+    size_t block = (size < BUF_DIGEST_FLETCHER_BLOCK)
+                     ? size
+                     : BUF_DIGEST_FLETCHER_BLOCK;
+    size -= block;
+    while (block > 0)
+    {
+      sum1 += *data;
+      sum2 += sum1;
+      data = &data[1];
+      block--;
+    }
+    sum1 %= 255U;
+    sum2 %= 255U;
+  }
+  return (sum2 << 16U) | sum1;
+}
+
+#endif
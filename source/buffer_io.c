@@ -0,0 +1,422 @@
+/**
+ * \file buffer_io.c
+ * \brief Buffer for MCU, POSIX file descriptor read and write
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "buffer/buffer_io.h"
+
+#if defined(BUF_IO_ENABLE)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "buffer/buffer_inline.h"
+
+// --- Private function
+
+static BUF_IoStatus_t buf_io_error_status(void);
+static size_t buf_io_to_read_iov(BUF_t* buffers,
+                                 size_t count,
+                                 struct iovec* iov);
+static void buf_io_set_status(BUF_IoStatus_t* status, BUF_IoStatus_t value);
+static size_t buf_map_window_max(void);
+static bool buf_map_window(BUF_Map_t* map, uint64_t offset);
+
+// --- Public functions
+
+BUF_size_t BUF_ReadFromFd(BUF_t* buffer, int fd, BUF_IoStatus_t* status)
+{
+  BUF_size_t read_count  = 0;
+  BUF_IoStatus_t outcome = BUF_IO_ERROR;
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    BUF_size_t free_size = BUF_GetFreeSize(buffer);
+    ssize_t ret          = 0;
+    if (free_size > 0)
+    {
+      do
+      {
+        ret = read(fd, &buffer->data[buffer->write_index], free_size);
+      } while ((ret < 0) && (errno == EINTR));
+    }
+    if (ret > 0)
+    {
+      read_count = (BUF_size_t) ret;
+      buffer->write_index += read_count;
+      buf_on_write(buffer, read_count);
+      outcome = BUF_IO_OK;
+    }
+    else if (ret == 0)
+    {
+      outcome = (free_size > 0) ? BUF_IO_EOF : BUF_IO_OK;
+    }
+    else
+    {
+      outcome = buf_io_error_status();
+    }
+  }
+  buf_io_set_status(status, outcome);
+  return read_count;
+}
+
+BUF_size_t BUF_WriteToFd(BUF_t* buffer, int fd, BUF_IoStatus_t* status)
+{
+  BUF_size_t written     = 0;
+  BUF_IoStatus_t outcome = BUF_IO_ERROR;
+  if ((buffer != NULL) && (buffer->data != NULL))
+  {
+    outcome = BUF_IO_OK;
+    while ((outcome == BUF_IO_OK) && (BUF_GetToReadCount(buffer) > 0))
+    {
+      BUF_size_t to_read = BUF_GetToReadCount(buffer);
+      ssize_t ret = write(fd, &buffer->data[buffer->read_index], to_read);
+      if (ret > 0)
+      {
+        buffer->read_index += (BUF_size_t) ret;
+        written += (BUF_size_t) ret;
+        buf_on_read(buffer, (BUF_size_t) ret);
+      }
+      else if ((ret < 0) && (errno == EINTR))
+      {
+        // retry
+      }
+      else
+      {
+        outcome = (ret < 0) ? buf_io_error_status() : BUF_IO_ERROR;
+      }
+    }
+  }
+  buf_io_set_status(status, outcome);
+  return written;
+}
+
+size_t BUF_ReadvFromFd(BUF_t* buffers,
+                       size_t count,
+                       int fd,
+                       BUF_IoStatus_t* status)
+{
+  size_t read_count      = 0;
+  BUF_IoStatus_t outcome = BUF_IO_ERROR;
+  struct iovec iov[BUF_IO_IOV_MAX];
+  size_t iov_count = 0;
+  size_t free_size = 0;
+
+  if (buffers != NULL)
+  {
+    count   = (count < BUF_IO_IOV_MAX) ? count : BUF_IO_IOV_MAX;
+    outcome = BUF_IO_OK;
+    for (size_t i = 0; (i < count) && (outcome == BUF_IO_OK); i++)
+    {
+      if (buffers[i].data == NULL)
+      {
+        outcome = BUF_IO_ERROR;
+      }
+      else
+      {
+        iov[i].iov_base = &buffers[i].data[buffers[i].write_index];
+        iov[i].iov_len  = BUF_GetFreeSize(&buffers[i]);
+        free_size += iov[i].iov_len;
+      }
+    }
+    iov_count = count;
+  }
+
+  if ((outcome == BUF_IO_OK) && (free_size > 0))
+  {
+    ssize_t ret = 0;
+    do
+    {
+      ret = readv(fd, iov, (int) iov_count);
+    } while ((ret < 0) && (errno == EINTR));
+
+    if (ret > 0)
+    {
+      read_count = (size_t) ret;
+      for (size_t i = 0, left = read_count; (i < iov_count) && (left > 0); i++)
+      {
+        BUF_size_t size = (BUF_size_t) ((left < iov[i].iov_len)
+                                          ? left
+                                          : iov[i].iov_len);
+        buffers[i].write_index += size;
+        buf_on_write(&buffers[i], size);
+        left -= size;
+      }
+    }
+    else if (ret == 0)
+    {
+      outcome = BUF_IO_EOF;
+    }
+    else
+    {
+      outcome = buf_io_error_status();
+    }
+  }
+  buf_io_set_status(status, outcome);
+  return read_count;
+}
+
+size_t BUF_WritevToFd(BUF_t* buffers,
+                      size_t count,
+                      int fd,
+                      BUF_IoStatus_t* status)
+{
+  size_t written         = 0;
+  BUF_IoStatus_t outcome = BUF_IO_ERROR;
+  struct iovec iov[BUF_IO_IOV_MAX];
+
+  if (buffers != NULL)
+  {
+    count   = (count < BUF_IO_IOV_MAX) ? count : BUF_IO_IOV_MAX;
+    outcome = BUF_IO_OK;
+    for (size_t i = 0; i < count; i++)
+    {
+      if (buffers[i].data == NULL)
+      {
+        outcome = BUF_IO_ERROR;
+      }
+    }
+  }
+
+  bool is_drained = false;
+  while ((outcome == BUF_IO_OK) && (is_drained == false))
+  {
+    // iovecs rebuilt from indices, a short write leaves them mid-buffer
+    size_t iov_count = buf_io_to_read_iov(buffers, count, iov);
+    ssize_t ret = (iov_count > 0) ? writev(fd, iov, (int) iov_count) : 0;
+    if (iov_count == 0)
+    {
+      is_drained = true;
+    }
+    else if (ret > 0)
+    {
+      size_t left = (size_t) ret;
+      written += left;
+      for (size_t i = 0; (i < count) && (left > 0); i++)
+      {
+        BUF_size_t to_read = BUF_GetToReadCount(&buffers[i]);
+        BUF_size_t size = (BUF_size_t) ((left < to_read) ? left : to_read);
+        buffers[i].read_index += size;
+        if (size > 0)
+        {
+          buf_on_read(&buffers[i], size);
+        }
+        left -= size;
+      }
+    }
+    else if ((ret < 0) && (errno == EINTR))
+    {
+      // retry
+    }
+    else
+    {
+      outcome = (ret < 0) ? buf_io_error_status() : BUF_IO_ERROR;
+    }
+  }
+  buf_io_set_status(status, outcome);
+  return written;
+}
+
+// --- Public functions, memory-mapped file
+
+bool BUF_MapFile(BUF_Map_t* map,
+                 BUF_t* buffer,
+                 const char* path,
+                 BUF_MapMode_t mode)
+{
+  bool is_ok = false;
+  struct stat st;
+  if ((map != NULL) && (buffer != NULL) && (path != NULL))
+  {
+    map->window      = NULL;
+    map->window_size = 0;
+    map->offset      = 0;
+    map->file_size   = 0;
+    map->mode        = (uint8_t) mode;
+    map->fd          = open(path, O_RDONLY | O_CLOEXEC);
+    if ((map->fd >= 0) && (fstat(map->fd, &st) == 0))
+    {
+      map->file_size = (uint64_t) st.st_size;
+      is_ok          = (map->file_size == 0) || buf_map_window(map, 0);
+    }
+    BUF_InitFull(buffer, map->window, (BUF_size_t) map->window_size);
+    buffer->data = map->window;
+    if (is_ok == false)
+    {
+      BUF_Unmap(map, buffer);
+    }
+  }
+  return is_ok;
+}
+
+bool BUF_MapNext(BUF_Map_t* map, BUF_t* buffer)
+{
+  bool is_ok = false;
+  if ((map != NULL) && (buffer != NULL) && (map->window != NULL)
+      && (buffer->data == map->window)
+      && ((map->offset + map->window_size) < map->file_size))
+  {
+    uint64_t page    = (uint64_t) sysconf(_SC_PAGESIZE);
+    uint64_t start   = map->offset + buffer->read_index;
+    uint64_t aligned = start - (start % page);
+    is_ok            = buf_map_window(map, aligned);
+
+    buffer->data        = map->window;
+    buffer->size        = (BUF_size_t) map->window_size;
+    buffer->write_index = buffer->size;
+    buffer->read_index  = is_ok ? (BUF_size_t) (start - aligned) : 0;
+  }
+  return is_ok;
+}
+
+void BUF_Unmap(BUF_Map_t* map, BUF_t* buffer)
+{
+  if (map != NULL)
+  {
+    if (map->window != NULL)
+    {
+      munmap(map->window, map->window_size);
+    }
+    if (map->fd >= 0)
+    {
+      close(map->fd);
+    }
+    map->window      = NULL;
+    map->window_size = 0;
+    map->fd          = -1;
+  }
+  if (buffer != NULL)
+  {
+    buffer->data        = NULL;
+    buffer->size        = 0;
+    buffer->read_index  = 0;
+    buffer->write_index = 0;
+  }
+}
+
+// --- Private functions
+
+/**
+ * \brief Status of failed system call, from errno
+ * \return BUF_IO_AGAIN if descriptor would block, BUF_IO_ERROR otherwise
+ */
+static BUF_IoStatus_t buf_io_error_status(void)
+{
+  return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? BUF_IO_AGAIN
+                                                       : BUF_IO_ERROR;
+}
+
+/**
+ * \brief Describe data to read of buffers, empty buffers skipped
+ * \param buffers Buffers to read from, not NULL, data not NULL
+ * \param count Buffer count, at most BUF_IO_IOV_MAX
+ * \param iov Array of count entries to fill
+ * \return iovec count filled
+ */
+static size_t buf_io_to_read_iov(BUF_t* buffers,
+                                 size_t count,
+                                 struct iovec* iov)
+{
+  size_t iov_count = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    BUF_size_t to_read = BUF_GetToReadCount(&buffers[i]);
+    if (to_read > 0)
+    {
+      iov[iov_count].iov_base = &buffers[i].data[buffers[i].read_index];
+      iov[iov_count].iov_len  = to_read;
+      iov_count++;
+    }
+  }
+  return iov_count;
+}
+
+/**
+ * \brief Store status if requested
+ * \param status Status to set, may be NULL
+ * \param value Status value
+ */
+static void buf_io_set_status(BUF_IoStatus_t* status, BUF_IoStatus_t value)
+{
+  if (status != NULL)
+  {
+    *status = value;
+  }
+}
+
+/**
+ * \brief Largest window, bounded by BUF_MAP_WINDOW_MAX and BUF_size_t
+ * \return Window size, multiple of page size, 0 if one page does not fit,
+ * e.g. 64 KiB pages with a uint16_t BUF_size_t
+ */
+static size_t buf_map_window_max(void)
+{
+  long page_size = sysconf(_SC_PAGESIZE);
+  size_t max     = ((size_t) (BUF_size_t) -1 < BUF_MAP_WINDOW_MAX)
+                     ? (size_t) (BUF_size_t) -1
+                     : BUF_MAP_WINDOW_MAX;
+  size_t window  = 0;
+
+  if (page_size > 0)
+  {
+    window = max - (max % (size_t) page_size);
+  }
+  return window;
+}
+
+/**
+ * \brief Replace mapped window by window at offset, advised sequential
+ * \param map Mapping with open file, not NULL
+ * \param offset File offset, multiple of page size, below file size
+ * \return true if mapped, false if error, map has no window then, errno is
+ * EOVERFLOW if one page does not fit in a window
+ */
+static bool buf_map_window(BUF_Map_t* map, uint64_t offset)
+{
+  uint64_t left = map->file_size - offset;
+  size_t size   = buf_map_window_max();
+  int prot      = PROT_READ;
+  int flags     = MAP_SHARED;
+  void* window  = MAP_FAILED;
+
+  if (map->window != NULL)
+  {
+    munmap(map->window, map->window_size);
+    map->window      = NULL;
+    map->window_size = 0;
+  }
+  if (map->mode == (uint8_t) BUF_MAP_PRIVATE)
+  {
+    prot  = PROT_READ | PROT_WRITE;
+    flags = MAP_PRIVATE;
+  }
+  size = (left < size) ? (size_t) left : size;
+  if (size > 0)
+  {
+    window = mmap(NULL, size, prot, flags, map->fd, (off_t) offset);
+  }
+  else
+  {
+    // No page fits in a window, mmap would fail on size 0 anyway
+    errno = EOVERFLOW;
+  }
+  if (window != MAP_FAILED)
+  {
+    (void) madvise(window, size, MADV_SEQUENTIAL);
+    (void) madvise(window, size, MADV_WILLNEED);
+    map->window      = (uint8_t*) window;
+    map->window_size = size;
+    map->offset      = offset;
+  }
+  return (window != MAP_FAILED);
+}
+
+#endif
@@ -0,0 +1,354 @@
+/**
+ * \file buffer_pool.c
+ * \brief Buffer for MCU, fixed-block buffer pool
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "buffer/buffer_pool.h"
+
+#if defined(BUF_POOL_ATOMIC_ENABLE) && !defined(__GNUC__)
+#error "BUF_POOL_ATOMIC_ENABLE requires __atomic builtins (GCC or Clang)"
+#endif
+
+// --- Private define
+
+/**
+ * \brief Offset of BUF_t in block, link is at offset 0
+ */
+#define BUF_POOL_BUFFER_OFFSET BUF_POOL_ALIGN(sizeof(uint32_t))
+
+/**
+ * \brief Offset of data in block
+ */
+#define BUF_POOL_DATA_OFFSET \
+  (BUF_POOL_BUFFER_OFFSET + BUF_POOL_ALIGN(sizeof(BUF_t)))
+
+/**
+ * \brief Empty free list, block indices are stored + 1
+ */
+#define BUF_POOL_NONE 0U
+
+/**
+ * \brief Link of an acquired block, never a block index + 1
+ */
+#define BUF_POOL_IN_USE UINT32_MAX
+
+/**
+ * \brief Free list head fields
+ */
+#define buf_pool_head_index(head) ((uint32_t) ((head) & 0xFFFFFFFFU))
+#define buf_pool_head_make(tag, index) \
+  ((((uint64_t) (tag)) << 32U) | (uint64_t) (index))
+#define buf_pool_head_next_tag(head) ((uint32_t) ((head) >> 32U) + 1U)
+
+/**
+ * \brief Counter read, may race with the atomic variant
+ */
+#if defined(BUF_POOL_ATOMIC_ENABLE)
+#define buf_pool_load_count(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#else
+#define buf_pool_load_count(ptr) (*(ptr))
+#endif
+
+// --- Private function
+
+static uint32_t* buf_pool_link(const BUF_Pool_t* pool, uint32_t index);
+static BUF_t* buf_pool_init_block(const BUF_Pool_t* pool, uint32_t index);
+static uint32_t buf_pool_index_of(const BUF_Pool_t* pool, const BUF_t* buffer);
+#if defined(BUF_POOL_ATOMIC_ENABLE)
+static void buf_pool_update_high_water(BUF_Pool_t* pool, size_t used_count);
+#endif
+
+// --- Public functions
+
+/**
+ * \details Blocks are chained in arena order
+ */
+bool BUF_PoolInit(BUF_Pool_t* pool,
+                  uint8_t* arena,
+                  size_t arena_size,
+                  BUF_size_t data_size)
+{
+  bool is_init      = false;
+  size_t block_size = BUF_POOL_BLOCK_SIZE(data_size);
+  size_t count      = arena_size / block_size;
+
+  if (count > (size_t) (UINT32_MAX - 1U))
+  {
+    count = (size_t) (UINT32_MAX - 1U);
+  }
+  if ((pool != NULL) && (arena != NULL) && (count > 0)
+      && (((uintptr_t) arena % BUF_POOL_ALIGNMENT) == 0))
+  {
+    memset(pool, 0x00, sizeof(*pool));
+    pool->arena       = arena;
+    pool->block_size  = block_size;
+    pool->block_count = (uint32_t) count;
+    pool->data_size   = data_size;
+    for (uint32_t i = 0; i < pool->block_count; i++)
+    {
+      *buf_pool_link(pool, i) = ((i + 1U) < pool->block_count)
+                                  ? (i + 2U)
+                                  : BUF_POOL_NONE;
+    }
+    pool->head = buf_pool_head_make(0, 1U);
+    is_init    = true;
+  }
+  return is_init;
+}
+
+BUF_t* BUF_PoolAcquire(BUF_Pool_t* pool)
+{
+  BUF_t* buffer = NULL;
+  if (pool != NULL)
+  {
+    uint32_t first = buf_pool_head_index(pool->head);
+    if (first != BUF_POOL_NONE)
+    {
+      uint32_t* link = buf_pool_link(pool, first - 1U);
+      pool->head     = buf_pool_head_make(0, *link);
+      *link          = BUF_POOL_IN_USE;
+      buffer         = buf_pool_init_block(pool, first - 1U);
+      pool->used_count++;
+      if (pool->used_count > pool->high_water_mark)
+      {
+        pool->high_water_mark = pool->used_count;
+      }
+    }
+    else
+    {
+      pool->failed_count++;
+    }
+  }
+  return buffer;
+}
+
+bool BUF_PoolRelease(BUF_Pool_t* pool, BUF_t* buffer)
+{
+  bool is_released = false;
+  uint32_t index   = buf_pool_index_of(pool, buffer);
+
+  if ((index != BUF_POOL_NONE)
+      && (*buf_pool_link(pool, index - 1U) == BUF_POOL_IN_USE))
+  {
+    *buf_pool_link(pool, index - 1U) = buf_pool_head_index(pool->head);
+    pool->head = buf_pool_head_make(0, index);
+    pool->used_count--;
+    is_released = true;
+  }
+  return is_released;
+}
+
+#if defined(BUF_POOL_ATOMIC_ENABLE)
+
+/**
+ * \details The link of first is read before the swap, it may be stale if an
+ * other thread popped first meanwhile, the tag makes the swap fail then
+ */
+BUF_t* BUF_PoolAcquireAtomic(BUF_Pool_t* pool)
+{
+  BUF_t* buffer = NULL;
+  if (pool != NULL)
+  {
+    uint64_t head  = __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE);
+    uint32_t first = buf_pool_head_index(head);
+    bool is_popped = false;
+
+    while ((first != BUF_POOL_NONE) && (is_popped == false))
+    {
+      uint32_t next =
+        __atomic_load_n(buf_pool_link(pool, first - 1U), __ATOMIC_RELAXED);
+      uint64_t new_head =
+        buf_pool_head_make(buf_pool_head_next_tag(head), next);
+
+      is_popped = __atomic_compare_exchange_n(&pool->head,
+                                              &head,
+                                              new_head,
+                                              true,
+                                              __ATOMIC_ACQUIRE,
+                                              __ATOMIC_ACQUIRE);
+      if (is_popped == false)
+      {
+        first = buf_pool_head_index(head);
+      }
+    }
+
+    if (is_popped)
+    {
+      __atomic_store_n(buf_pool_link(pool, first - 1U),
+                       BUF_POOL_IN_USE,
+                       __ATOMIC_RELAXED);
+      size_t used_count =
+        __atomic_add_fetch(&pool->used_count, 1U, __ATOMIC_RELAXED);
+      buf_pool_update_high_water(pool, used_count);
+      buffer = buf_pool_init_block(pool, first - 1U);
+    }
+    else
+    {
+      __atomic_add_fetch(&pool->failed_count, 1U, __ATOMIC_RELAXED);
+    }
+  }
+  return buffer;
+}
+
+/**
+ * \details The link is swapped from BUF_POOL_IN_USE first, so of two
+ * releases of one block, even concurrent, only one goes on
+ */
+bool BUF_PoolReleaseAtomic(BUF_Pool_t* pool, BUF_t* buffer)
+{
+  bool is_released = false;
+  uint32_t index   = buf_pool_index_of(pool, buffer);
+
+  if (index != BUF_POOL_NONE)
+  {
+    uint32_t* link  = buf_pool_link(pool, index - 1U);
+    uint32_t in_use = BUF_POOL_IN_USE;
+    uint64_t head   = __atomic_load_n(&pool->head, __ATOMIC_RELAXED);
+
+    if (__atomic_compare_exchange_n(link,
+                                    &in_use,
+                                    buf_pool_head_index(head),
+                                    false,
+                                    __ATOMIC_RELAXED,
+                                    __ATOMIC_RELAXED))
+    {
+      __atomic_sub_fetch(&pool->used_count, 1U, __ATOMIC_RELAXED);
+      while (__atomic_compare_exchange_n(
+               &pool->head,
+               &head,
+               buf_pool_head_make(buf_pool_head_next_tag(head), index),
+               true,
+               __ATOMIC_RELEASE,
+               __ATOMIC_RELAXED)
+             == false)
+      {
+        __atomic_store_n(link, buf_pool_head_index(head), __ATOMIC_RELAXED);
+      }
+      is_released = true;
+    }
+  }
+  return is_released;
+}
+
+#endif
+
+size_t BUF_PoolGetBlockCount(const BUF_Pool_t* pool)
+{
+  size_t count = 0;
+  if (pool != NULL)
+  {
+    count = pool->block_count;
+  }
+  return count;
+}
+
+size_t BUF_PoolGetUsedCount(const BUF_Pool_t* pool)
+{
+  size_t count = 0;
+  if (pool != NULL)
+  {
+    count = buf_pool_load_count(&pool->used_count);
+  }
+  return count;
+}
+
+size_t BUF_PoolGetHighWaterMark(const BUF_Pool_t* pool)
+{
+  size_t count = 0;
+  if (pool != NULL)
+  {
+    count = buf_pool_load_count(&pool->high_water_mark);
+  }
+  return count;
+}
+
+size_t BUF_PoolGetFailedCount(const BUF_Pool_t* pool)
+{
+  size_t count = 0;
+  if (pool != NULL)
+  {
+    count = buf_pool_load_count(&pool->failed_count);
+  }
+  return count;
+}
+
+// --- Private functions
+
+/**
+ * \brief Get free list link of block
+ * \param pool Pool, not NULL
+ * \param index Block index
+ * \return Link, next free block index + 1
+ */
+static uint32_t* buf_pool_link(const BUF_Pool_t* pool, uint32_t index)
+{
+  return (uint32_t*) (void*) &pool->arena[(size_t) index * pool->block_size];
+}
+
+/**
+ * \brief Initialize buffer of block
+ * \param pool Pool, not NULL
+ * \param index Block index
+ * \return Empty buffer on block data
+ */
+static BUF_t* buf_pool_init_block(const BUF_Pool_t* pool, uint32_t index)
+{
+  uint8_t* block = &pool->arena[(size_t) index * pool->block_size];
+  BUF_t* buffer  = (BUF_t*) (void*) &block[BUF_POOL_BUFFER_OFFSET];
+
+  BUF_InitEmpty(buffer, &block[BUF_POOL_DATA_OFFSET], pool->data_size);
+  return buffer;
+}
+
+/**
+ * \brief Get block index of buffer
+ * \param pool Pool
+ * \param buffer Buffer
+ * \return Block index + 1, BUF_POOL_NONE if buffer is not a block of pool
+ */
+static uint32_t buf_pool_index_of(const BUF_Pool_t* pool, const BUF_t* buffer)
+{
+  uint32_t index = BUF_POOL_NONE;
+  if ((pool != NULL) && (pool->arena != NULL) && (buffer != NULL))
+  {
+    uintptr_t first  = (uintptr_t) pool->arena + BUF_POOL_BUFFER_OFFSET;
+    uintptr_t offset = (uintptr_t) buffer - first;
+
+    if (((uintptr_t) buffer >= first) && ((offset % pool->block_size) == 0)
+        && ((offset / pool->block_size) < pool->block_count))
+    {
+      index = (uint32_t) (offset / pool->block_size) + 1U;
+    }
+  }
+  return index;
+}
+
+#if defined(BUF_POOL_ATOMIC_ENABLE)
+
+/**
+ * \brief Raise high-water mark up to used_count
+ * \param pool Pool, not NULL
+ * \param used_count Used count just reached
+ */
+static void buf_pool_update_high_water(BUF_Pool_t* pool, size_t used_count)
+{
+  size_t high  = __atomic_load_n(&pool->high_water_mark, __ATOMIC_RELAXED);
+  bool is_done = false;
+
+  while ((used_count > high) && (is_done == false))
+  {
+    is_done = __atomic_compare_exchange_n(&pool->high_water_mark,
+                                          &high,
+                                          used_count,
+                                          true,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED);
+  }
+}
+
+#endif
@@ -0,0 +1,259 @@
+/**
+ * \file buffer_ring.c
+ * \brief Buffer for MCU, single-producer/single-consumer ring buffer
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "buffer/buffer_ring.h"
+
+#if defined(BUF_RING_ENABLE)
+
+#if !defined(__GNUC__)
+#error "BUF_RING_ENABLE requires __atomic builtins (GCC or Clang)"
+#endif
+
+#include "buffer/buffer_inline.h"
+
+// --- Private define
+
+/**
+ * \brief Own index, only written by the calling side
+ */
+#define buf_ring_load_own(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+
+/**
+ * \brief Other side index, pairs with buf_ring_publish
+ */
+#define buf_ring_load_other(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+
+/**
+ * \brief Publish own index once data copy is done
+ */
+#define buf_ring_publish(ptr, value) \
+  __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+
+// --- Private function
+
+static BUF_size_t buf_ring_producer_free(BUF_Ring_t* ring, BUF_size_t needed);
+static BUF_size_t buf_ring_consumer_available(BUF_Ring_t* ring,
+                                              BUF_size_t needed);
+
+// --- Public functions
+
+bool BUF_RingInit(BUF_Ring_t* ring, uint8_t* data, BUF_size_t size)
+{
+  bool is_init = false;
+  BUF_size_t max_size = (BUF_size_t) ~(BUF_size_t) 0;
+  max_size            = (BUF_size_t) ((max_size / 2U) + 1U);
+
+  if ((ring != NULL) && (data != NULL) && (size > 0) && (size <= max_size)
+      && ((size & (size - 1U)) == 0))
+  {
+    memset(ring, 0x00, sizeof(*ring));
+    ring->data = data;
+    ring->mask = (BUF_size_t) (size - 1U);
+    is_init    = true;
+  }
+  return is_init;
+}
+
+void BUF_RingReset(BUF_Ring_t* ring)
+{
+  if (ring != NULL)
+  {
+    ring->producer.index  = 0;
+    ring->producer.cached = 0;
+    ring->consumer.index  = 0;
+    ring->consumer.cached = 0;
+  }
+}
+
+BUF_size_t BUF_RingGetSize(const BUF_Ring_t* ring)
+{
+  BUF_size_t size = 0;
+  if ((ring != NULL) && (ring->data != NULL))
+  {
+    size = (BUF_size_t) (ring->mask + 1U);
+  }
+  return size;
+}
+
+BUF_size_t BUF_RingGetFreeSize(const BUF_Ring_t* ring)
+{
+  return (BUF_size_t) (BUF_RingGetSize(ring) - BUF_RingGetToReadCount(ring));
+}
+
+BUF_size_t BUF_RingGetToReadCount(const BUF_Ring_t* ring)
+{
+  BUF_size_t to_read_count = 0;
+  if ((ring != NULL) && (ring->data != NULL))
+  {
+    BUF_size_t tail = buf_ring_load_other(&ring->consumer.index);
+    BUF_size_t head = buf_ring_load_other(&ring->producer.index);
+    to_read_count   = (BUF_size_t) (head - tail);
+  }
+  return to_read_count;
+}
+
+bool BUF_RingIsEmpty(const BUF_Ring_t* ring)
+{
+  return (BUF_RingGetToReadCount(ring) == 0);
+}
+
+bool BUF_RingIsFull(const BUF_Ring_t* ring)
+{
+  return (ring != NULL) && (ring->data != NULL)
+         && (BUF_RingGetToReadCount(ring) == BUF_RingGetSize(ring));
+}
+
+uint8_t BUF_RingWriteUint8(BUF_Ring_t* ring, uint8_t data)
+{
+  return (uint8_t) BUF_RingWriteRaw(ring, &data, 1);
+}
+
+uint8_t BUF_RingWriteUint16(BUF_Ring_t* ring, uint16_t data)
+{
+  uint8_t bytes[2];
+  buf_store_be16(bytes, data);
+  return (uint8_t) BUF_RingWriteRaw(ring, bytes, sizeof(bytes));
+}
+
+uint8_t BUF_RingWriteUint32(BUF_Ring_t* ring, uint32_t data)
+{
+  uint8_t bytes[4];
+  buf_store_be32(bytes, data);
+  return (uint8_t) BUF_RingWriteRaw(ring, bytes, sizeof(bytes));
+}
+
+/**
+ * \details Copy is split in two when it wraps around the end of data
+ */
+BUF_size_t BUF_RingWriteRaw(BUF_Ring_t* ring, const uint8_t* data, BUF_size_t size)
+{
+  BUF_size_t written = 0;
+  if ((ring != NULL) && (ring->data != NULL) && (data != NULL) && (size > 0)
+      && (buf_ring_producer_free(ring, size) >= size))
+  {
+    BUF_size_t head   = buf_ring_load_own(&ring->producer.index);
+    BUF_size_t offset = head & ring->mask;
+    BUF_size_t first  = (BUF_size_t) (ring->mask + 1U - offset);
+
+    if (first > size)
+    {
+      first = size;
+    }
+    memcpy(&ring->data[offset], data, first);
+    memcpy(ring->data, &data[first], (size_t) (size - first));
+
+    buf_ring_publish(&ring->producer.index, (BUF_size_t) (head + size));
+    written = size;
+  }
+  return written;
+}
+
+uint8_t BUF_RingReadUint8(BUF_Ring_t* ring)
+{
+  uint8_t read = 0;
+  (void) BUF_RingReadRaw(ring, &read, 1);
+  return read;
+}
+
+uint16_t BUF_RingReadUint16(BUF_Ring_t* ring)
+{
+  uint16_t read = 0;
+  uint8_t bytes[2];
+  if (BUF_RingReadRaw(ring, bytes, sizeof(bytes)) == sizeof(bytes))
+  {
+    read = buf_load_be16(bytes);
+  }
+  return read;
+}
+
+uint32_t BUF_RingReadUint32(BUF_Ring_t* ring)
+{
+  uint32_t read = 0;
+  uint8_t bytes[4];
+  if (BUF_RingReadRaw(ring, bytes, sizeof(bytes)) == sizeof(bytes))
+  {
+    read = buf_load_be32(bytes);
+  }
+  return read;
+}
+
+/**
+ * \details Copy is split in two when it wraps around the end of data
+ */
+BUF_size_t BUF_RingReadRaw(BUF_Ring_t* ring, uint8_t* data, BUF_size_t size)
+{
+  BUF_size_t read = 0;
+  if ((ring != NULL) && (ring->data != NULL) && (data != NULL) && (size > 0)
+      && (buf_ring_consumer_available(ring, size) >= size))
+  {
+    BUF_size_t tail   = buf_ring_load_own(&ring->consumer.index);
+    BUF_size_t offset = tail & ring->mask;
+    BUF_size_t first  = (BUF_size_t) (ring->mask + 1U - offset);
+
+    if (first > size)
+    {
+      first = size;
+    }
+    memcpy(data, &ring->data[offset], first);
+    memcpy(&data[first], ring->data, (size_t) (size - first));
+
+    buf_ring_publish(&ring->consumer.index, (BUF_size_t) (tail + size));
+    read = size;
+  }
+  return read;
+}
+
+// --- Private functions
+
+/**
+ * \brief Get free space seen by producer
+ * \param ring Ring buffer
+ * \param needed Size the producer wants to write
+ * \return Free space
+ * \details Consumer index is only reloaded, hence its cache line only
+ * transferred, when the cached value does not leave enough space
+ */
+static BUF_size_t buf_ring_producer_free(BUF_Ring_t* ring, BUF_size_t needed)
+{
+  BUF_size_t size = (BUF_size_t) (ring->mask + 1U);
+  BUF_size_t head = buf_ring_load_own(&ring->producer.index);
+  BUF_size_t used = (BUF_size_t) (head - ring->producer.cached);
+
+  if ((BUF_size_t) (size - used) < needed)
+  {
+    ring->producer.cached = buf_ring_load_other(&ring->consumer.index);
+    used = (BUF_size_t) (head - ring->producer.cached);
+  }
+  return (BUF_size_t) (size - used);
+}
+
+/**
+ * \brief Get data to read seen by consumer
+ * \param ring Ring buffer
+ * \param needed Size the consumer wants to read
+ * \return Data to read count
+ * \details Producer index is only reloaded, hence its cache line only
+ * transferred, when the cached value does not hold enough data
+ */
+static BUF_size_t buf_ring_consumer_available(BUF_Ring_t* ring,
+                                              BUF_size_t needed)
+{
+  BUF_size_t tail      = buf_ring_load_own(&ring->consumer.index);
+  BUF_size_t available = (BUF_size_t) (ring->consumer.cached - tail);
+
+  if (available < needed)
+  {
+    ring->consumer.cached = buf_ring_load_other(&ring->producer.index);
+    available = (BUF_size_t) (ring->consumer.cached - tail);
+  }
+  return available;
+}
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * \file buffer_shared.c
+ * \brief Buffer for MCU, multi-producer append to one buffer
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "buffer/buffer_shared.h"
+
+#if defined(BUF_SHARED_ENABLE)
+
+#if !defined(__GNUC__)
+#error "BUF_SHARED_ENABLE requires __atomic builtins (GCC or Clang)"
+#endif
+
+#include "buffer/buffer_inline.h"
+
+#if (BUF_SHARED_IN_FLIGHT_COUNT == 0U) || (BUF_SHARED_IN_FLIGHT_COUNT > 255U)
+#error "BUF_SHARED_IN_FLIGHT_COUNT must be 1 to 255"
+#endif
+
+// --- Private define
+
+/**
+ * \brief Free in-flight entry, above any start
+ */
+#define BUF_SHARED_FREE SIZE_MAX
+
+// --- Private function
+
+static bool buf_shared_claim(BUF_Shared_t* shared, uint8_t* entry);
+
+// --- Public functions
+
+bool BUF_SharedInit(BUF_Shared_t* shared, BUF_t* buffer)
+{
+  bool is_init = false;
+  if ((shared != NULL) && (buffer != NULL) && (buffer->data != NULL))
+  {
+    shared->buffer   = buffer;
+    shared->reserved = buffer->write_index;
+    shared->end      = buffer->size;
+    for (uint8_t i = 0; i < BUF_SHARED_IN_FLIGHT_COUNT; i++)
+    {
+      shared->in_flight[i] = BUF_SHARED_FREE;
+    }
+    is_init = true;
+  }
+  return is_init;
+}
+
+void BUF_SharedReset(BUF_Shared_t* shared)
+{
+  if ((shared != NULL) && (shared->buffer != NULL))
+  {
+    BUF_Reset(shared->buffer);
+    (void) BUF_SharedInit(shared, shared->buffer);
+  }
+}
+
+/**
+ * \details The entry is claimed with the current offset before the
+ * fetch-add, so it is a lower bound of the slot start that is visible to
+ * the consumer as soon as the slot is reserved. The offset is checked before
+ * the fetch-add, so a full buffer is not contended and the offset overshoots
+ * size by at most the slots raced in meanwhile. The one slot that crosses
+ * size lowers end to its start before freeing its entry, slots after it
+ * start past size
+ */
+uint8_t*
+BUF_SharedReserve(BUF_Shared_t* shared, BUF_size_t size, BUF_SharedSlot_t* slot)
+{
+  uint8_t* data = NULL;
+  if ((shared != NULL) && (shared->buffer != NULL) && (slot != NULL)
+      && (size > 0))
+  {
+    size_t capacity = shared->buffer->size;
+    size_t start    = __atomic_load_n(&shared->reserved, __ATOMIC_RELAXED);
+    uint8_t entry   = 0;
+
+    if ((start <= capacity) && (size <= capacity - start)
+        && buf_shared_claim(shared, &entry))
+    {
+      start = __atomic_fetch_add(&shared->reserved, size, __ATOMIC_SEQ_CST);
+      if ((start <= capacity) && (size <= capacity - start))
+      {
+        data = &shared->buffer->data[start];
+      }
+      else
+      {
+        if (start < capacity)
+        {
+          __atomic_store_n(&shared->end, start, __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(
+          &shared->in_flight[entry], BUF_SHARED_FREE, __ATOMIC_RELEASE);
+      }
+    }
+
+    slot->data  = data;
+    slot->size  = (data != NULL) ? size : 0U;
+    slot->entry = entry;
+    if (data == NULL)
+    {
+      buf_on_write_failed(shared->buffer);
+    }
+  }
+  return data;
+}
+
+/**
+ * \details The slot is cleared once committed, its entry may be claimed by
+ * another producer right after the release store
+ */
+BUF_size_t BUF_SharedCommit(BUF_Shared_t* shared, BUF_SharedSlot_t* slot)
+{
+  BUF_size_t committed = 0;
+  if ((shared != NULL) && (slot != NULL) && (slot->data != NULL)
+      && (slot->entry < BUF_SHARED_IN_FLIGHT_COUNT))
+  {
+    __atomic_store_n(
+      &shared->in_flight[slot->entry], BUF_SHARED_FREE, __ATOMIC_RELEASE);
+    committed   = slot->size;
+    slot->data  = NULL;
+    slot->size  = 0;
+  }
+  return committed;
+}
+
+BUF_size_t
+BUF_SharedWriteRaw(BUF_Shared_t* shared, const uint8_t* data, BUF_size_t size)
+{
+  BUF_size_t written = 0;
+  if (data != NULL)
+  {
+    BUF_SharedSlot_t slot;
+    if (BUF_SharedReserve(shared, size, &slot) != NULL)
+    {
+      memcpy(slot.data, data, size);
+      written = BUF_SharedCommit(shared, &slot);
+    }
+  }
+  return written;
+}
+
+/**
+ * \details reserved is loaded first: every slot below it had claimed its
+ * entry before, so the scan sees its start bound, or a free entry once the
+ * slot is filled or dropped. end is loaded last, after the entry of the
+ * slot that lowered it was seen free
+ */
+BUF_size_t BUF_SharedSync(BUF_Shared_t* shared)
+{
+  BUF_size_t published = 0;
+  if ((shared != NULL) && (shared->buffer != NULL))
+  {
+    size_t limit = __atomic_load_n(&shared->reserved, __ATOMIC_SEQ_CST);
+    size_t end   = 0;
+
+    for (uint8_t i = 0; i < BUF_SHARED_IN_FLIGHT_COUNT; i++)
+    {
+      size_t start = __atomic_load_n(&shared->in_flight[i], __ATOMIC_ACQUIRE);
+      if (start < limit)
+      {
+        limit = start;
+      }
+    }
+    end = __atomic_load_n(&shared->end, __ATOMIC_RELAXED);
+    if (end < limit)
+    {
+      limit = end;
+    }
+    if (limit > shared->buffer->write_index)
+    {
+      published = (BUF_size_t) (limit - shared->buffer->write_index);
+      shared->buffer->write_index = (BUF_size_t) limit;
+      buf_on_write(shared->buffer, published);
+    }
+  }
+  return published;
+}
+
+// --- Private functions
+
+/**
+ * \brief Claim a free in-flight entry with the current reservation offset
+ * \param shared Shared append state, not NULL
+ * \param entry Claimed entry
+ * \return true if claimed, false if all entries are taken
+ * \details The claim is a read-modify-write, so it extends the release
+ * sequence of the commit that freed the entry
+ */
+static bool buf_shared_claim(BUF_Shared_t* shared, uint8_t* entry)
+{
+  bool is_claimed = false;
+  for (uint8_t i = 0; (i < BUF_SHARED_IN_FLIGHT_COUNT) && !is_claimed; i++)
+  {
+    size_t expected = BUF_SHARED_FREE;
+    size_t start    = __atomic_load_n(&shared->reserved, __ATOMIC_RELAXED);
+
+    is_claimed = __atomic_compare_exchange_n(&shared->in_flight[i],
+                                             &expected,
+                                             start,
+                                             false,
+                                             __ATOMIC_SEQ_CST,
+                                             __ATOMIC_RELAXED);
+    *entry     = i;
+  }
+  return is_claimed;
+}
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * \file buffer_stats.c
+ * \brief Buffer for MCU, instrumentation counters
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "buffer/buffer_stats.h"
+
+#if defined(BUF_STATS_ENABLE)
+
+// --- Public functions
+
+void BUF_StatsInit(BUF_Stats_t* stats)
+{
+  if (stats != NULL)
+  {
+    memset(stats, 0x00, sizeof(*stats));
+  }
+}
+
+void BUF_AttachStats(BUF_t* buffer, BUF_Stats_t* stats)
+{
+  if (buffer != NULL)
+  {
+    buffer->stats = stats;
+  }
+}
+
+void BUF_StatsGetSnapshot(const BUF_Stats_t* stats, BUF_Stats_t* snapshot)
+{
+  if ((stats != NULL) && (snapshot != NULL))
+  {
+    snapshot->write_index_high_water =
+      __atomic_load_n(&stats->write_index_high_water, __ATOMIC_RELAXED);
+    snapshot->bytes_written =
+      __atomic_load_n(&stats->bytes_written, __ATOMIC_RELAXED);
+    snapshot->bytes_read = __atomic_load_n(&stats->bytes_read, __ATOMIC_RELAXED);
+    snapshot->write_failed =
+      __atomic_load_n(&stats->write_failed, __ATOMIC_RELAXED);
+    snapshot->read_failed =
+      __atomic_load_n(&stats->read_failed, __ATOMIC_RELAXED);
+    snapshot->compare_count =
+      __atomic_load_n(&stats->compare_count, __ATOMIC_RELAXED);
+    snapshot->view_count = __atomic_load_n(&stats->view_count, __ATOMIC_RELAXED);
+  }
+}
+
+/**
+ * \details High-water mark is raised with a relaxed compare-and-swap loop
+ */
+void BUF_StatsAddWritten(BUF_Stats_t* stats,
+                         BUF_size_t size,
+                         BUF_size_t write_index)
+{
+  if (stats != NULL)
+  {
+    size_t high =
+      __atomic_load_n(&stats->write_index_high_water, __ATOMIC_RELAXED);
+    bool is_done = false;
+
+    __atomic_add_fetch(&stats->bytes_written, size, __ATOMIC_RELAXED);
+    while ((write_index > high) && (is_done == false))
+    {
+      is_done = __atomic_compare_exchange_n(&stats->write_index_high_water,
+                                            &high,
+                                            write_index,
+                                            true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED);
+    }
+  }
+}
+
+#endif
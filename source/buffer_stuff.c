@@ -0,0 +1,478 @@
+/**
+ * \file buffer_stuff.c
+ * \brief Buffer for MCU, COBS, SLIP and HDLC byte stuffing
+ * \date 2024-04
+ * \author Nicolas Boutin
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "buffer/buffer_inline.h"
+#include "buffer/buffer_stuff.h"
+
+// --- Private define
+
+#define BUF_COBS_DELIMITER 0x00U
+#define BUF_COBS_RUN_MAX   254U
+
+// --- Private type
+
+/**
+ * \brief Escape based codec, SLIP or HDLC
+ */
+typedef struct {
+  uint8_t end;          /*!< Frame delimiter */
+  uint8_t esc;          /*!< Escape byte */
+  uint8_t esc_end;      /*!< Escaped delimiter */
+  uint8_t esc_esc;      /*!< Escaped escape byte */
+  uint8_t xor_mask;     /*!< Decoding of other escaped bytes */
+  bool has_leading_end; /*!< Delimiter also before frame */
+} buf_escape_codec_t;
+
+static const buf_escape_codec_t buf_slip = {
+  .end             = 0xC0U,
+  .esc             = 0xDBU,
+  .esc_end         = 0xDCU,
+  .esc_esc         = 0xDDU,
+  .xor_mask        = 0x00U,
+  .has_leading_end = false,
+};
+
+static const buf_escape_codec_t buf_hdlc = {
+  .end             = 0x7EU,
+  .esc             = 0x7DU,
+  .esc_end         = 0x5EU,
+  .esc_esc         = 0x5DU,
+  .xor_mask        = 0x20U,
+  .has_leading_end = true,
+};
+
+// --- Private function
+
+static bool buf_stuff_is_valid(const BUF_t* dst, const BUF_t* src);
+static BUF_StuffStatus_t buf_stuff_append(BUF_t* dst,
+                                          BUF_StuffDecoder_t* decoder,
+                                          const uint8_t* data,
+                                          BUF_size_t size);
+static void
+buf_stuff_discard(BUF_t* src, BUF_StuffDecoder_t* decoder, uint8_t end);
+static void buf_stuff_account(BUF_t* dst,
+                              BUF_size_t write_start,
+                              BUF_t* src,
+                              BUF_size_t read_start);
+static BUF_size_t
+buf_escape_encode(BUF_t* dst, BUF_t* src, const buf_escape_codec_t* codec);
+static BUF_StuffStatus_t buf_escape_decode(BUF_t* dst,
+                                           BUF_t* src,
+                                           BUF_StuffDecoder_t* decoder,
+                                           const buf_escape_codec_t* codec);
+
+// --- Public functions
+
+void BUF_StuffDecoderInit(BUF_StuffDecoder_t* decoder)
+{
+  if (decoder != NULL)
+  {
+    decoder->length          = 0;
+    decoder->run             = 0;
+    decoder->is_zero_pending = false;
+    decoder->is_escaped      = false;
+    decoder->is_discarding   = false;
+  }
+}
+
+/**
+ * \details Blocks are up to 254 plain bytes after a code byte, code is block
+ * size + 1. A block ended by a source zero consumes it, a full block (code
+ * 0xFF) does not. The zero found by BUF_FindByte is kept until reached so
+ * that long zero-free data is scanned once
+ */
+BUF_size_t BUF_CobsEncode(BUF_t* dst, BUF_t* src)
+{
+  BUF_size_t encoded = 0;
+  if (buf_stuff_is_valid(dst, src))
+  {
+    BUF_size_t read_start = src->read_index;
+    BUF_size_t out        = dst->write_index;
+    BUF_size_t next_zero  = BUF_FindByte(src, BUF_COBS_DELIMITER);
+    bool is_ok            = true;
+    bool is_done          = false;
+
+    while (is_ok && !is_done)
+    {
+      BUF_size_t end = (next_zero != BUF_INDEX_NONE) ? next_zero
+                                                     : src->write_index;
+      BUF_size_t run = (BUF_size_t) (end - src->read_index);
+      run            = (run < BUF_COBS_RUN_MAX) ? run : BUF_COBS_RUN_MAX;
+      is_ok          = ((BUF_size_t) (dst->size - out) > run);
+      if (is_ok)
+      {
+        dst->data[out] = (uint8_t) (run + 1U);
+        memcpy(&dst->data[out + 1U], &src->data[src->read_index], run);
+        out                = (BUF_size_t) (out + run + 1U);
+        src->read_index    = (BUF_size_t) (src->read_index + run);
+        if (run == BUF_COBS_RUN_MAX)
+        {
+          is_done = (src->read_index == src->write_index);
+        }
+        else if (src->read_index == next_zero)
+        {
+          src->read_index++;
+          next_zero = BUF_FindByte(src, BUF_COBS_DELIMITER);
+        }
+        else
+        {
+          is_done = true;
+        }
+      }
+    }
+    is_ok = is_ok && (out < dst->size);
+    if (is_ok)
+    {
+      dst->data[out] = BUF_COBS_DELIMITER;
+      out++;
+      BUF_size_t write_start = dst->write_index;
+      dst->write_index       = out;
+      encoded                = (BUF_size_t) (out - write_start);
+      buf_stuff_account(dst, write_start, src, read_start);
+    }
+    else
+    {
+      src->read_index = read_start;
+      buf_on_write_failed(dst);
+    }
+  }
+  return encoded;
+}
+
+/**
+ * \details The zero of a block ended by a source zero is emitted when the
+ * next block starts, and dropped at the delimiter
+ */
+BUF_StuffStatus_t
+BUF_CobsDecode(BUF_t* dst, BUF_t* src, BUF_StuffDecoder_t* decoder)
+{
+  BUF_StuffStatus_t status = BUF_STUFF_ERROR;
+  if (buf_stuff_is_valid(dst, src) && (decoder != NULL))
+  {
+    BUF_size_t write_start = dst->write_index;
+    BUF_size_t read_start  = src->read_index;
+    const uint8_t zero     = 0;
+    status                 = BUF_STUFF_MORE;
+
+    while ((status == BUF_STUFF_MORE) && (src->read_index < src->write_index))
+    {
+      if (decoder->is_discarding)
+      {
+        buf_stuff_discard(src, decoder, BUF_COBS_DELIMITER);
+      }
+      else if (decoder->run == 0U)
+      {
+        uint8_t code = src->data[src->read_index];
+        src->read_index++;
+        if (code == BUF_COBS_DELIMITER)
+        {
+          status = (decoder->length > 0U) ? BUF_STUFF_FRAME : BUF_STUFF_MORE;
+          BUF_StuffDecoderInit(decoder);
+        }
+        else
+        {
+          if (decoder->is_zero_pending)
+          {
+            status = buf_stuff_append(dst, decoder, &zero, 1U);
+          }
+          if (status == BUF_STUFF_MORE)
+          {
+            decoder->is_zero_pending = (code != 0xFFU);
+            decoder->run             = (uint8_t) (code - 1U);
+          }
+        }
+      }
+      else
+      {
+        BUF_size_t count = BUF_GetToReadCount(src);
+        count = (count < decoder->run) ? count : (BUF_size_t) decoder->run;
+        const uint8_t* delimiter =
+          memchr(&src->data[src->read_index], BUF_COBS_DELIMITER, count);
+        if (delimiter != NULL)
+        {
+          // block cut by delimiter, frame truncated
+          src->read_index = (BUF_size_t) (delimiter - src->data + 1);
+          status          = BUF_STUFF_ERROR;
+          BUF_StuffDecoderInit(decoder);
+        }
+        else
+        {
+          status = buf_stuff_append(dst,
+                                    decoder,
+                                    &src->data[src->read_index],
+                                    count);
+          src->read_index = (BUF_size_t) (src->read_index + count);
+          decoder->run    = (uint8_t) (decoder->run - count);
+        }
+      }
+    }
+    buf_stuff_account(dst, write_start, src, read_start);
+  }
+  return status;
+}
+
+BUF_size_t BUF_SlipEncode(BUF_t* dst, BUF_t* src)
+{
+  return buf_escape_encode(dst, src, &buf_slip);
+}
+
+BUF_StuffStatus_t
+BUF_SlipDecode(BUF_t* dst, BUF_t* src, BUF_StuffDecoder_t* decoder)
+{
+  return buf_escape_decode(dst, src, decoder, &buf_slip);
+}
+
+BUF_size_t BUF_HdlcEncode(BUF_t* dst, BUF_t* src)
+{
+  return buf_escape_encode(dst, src, &buf_hdlc);
+}
+
+BUF_StuffStatus_t
+BUF_HdlcDecode(BUF_t* dst, BUF_t* src, BUF_StuffDecoder_t* decoder)
+{
+  return buf_escape_decode(dst, src, decoder, &buf_hdlc);
+}
+
+// --- Private functions
+
+/**
+ * \brief Check codec buffers
+ * \return true if both buffers and their data are not NULL
+ */
+static bool buf_stuff_is_valid(const BUF_t* dst, const BUF_t* src)
+{
+  return (dst != NULL) && (dst->data != NULL) && (src != NULL)
+         && (src->data != NULL);
+}
+
+/**
+ * \brief Append decoded bytes to frame
+ * \param dst Buffer to write to
+ * \param decoder Decoder, set discarding if dst is full
+ * \param data Decoded bytes
+ * \param size Byte count
+ * \return BUF_STUFF_MORE, BUF_STUFF_ERROR if dst is full
+ */
+static BUF_StuffStatus_t buf_stuff_append(BUF_t* dst,
+                                          BUF_StuffDecoder_t* decoder,
+                                          const uint8_t* data,
+                                          BUF_size_t size)
+{
+  BUF_StuffStatus_t status = BUF_STUFF_MORE;
+  if (BUF_GetFreeSize(dst) >= size)
+  {
+    memcpy(&dst->data[dst->write_index], data, size);
+    dst->write_index = (BUF_size_t) (dst->write_index + size);
+    decoder->length  = (BUF_size_t) (decoder->length + size);
+  }
+  else
+  {
+    BUF_StuffDecoderInit(decoder);
+    decoder->is_discarding = true;
+    buf_on_write_failed(dst);
+    status = BUF_STUFF_ERROR;
+  }
+  return status;
+}
+
+/**
+ * \brief Skip src to after next delimiter, decoder reset if found
+ */
+static void
+buf_stuff_discard(BUF_t* src, BUF_StuffDecoder_t* decoder, uint8_t end)
+{
+  BUF_size_t index = BUF_FindByte(src, end);
+  if (index == BUF_INDEX_NONE)
+  {
+    src->read_index = src->write_index;
+  }
+  else
+  {
+    src->read_index = (BUF_size_t) (index + 1U);
+    BUF_StuffDecoderInit(decoder);
+  }
+}
+
+/**
+ * \brief Run hooks for bytes written to dst and consumed from src by a call
+ * \param dst Buffer written, write_index already moved
+ * \param write_start write_index of dst before the call
+ * \param src Buffer read, read_index already moved
+ * \param read_start read_index of src before the call
+ */
+static void buf_stuff_account(BUF_t* dst,
+                              BUF_size_t write_start,
+                              BUF_t* src,
+                              BUF_size_t read_start)
+{
+  if (dst->write_index > write_start)
+  {
+    buf_on_write(dst, (BUF_size_t) (dst->write_index - write_start));
+  }
+  if (src->read_index > read_start)
+  {
+    buf_on_read(src, (BUF_size_t) (src->read_index - read_start));
+  }
+}
+
+/**
+ * \brief Append escaped frame, SLIP or HDLC
+ * \param dst Buffer to write to
+ * \param src Buffer to read from
+ * \param codec Delimiter and escape bytes
+ * \return encoded byte count, 0 if error
+ */
+static BUF_size_t
+buf_escape_encode(BUF_t* dst, BUF_t* src, const buf_escape_codec_t* codec)
+{
+  BUF_size_t encoded = 0;
+  if (buf_stuff_is_valid(dst, src))
+  {
+    const uint8_t specials[2] = {codec->end, codec->esc};
+    BUF_size_t read_start     = src->read_index;
+    BUF_size_t out            = dst->write_index;
+    bool is_ok                = true;
+
+    if (codec->has_leading_end)
+    {
+      is_ok = (out < dst->size);
+      if (is_ok)
+      {
+        dst->data[out] = codec->end;
+        out++;
+      }
+    }
+    while (is_ok && (src->read_index < src->write_index))
+    {
+      BUF_size_t index = BUF_FindAnyOf(src, specials, sizeof(specials));
+      BUF_size_t end = (index != BUF_INDEX_NONE) ? index : src->write_index;
+      BUF_size_t run = (BUF_size_t) (end - src->read_index);
+      is_ok          = ((BUF_size_t) (dst->size - out) >= run);
+      if (is_ok)
+      {
+        memcpy(&dst->data[out], &src->data[src->read_index], run);
+        out             = (BUF_size_t) (out + run);
+        src->read_index = end;
+      }
+      if (is_ok && (index != BUF_INDEX_NONE))
+      {
+        is_ok = ((BUF_size_t) (dst->size - out) >= 2U);
+        if (is_ok)
+        {
+          dst->data[out]      = codec->esc;
+          dst->data[out + 1U] = (src->data[index] == codec->end)
+                                  ? codec->esc_end
+                                  : codec->esc_esc;
+          out                 = (BUF_size_t) (out + 2U);
+          src->read_index++;
+        }
+      }
+    }
+    is_ok = is_ok && (out < dst->size);
+    if (is_ok)
+    {
+      BUF_size_t write_start = dst->write_index;
+      dst->data[out]         = codec->end;
+      dst->write_index       = (BUF_size_t) (out + 1U);
+      encoded                = (BUF_size_t) (dst->write_index - write_start);
+      buf_stuff_account(dst, write_start, src, read_start);
+    }
+    else
+    {
+      src->read_index = read_start;
+      buf_on_write_failed(dst);
+    }
+  }
+  return encoded;
+}
+
+/**
+ * \brief Decode escaped frame, SLIP or HDLC
+ * \param dst Buffer to write frame to
+ * \param src Buffer to read from
+ * \param decoder Decoder state
+ * \param codec Delimiter and escape bytes
+ * \return Decode status, see BUF_CobsDecode
+ */
+static BUF_StuffStatus_t buf_escape_decode(BUF_t* dst,
+                                           BUF_t* src,
+                                           BUF_StuffDecoder_t* decoder,
+                                           const buf_escape_codec_t* codec)
+{
+  BUF_StuffStatus_t status = BUF_STUFF_ERROR;
+  if (buf_stuff_is_valid(dst, src) && (decoder != NULL))
+  {
+    const uint8_t specials[2] = {codec->end, codec->esc};
+    BUF_size_t write_start    = dst->write_index;
+    BUF_size_t read_start     = src->read_index;
+    status                    = BUF_STUFF_MORE;
+
+    while ((status == BUF_STUFF_MORE) && (src->read_index < src->write_index))
+    {
+      if (decoder->is_discarding)
+      {
+        buf_stuff_discard(src, decoder, codec->end);
+      }
+      else if (decoder->is_escaped)
+      {
+        uint8_t value = src->data[src->read_index];
+        src->read_index++;
+        decoder->is_escaped = false;
+        if (value == codec->end)
+        {
+          // escape then delimiter, frame aborted
+          status = BUF_STUFF_ERROR;
+          BUF_StuffDecoderInit(decoder);
+        }
+        else
+        {
+          if (value == codec->esc_end)
+          {
+            value = codec->end;
+          }
+          else if (value == codec->esc_esc)
+          {
+            value = codec->esc;
+          }
+          else
+          {
+            value ^= codec->xor_mask;
+          }
+          status = buf_stuff_append(dst, decoder, &value, 1U);
+        }
+      }
+      else
+      {
+        BUF_size_t index = BUF_FindAnyOf(src, specials, sizeof(specials));
+        BUF_size_t end = (index != BUF_INDEX_NONE) ? index : src->write_index;
+        status         = buf_stuff_append(dst,
+                                  decoder,
+                                  &src->data[src->read_index],
+                                  (BUF_size_t) (end - src->read_index));
+        src->read_index = end;
+        if ((status == BUF_STUFF_MORE) && (index != BUF_INDEX_NONE))
+        {
+          src->read_index++;
+          if (src->data[index] == codec->esc)
+          {
+            decoder->is_escaped = true;
+          }
+          else
+          {
+            status = (decoder->length > 0U) ? BUF_STUFF_FRAME : BUF_STUFF_MORE;
+            BUF_StuffDecoderInit(decoder);
+          }
+        }
+      }
+    }
+    buf_stuff_account(dst, write_start, src, read_start);
+  }
+  return status;
+}
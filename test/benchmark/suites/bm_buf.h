@@ -0,0 +1,30 @@
+//! \file bm_buf.h
+//! \brief Buffer benchmark, common helpers
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+//! \brief Largest payload, fits uint16_t BUF_size_t
+constexpr std::int64_t BM_BUF_MAX_SIZE = 32768;
+
+/**
+ * \brief Payload size sweep, 64 B to 32 KiB
+ */
+static inline void bm_buf_sizes(benchmark::internal::Benchmark* bench)
+{
+  bench->RangeMultiplier(8)->Range(64, BM_BUF_MAX_SIZE);
+}
+
+/**
+ * \brief Report items/s and bytes/s from per-iteration counts
+ */
+static inline void bm_buf_report(benchmark::State& state, std::int64_t items, std::int64_t bytes)
+{
+  state.SetItemsProcessed(state.iterations() * items);
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
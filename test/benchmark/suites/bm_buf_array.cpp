@@ -0,0 +1,109 @@
+//! \file bm_buf_array.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+/**
+ * \brief Write whole array in one call
+ */
+template <typename T, BUF_size_t (*WriteArray)(BUF_t*, const T*, BUF_size_t)>
+static void BM_WriteArray(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  std::vector<T> values(data.size() / sizeof(T), static_cast<T>(0x0123456789ABCDEF));
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    WriteArray(&buf, values.data(), values.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, values.size(), values.size() * sizeof(T));
+}
+
+/**
+ * \brief Read whole array in one call
+ */
+template <typename T, BUF_size_t (*ReadArray)(BUF_t*, T*, BUF_size_t)>
+static void BM_ReadArray(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  std::vector<T> values(data.size() / sizeof(T));
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&buf);
+    ReadArray(&buf, values.data(), values.size());
+    benchmark::DoNotOptimize(values.data());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, values.size(), values.size() * sizeof(T));
+}
+
+/**
+ * \brief Store whole array at index 0 in one call
+ */
+template <typename T, BUF_size_t (*PutArray)(BUF_t*, const T*, BUF_size_t, BUF_size_t)>
+static void BM_PutArray(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  std::vector<T> values(data.size() / sizeof(T), static_cast<T>(0x0123456789ABCDEF));
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    PutArray(&buf, values.data(), values.size(), 0);
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, values.size(), values.size() * sizeof(T));
+}
+
+/**
+ * \brief Load whole array from index 0 in one call
+ */
+template <typename T, BUF_size_t (*GetArray)(const BUF_t*, T*, BUF_size_t, BUF_size_t)>
+static void BM_GetArray(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  std::vector<T> values(data.size() / sizeof(T));
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    GetArray(&buf, values.data(), values.size(), 0);
+    benchmark::DoNotOptimize(values.data());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, values.size(), values.size() * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(BM_WriteArray, std::uint16_t, BUF_WriteUint16Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_WriteArray, std::uint32_t, BUF_WriteUint32Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_WriteArray, float, BUF_WriteFloat32Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_WriteArray, double, BUF_WriteFloat64Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_WriteArray, float, BUF_WriteFloat32ArrayLE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_WriteArray, double, BUF_WriteFloat64ArrayLE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArray, std::uint16_t, BUF_ReadUint16Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArray, std::uint32_t, BUF_ReadUint32Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArray, float, BUF_ReadFloat32Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArray, double, BUF_ReadFloat64Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArray, float, BUF_ReadFloat32ArrayLE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArray, double, BUF_ReadFloat64ArrayLE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_PutArray, std::uint16_t, BUF_PutUint16Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_PutArray, std::uint32_t, BUF_PutUint32Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_GetArray, std::uint16_t, BUF_GetUint16Array)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_GetArray, std::uint32_t, BUF_GetUint32Array)->Apply(bm_buf_sizes);
@@ -0,0 +1,159 @@
+//! \file bm_buf_bits.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_bits.h"
+}
+
+/**
+ * \brief Put field MSB first, 32 bits accumulator drained byte by byte
+ */
+static inline void bm_bits_put_byte_loop(BUF_t* buf, std::uint32_t& acc, unsigned& count, unsigned size, std::uint32_t value)
+{
+  acc = (acc << size) | (value & ((1U << size) - 1U));
+  count += size;
+  while (count >= 8U)
+  {
+    count -= 8U;
+    BUF_WriteUint8(buf, static_cast<std::uint8_t>(acc >> count));
+  }
+}
+
+/**
+ * \brief MSB first fields, reference
+ */
+static void BM_BitWriteByteLoop(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  const std::size_t rounds = data.size() / 8U;
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    std::uint32_t acc = 0;
+    unsigned count    = 0;
+    BUF_Reset(&buf);
+    for (std::size_t i = 0; i < rounds; i++)
+    {
+      const std::uint32_t value = static_cast<std::uint32_t>(i);
+      bm_bits_put_byte_loop(&buf, acc, count, 3, value);
+      bm_bits_put_byte_loop(&buf, acc, count, 5, value);
+      bm_bits_put_byte_loop(&buf, acc, count, 12, value);
+      bm_bits_put_byte_loop(&buf, acc, count, 7, value);
+      bm_bits_put_byte_loop(&buf, acc, count, 1, value);
+      bm_bits_put_byte_loop(&buf, acc, count, 20, value);
+      bm_bits_put_byte_loop(&buf, acc, count, 9, value);
+      bm_bits_put_byte_loop(&buf, acc, count, 7, value);
+    }
+    benchmark::DoNotOptimize(buf);
+  }
+  bm_buf_report(state, rounds * 8U, data.size());
+}
+BENCHMARK(BM_BitWriteByteLoop)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Fields of 3 to 20 bits, 64 bits per round
+ */
+static void bm_bits_put(benchmark::State& state, BUF_BitOrder_t order)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  const std::size_t rounds = data.size() / 8U;
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_BitWriter_t writer;
+    BUF_Reset(&buf);
+    BUF_BitWriterInit(&writer, &buf, order);
+    for (std::size_t i = 0; i < rounds; i++)
+    {
+      BUF_BitWriterPutBits(&writer, 3, i);
+      BUF_BitWriterPutBits(&writer, 5, i);
+      BUF_BitWriterPutBits(&writer, 12, i);
+      BUF_BitWriterPutBits(&writer, 7, i);
+      BUF_BitWriterPutBits(&writer, 1, i);
+      BUF_BitWriterPutBits(&writer, 20, i);
+      BUF_BitWriterPutBits(&writer, 9, i);
+      BUF_BitWriterPutBits(&writer, 7, i);
+    }
+    BUF_BitWriterFlush(&writer);
+    benchmark::DoNotOptimize(buf);
+  }
+  bm_buf_report(state, rounds * 8U, data.size());
+}
+
+/**
+ * \brief Fields of 3 to 20 bits, 64 bits per round
+ */
+static void bm_bits_get(benchmark::State& state, BUF_BitOrder_t order)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  const std::size_t rounds = data.size() / 8U;
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_BitReader_t reader;
+    std::uint64_t sum = 0;
+    BUF_ResetReadIndex(&buf);
+    BUF_BitReaderInit(&reader, &buf, order);
+    for (std::size_t i = 0; i < rounds; i++)
+    {
+      sum += BUF_BitReaderGetBits(&reader, 3);
+      sum += BUF_BitReaderGetBits(&reader, 5);
+      sum += BUF_BitReaderGetBits(&reader, 12);
+      sum += BUF_BitReaderGetBits(&reader, 7);
+      sum += BUF_BitReaderGetBits(&reader, 1);
+      sum += BUF_BitReaderGetBits(&reader, 20);
+      sum += BUF_BitReaderGetBits(&reader, 9);
+      sum += BUF_BitReaderGetBits(&reader, 7);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, rounds * 8U, data.size());
+}
+
+/**
+ * \brief MSB first fields
+ */
+static void BM_BitWriterPutBits(benchmark::State& state)
+{
+  bm_bits_put(state, BUF_BIT_MSB_FIRST);
+}
+BENCHMARK(BM_BitWriterPutBits)->Apply(bm_buf_sizes);
+
+/**
+ * \brief LSB first fields
+ */
+static void BM_BitWriterPutBitsLsb(benchmark::State& state)
+{
+  bm_bits_put(state, BUF_BIT_LSB_FIRST);
+}
+BENCHMARK(BM_BitWriterPutBitsLsb)->Apply(bm_buf_sizes);
+
+/**
+ * \brief MSB first fields
+ */
+static void BM_BitReaderGetBits(benchmark::State& state)
+{
+  bm_bits_get(state, BUF_BIT_MSB_FIRST);
+}
+BENCHMARK(BM_BitReaderGetBits)->Apply(bm_buf_sizes);
+
+/**
+ * \brief LSB first fields
+ */
+static void BM_BitReaderGetBitsLsb(benchmark::State& state)
+{
+  bm_bits_get(state, BUF_BIT_LSB_FIRST);
+}
+BENCHMARK(BM_BitReaderGetBitsLsb)->Apply(bm_buf_sizes);
@@ -0,0 +1,147 @@
+//! \file bm_buf_chain.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_chain.h"
+}
+
+/**
+ * \brief Chain of range(0) bytes split in segments of range(1) bytes
+ */
+class BM_Chain : public benchmark::Fixture
+{
+public:
+  void SetUp(const benchmark::State& state)
+  {
+    std::size_t size         = state.range(0);
+    std::size_t segment_size = state.range(1);
+    data.assign(size, 0x5A);
+    buffers.resize((size + segment_size - 1) / segment_size);
+    segments.resize(buffers.size());
+    BUF_ChainInit(&chain, segments.data(), segments.size());
+    for (std::size_t i = 0; i < buffers.size(); i++)
+    {
+      BUF_InitFull(&buffers[i], &data[i * segment_size], segment_size);
+      BUF_ChainAppend(&chain, &buffers[i]);
+    }
+  }
+
+  void Rewind()
+  {
+    for (auto& buffer : buffers)
+    {
+      BUF_ResetReadIndex(&buffer);
+    }
+  }
+
+  // attributes
+  std::vector<std::uint8_t> data;
+  std::vector<BUF_t> buffers;
+  std::vector<BUF_t*> segments;
+  BUF_Chain_t chain;
+};
+
+/**
+ * \brief Read whole chain as 4 bytes values, some straddle segments
+ */
+BENCHMARK_DEFINE_F(BM_Chain, ReadUint32)(benchmark::State& state)
+{
+  auto count = data.size() / sizeof(std::uint32_t);
+  for (auto _ : state)
+  {
+    std::uint32_t sum = 0;
+    Rewind();
+    for (auto i = count; i > 0; i--)
+    {
+      sum += BUF_ChainReadUint32(&chain);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, count, data.size());
+}
+BENCHMARK_REGISTER_F(BM_Chain, ReadUint32)->Args({4096, 1500})->Args({4096, 64})->Args({4096, 4096});
+
+/**
+ * \brief Read whole chain as 2 bytes and 1 byte values
+ */
+BENCHMARK_DEFINE_F(BM_Chain, ReadUint16Uint8)(benchmark::State& state)
+{
+  auto count = data.size() / 3;
+  for (auto _ : state)
+  {
+    std::uint32_t sum = 0;
+    Rewind();
+    for (auto i = count; i > 0; i--)
+    {
+      sum += BUF_ChainReadUint16(&chain);
+      sum += BUF_ChainReadUint8(&chain);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, count * 2, count * 3);
+}
+BENCHMARK_REGISTER_F(BM_Chain, ReadUint16Uint8)->Args({4096, 1500})->Args({4096, 64});
+
+/**
+ * \brief Copy whole chain to contiguous memory
+ */
+BENCHMARK_DEFINE_F(BM_Chain, ReadRaw)(benchmark::State& state)
+{
+  std::vector<std::uint8_t> out(data.size());
+  for (auto _ : state)
+  {
+    Rewind();
+    BUF_ChainReadRaw(&chain, out.data(), out.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK_REGISTER_F(BM_Chain, ReadRaw)->Args({4096, 1500})->Args({4096, 64})->Args({32768, 1500});
+
+/**
+ * \brief Export segments as iovec then consume them, no copy
+ */
+BENCHMARK_DEFINE_F(BM_Chain, ExportConsume)(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    Rewind();
+#if defined(BUF_CHAIN_HAS_IOVEC)
+    struct iovec iov[64];
+    benchmark::DoNotOptimize(BUF_ChainExportIovec(&chain, iov, 64));
+#endif
+    benchmark::DoNotOptimize(BUF_ChainGetToReadCount(&chain));
+    BUF_ChainConsume(&chain, data.size());
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK_REGISTER_F(BM_Chain, ExportConsume)->Args({4096, 1500})->Args({4096, 64});
+
+/**
+ * \brief Build a chain of range(0) segments
+ */
+static void BM_ChainAppend(benchmark::State& state)
+{
+  std::vector<BUF_t> buffers(state.range(0));
+  std::vector<BUF_t*> segments(buffers.size());
+  BUF_Chain_t chain;
+  BUF_ChainInit(&chain, segments.data(), segments.size());
+
+  for (auto _ : state)
+  {
+    BUF_ChainReset(&chain);
+    for (auto& buffer : buffers)
+    {
+      BUF_ChainAppend(&chain, &buffer);
+    }
+    benchmark::DoNotOptimize(BUF_ChainGetSegmentCount(&chain));
+  }
+  bm_buf_report(state, buffers.size(), 0);
+}
+BENCHMARK(BM_ChainAppend)->Arg(4)->Arg(64);
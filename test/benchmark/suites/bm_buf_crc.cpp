@@ -0,0 +1,78 @@
+//! \file bm_buf_crc.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_crc.h"
+}
+
+/**
+ * \brief CRC of data to read
+ */
+template <typename T, T (*Crc)(const BUF_t*)>
+static void BM_Crc(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  for (std::size_t i = 0; i < data.size(); i++)
+  {
+    data[i] = static_cast<std::uint8_t>(i * 31);
+  }
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(Crc(&buf));
+  }
+  bm_buf_report(state, 1, data.size());
+}
+
+/**
+ * \brief Append CRC to frame
+ */
+template <std::uint8_t (*WriteCrc)(BUF_t*)>
+static void BM_WriteCrc(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0) + 4, 0x5A);
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    BUF_FillPattern(&buf, 0x5A, state.range(0));
+    benchmark::DoNotOptimize(WriteCrc(&buf));
+  }
+  bm_buf_report(state, 1, state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Crc, std::uint16_t, BUF_Crc16Ccitt)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Crc, std::uint32_t, BUF_Crc32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Crc, std::uint32_t, BUF_Crc32c)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_WriteCrc, BUF_WriteCrc16Ccitt)->Arg(256)->Arg(1500);
+BENCHMARK_TEMPLATE(BM_WriteCrc, BUF_WriteCrc32)->Arg(256)->Arg(1500);
+BENCHMARK_TEMPLATE(BM_WriteCrc, BUF_WriteCrc32c)->Arg(256)->Arg(1500);
+
+/**
+ * \brief CRC of explicit range, 1 byte offset from data start
+ */
+static void BM_Crc32Range(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0) + 1, 0x5A);
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(BUF_Crc32Range(&buf, 1, state.range(0)));
+    benchmark::DoNotOptimize(BUF_Crc32cRange(&buf, 1, state.range(0)));
+    benchmark::DoNotOptimize(BUF_Crc16CcittRange(&buf, 1, state.range(0)));
+  }
+  bm_buf_report(state, 3, state.range(0) * 3);
+}
+BENCHMARK(BM_Crc32Range)->Arg(1500);
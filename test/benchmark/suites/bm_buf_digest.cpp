@@ -0,0 +1,92 @@
+//! \file bm_buf_digest.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_crc.h"
+#include "buffer/buffer_digest.h"
+}
+
+/**
+ * \brief Write frame of 4 bytes values then checksum it in a second pass,
+ * baseline of the running digest
+ */
+static void BM_WriteThenCrc32(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  auto count = data.size() / sizeof(std::uint32_t);
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    for (auto i = count; i > 0; i--)
+    {
+      BUF_WriteUint32(&buf, static_cast<std::uint32_t>(i));
+    }
+    benchmark::DoNotOptimize(BUF_Crc32(&buf));
+  }
+  bm_buf_report(state, count, data.size());
+}
+BENCHMARK(BM_WriteThenCrc32)->Apply(bm_buf_sizes);
+
+#if defined(BUF_DIGEST_ENABLE)
+/**
+ * \brief Write frame of 4 bytes values with running digest attached
+ */
+template <BUF_DigestType_t Type>
+static void BM_WriteDigest(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  auto count = data.size() / sizeof(std::uint32_t);
+  BUF_t buf;
+  BUF_Digest_t digest;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  BUF_DigestInit(&digest, Type);
+  BUF_AttachDigest(&buf, &digest);
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    for (auto i = count; i > 0; i--)
+    {
+      BUF_WriteUint32(&buf, static_cast<std::uint32_t>(i));
+    }
+    benchmark::DoNotOptimize(BUF_FinalizeDigest(&buf));
+  }
+  bm_buf_report(state, count, data.size());
+}
+BENCHMARK_TEMPLATE(BM_WriteDigest, BUF_DIGEST_CRC32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_WriteDigest, BUF_DIGEST_FLETCHER16)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Write raw payload with running digest attached
+ */
+template <BUF_DigestType_t Type>
+static void BM_WriteRawDigest(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  std::vector<std::uint8_t> payload(data.size(), 0x5A);
+  BUF_t buf;
+  BUF_Digest_t digest;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  BUF_DigestInit(&digest, Type);
+  BUF_AttachDigest(&buf, &digest);
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    BUF_WriteRaw(&buf, payload.data(), payload.size());
+    benchmark::DoNotOptimize(BUF_FinalizeDigest(&buf));
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK_TEMPLATE(BM_WriteRawDigest, BUF_DIGEST_CRC32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_WriteRawDigest, BUF_DIGEST_FLETCHER16)->Apply(bm_buf_sizes);
+#endif
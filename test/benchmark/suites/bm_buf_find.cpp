@@ -0,0 +1,159 @@
+//! \file bm_buf_find.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <cstring>
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+/**
+ * \brief Terminator in last byte, before BUF_FindByte
+ */
+static void BM_FindByteGetLoop(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 'a');
+  data.back() = '\n';
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_size_t index = BUF_GetReadIndex(&buf);
+    while ((index < data.size()) && (BUF_GetUint8(&buf, index) != '\n'))
+    {
+      index++;
+    }
+    benchmark::DoNotOptimize(index);
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_FindByteGetLoop)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Terminator in last byte, reference
+ */
+static void BM_FindByteMemchr(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 'a');
+  data.back() = '\n';
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(std::memchr(data.data(), '\n', data.size()));
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_FindByteMemchr)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Terminator in last byte
+ */
+static void BM_FindByte(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 'a');
+  data.back() = '\n';
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(BUF_FindByte(&buf, '\n'));
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_FindByte)->Apply(bm_buf_sizes);
+
+/**
+ * \brief One of 4 separators in last byte
+ */
+static void BM_FindAnyOf(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 'a');
+  data.back()              = ';';
+  const std::uint8_t set[] = {'\r', '\n', ',', ';'};
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(BUF_FindAnyOf(&buf, set, sizeof(set)));
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_FindAnyOf)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Boundary at end, first byte frequent in text, reference
+ */
+static void BM_FindPatternMemmem(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 'a');
+  for (std::size_t i = 0; i < data.size(); i += 8)
+  {
+    data[i] = '-';
+  }
+  std::memcpy(&data[data.size() - 8], "--bound\n", 8);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(memmem(data.data(), data.size(), "--bound\n", 8));
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_FindPatternMemmem)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Boundary at end, first byte frequent in text
+ */
+static void BM_FindPattern(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 'a');
+  for (std::size_t i = 0; i < data.size(); i += 8)
+  {
+    data[i] = '-';
+  }
+  std::memcpy(&data[data.size() - 8], "--bound\n", 8);
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(BUF_FindPattern(&buf, reinterpret_cast<const std::uint8_t*>("--bound\n"), 8));
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_FindPattern)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Split 64 bytes CRLF lines
+ */
+static void BM_NextFrame(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 'a');
+  for (std::size_t i = 62; (i + 1) < data.size(); i += 64)
+  {
+    data[i]     = '\r';
+    data[i + 1] = '\n';
+  }
+  const std::uint8_t crlf[] = {'\r', '\n'};
+  BUF_t buf;
+  BUF_t frame;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&buf);
+    while (BUF_NextFrame(&buf, &frame, crlf, sizeof(crlf)))
+    {
+      benchmark::DoNotOptimize(frame);
+    }
+  }
+  bm_buf_report(state, data.size() / 64, data.size());
+}
+BENCHMARK(BM_NextFrame)->Apply(bm_buf_sizes);
@@ -0,0 +1,222 @@
+//! \file bm_buf_pack.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_pack.h"
+#if defined(BUF_STATS_ENABLE)
+#include "buffer/buffer_stats.h"
+#endif
+}
+
+typedef struct {
+  std::uint16_t id;
+  std::uint16_t flags;
+  std::uint32_t timestamp;
+  std::int16_t axis[3];
+  std::uint32_t value;
+  std::uint64_t sequence;
+} bm_msg_t;
+
+#define BM_MSG_FIELDS(X)                         \
+  X(id, BUF_FIELD_UINT16, BUF_ENDIAN_BIG)        \
+  X(flags, BUF_FIELD_UINT16, BUF_ENDIAN_BIG)     \
+  X(timestamp, BUF_FIELD_UINT32, BUF_ENDIAN_BIG) \
+  X(axis, BUF_FIELD_UINT16, BUF_ENDIAN_LITTLE)   \
+  X(value, BUF_FIELD_UINT32, BUF_ENDIAN_LITTLE)  \
+  X(sequence, BUF_FIELD_UINT64, BUF_ENDIAN_BIG)
+
+BUF_PACK_DEFINE(BmMsg, bm_msg_t, BM_MSG_FIELDS)
+
+//! \brief Packed message size
+constexpr std::size_t BM_MSG_SIZE = 26;
+
+/**
+ * \brief Message with distinct field values
+ */
+static bm_msg_t bm_msg(void)
+{
+  bm_msg_t msg = {0x1234, 0x0001, 0x89ABCDEF, {1, -2, 3}, 0xCAFE, 0x1122334455667788ULL};
+  return msg;
+}
+
+/**
+ * \brief Write one message field by field
+ */
+static void bm_write_fields(BUF_t* buf, const bm_msg_t& msg)
+{
+  BUF_WriteUint16(buf, msg.id);
+  BUF_WriteUint16(buf, msg.flags);
+  BUF_WriteUint32(buf, msg.timestamp);
+  BUF_WriteUint16LE(buf, static_cast<std::uint16_t>(msg.axis[0]));
+  BUF_WriteUint16LE(buf, static_cast<std::uint16_t>(msg.axis[1]));
+  BUF_WriteUint16LE(buf, static_cast<std::uint16_t>(msg.axis[2]));
+  BUF_WriteUint32LE(buf, msg.value);
+  BUF_WriteUint64(buf, msg.sequence);
+}
+
+/**
+ * \brief Write messages field by field, reference
+ */
+static void BM_PackFieldByField(benchmark::State& state)
+{
+  std::size_t count = state.range(0) / BM_MSG_SIZE;
+  std::vector<std::uint8_t> data(state.range(0));
+  bm_msg_t msg = bm_msg();
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    for (std::size_t i = 0; i < count; i++)
+    {
+      bm_write_fields(&buf, msg);
+    }
+    benchmark::DoNotOptimize(data.data());
+  }
+  bm_buf_report(state, count, count * BM_MSG_SIZE);
+}
+BENCHMARK(BM_PackFieldByField)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Write messages with generated functions
+ */
+static void BM_Pack(benchmark::State& state)
+{
+  std::size_t count = state.range(0) / BM_MSG_SIZE;
+  std::vector<std::uint8_t> data(state.range(0));
+  bm_msg_t msg = bm_msg();
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    for (std::size_t i = 0; i < count; i++)
+    {
+      BmMsgPack(&buf, &msg);
+    }
+    benchmark::DoNotOptimize(data.data());
+  }
+  bm_buf_report(state, count, count * BM_MSG_SIZE);
+}
+BENCHMARK(BM_Pack)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Read messages field by field, reference
+ */
+static void BM_UnpackFieldByField(benchmark::State& state)
+{
+  std::size_t count = state.range(0) / BM_MSG_SIZE;
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  bm_msg_t msg;
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&buf);
+    for (std::size_t i = 0; i < count; i++)
+    {
+      msg.id        = BUF_ReadUint16(&buf);
+      msg.flags     = BUF_ReadUint16(&buf);
+      msg.timestamp = BUF_ReadUint32(&buf);
+      msg.axis[0]   = static_cast<std::int16_t>(BUF_ReadUint16LE(&buf));
+      msg.axis[1]   = static_cast<std::int16_t>(BUF_ReadUint16LE(&buf));
+      msg.axis[2]   = static_cast<std::int16_t>(BUF_ReadUint16LE(&buf));
+      msg.value     = BUF_ReadUint32LE(&buf);
+      msg.sequence  = BUF_ReadUint64(&buf);
+      benchmark::DoNotOptimize(msg);
+    }
+  }
+  bm_buf_report(state, count, count * BM_MSG_SIZE);
+}
+BENCHMARK(BM_UnpackFieldByField)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Read messages with generated functions
+ */
+static void BM_Unpack(benchmark::State& state)
+{
+  std::size_t count = state.range(0) / BM_MSG_SIZE;
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  bm_msg_t msg;
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&buf);
+    for (std::size_t i = 0; i < count; i++)
+    {
+      BmMsgUnpack(&buf, &msg);
+      benchmark::DoNotOptimize(msg);
+    }
+  }
+  bm_buf_report(state, count, count * BM_MSG_SIZE);
+}
+BENCHMARK(BM_Unpack)->Apply(bm_buf_sizes);
+
+#if defined(BUF_STATS_ENABLE)
+/**
+ * \brief Write messages field by field with stats attached, one hook per
+ * field
+ */
+static void BM_PackFieldByFieldStats(benchmark::State& state)
+{
+  std::size_t count = state.range(0) / BM_MSG_SIZE;
+  std::vector<std::uint8_t> data(state.range(0));
+  bm_msg_t msg = bm_msg();
+  BUF_Stats_t stats;
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  BUF_StatsInit(&stats);
+  BUF_AttachStats(&buf, &stats);
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    for (std::size_t i = 0; i < count; i++)
+    {
+      bm_write_fields(&buf, msg);
+    }
+    benchmark::DoNotOptimize(data.data());
+  }
+  bm_buf_report(state, count, count * BM_MSG_SIZE);
+}
+BENCHMARK(BM_PackFieldByFieldStats)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Write messages with generated functions and stats attached, one hook
+ * per message
+ */
+static void BM_PackStats(benchmark::State& state)
+{
+  std::size_t count = state.range(0) / BM_MSG_SIZE;
+  std::vector<std::uint8_t> data(state.range(0));
+  bm_msg_t msg = bm_msg();
+  BUF_Stats_t stats;
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  BUF_StatsInit(&stats);
+  BUF_AttachStats(&buf, &stats);
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    for (std::size_t i = 0; i < count; i++)
+    {
+      BmMsgPack(&buf, &msg);
+    }
+    benchmark::DoNotOptimize(data.data());
+  }
+  bm_buf_report(state, count, count * BM_MSG_SIZE);
+}
+BENCHMARK(BM_PackStats)->Apply(bm_buf_sizes);
+#endif
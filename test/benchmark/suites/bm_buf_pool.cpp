@@ -0,0 +1,94 @@
+//! \file bm_buf_pool.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <cstdlib>
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_pool.h"
+}
+
+constexpr BUF_size_t BM_POOL_DATA_SIZE    = 1500;
+constexpr std::size_t BM_POOL_BLOCK_COUNT = 64;
+
+/**
+ * \brief Pool of BM_POOL_BLOCK_COUNT buffers
+ */
+class BM_Pool : public benchmark::Fixture
+{
+public:
+  void SetUp(const benchmark::State&)
+  {
+    BUF_PoolInit(&pool, arena, sizeof(arena), BM_POOL_DATA_SIZE);
+  }
+
+  // attributes
+  BUF_Pool_t pool;
+  alignas(BUF_POOL_ALIGNMENT) std::uint8_t arena[BUF_POOL_ARENA_SIZE(BM_POOL_BLOCK_COUNT, BM_POOL_DATA_SIZE)];
+};
+
+/**
+ * \brief Acquire then release range(0) buffers
+ */
+BENCHMARK_DEFINE_F(BM_Pool, AcquireRelease)(benchmark::State& state)
+{
+  std::vector<BUF_t*> buffers(state.range(0));
+  for (auto _ : state)
+  {
+    for (auto& buffer : buffers)
+    {
+      buffer = BUF_PoolAcquire(&pool);
+    }
+    for (auto buffer : buffers)
+    {
+      BUF_PoolRelease(&pool, buffer);
+    }
+  }
+  bm_buf_report(state, buffers.size() * 2, 0);
+}
+BENCHMARK_REGISTER_F(BM_Pool, AcquireRelease)->Arg(1)->Arg(BM_POOL_BLOCK_COUNT);
+
+#if defined(BUF_POOL_ATOMIC_ENABLE)
+/**
+ * \brief Lock-free variant, per thread acquire then release
+ */
+BENCHMARK_DEFINE_F(BM_Pool, AcquireReleaseAtomic)(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    BUF_t* buffer = BUF_PoolAcquireAtomic(&pool);
+    benchmark::DoNotOptimize(buffer);
+    BUF_PoolReleaseAtomic(&pool, buffer);
+  }
+  benchmark::DoNotOptimize(BUF_PoolGetUsedCount(&pool) + BUF_PoolGetHighWaterMark(&pool)
+                           + BUF_PoolGetFailedCount(&pool) + BUF_PoolGetBlockCount(&pool));
+  bm_buf_report(state, 2, 0);
+}
+BENCHMARK_REGISTER_F(BM_Pool, AcquireReleaseAtomic)->ThreadRange(1, 4)->UseRealTime();
+#endif
+
+/**
+ * \brief Reference, malloc and BUF_InitEmpty per message
+ */
+static void BM_PoolMallocReference(benchmark::State& state)
+{
+  std::vector<BUF_t*> buffers(state.range(0));
+  for (auto _ : state)
+  {
+    for (auto& buffer : buffers)
+    {
+      buffer = static_cast<BUF_t*>(std::malloc(sizeof(BUF_t) + BM_POOL_DATA_SIZE));
+      BUF_InitEmpty(buffer, reinterpret_cast<std::uint8_t*>(buffer + 1), BM_POOL_DATA_SIZE);
+    }
+    for (auto buffer : buffers)
+    {
+      std::free(buffer);
+    }
+  }
+  bm_buf_report(state, buffers.size() * 2, 0);
+}
+BENCHMARK(BM_PoolMallocReference)->Arg(1)->Arg(BM_POOL_BLOCK_COUNT);
@@ -0,0 +1,298 @@
+//! \file bm_buf_raw.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <cstring>
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+/**
+ * \brief Write raw payload
+ */
+static void BM_WriteRaw(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  std::vector<std::uint8_t> payload(data.size(), 0x5A);
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    BUF_WriteRaw(&buf, payload.data(), payload.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, payload.size());
+}
+BENCHMARK(BM_WriteRaw)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Receive through scratch array then BUF_WriteRaw, before zero-copy
+ */
+static void BM_ReceiveScratch(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  std::vector<std::uint8_t> scratch(data.size());
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    std::memset(scratch.data(), 0x5A, scratch.size());
+    BUF_WriteRaw(&buf, scratch.data(), scratch.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_ReceiveScratch)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Receive in place with BUF_Reserve and BUF_Commit
+ */
+static void BM_ReceiveReserveCommit(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_size_t size = 0;
+    BUF_Reset(&buf);
+    std::memset(BUF_Reserve(&buf, &size), 0x5A, size);
+    BUF_Commit(&buf, size);
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_ReceiveReserveCommit)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Drain byte by byte with BUF_ReadUint8, before bulk read
+ */
+static void BM_ReadUint8Loop(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  std::vector<std::uint8_t> dst(data.size());
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&buf);
+    for (std::size_t i = 0; i < dst.size(); i++)
+    {
+      dst[i] = BUF_ReadUint8(&buf);
+    }
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_ReadUint8Loop)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Drain with one BUF_ReadRaw
+ */
+static void BM_ReadRaw(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  std::vector<std::uint8_t> dst(data.size());
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&buf);
+    BUF_ReadRaw(&buf, dst.data(), dst.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_ReadRaw)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Parse in place with BUF_Peek and BUF_Consume, no copy
+ */
+static void BM_PeekConsume(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_size_t size = 0;
+    BUF_ResetReadIndex(&buf);
+    const std::uint8_t* bytes = BUF_Peek(&buf, &size);
+    benchmark::DoNotOptimize(bytes[size - 1]);
+    BUF_Consume(&buf, size);
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_PeekConsume)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Streaming reader, 64 bytes received, 48 parsed, compaction
+ * threshold as argument, 0 compacts at each step
+ */
+static void BM_StreamCompact(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(4096);
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  std::uint8_t threshold = static_cast<std::uint8_t>(state.range(0));
+
+  for (auto _ : state)
+  {
+    BUF_size_t size   = 0;
+    std::uint8_t* dst = BUF_Reserve(&buf, &size);
+    if (size < 64)
+    {
+      BUF_Reset(&buf);
+      dst = BUF_Reserve(&buf, &size);
+    }
+    std::memset(dst, 0x5A, 64);
+    BUF_Commit(&buf, 64);
+    BUF_Consume(&buf, 48);
+    BUF_CompactIfNeeded(&buf, threshold);
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, 64);
+}
+BENCHMARK(BM_StreamCompact)->Arg(0)->Arg(BUF_COMPACT_THRESHOLD_DEFAULT);
+
+/**
+ * \brief Write string payload
+ */
+static void BM_WriteString(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  std::vector<char> payload(data.size(), 'a');
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    BUF_WriteString(&buf, payload.data(), payload.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, payload.size());
+}
+BENCHMARK(BM_WriteString)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Copy buffer to buffer
+ */
+static void BM_WriteCopy(benchmark::State& state)
+{
+  std::vector<std::uint8_t> dst_data(state.range(0));
+  std::vector<std::uint8_t> src_data(dst_data.size(), 0x5A);
+  BUF_t dst;
+  BUF_t src;
+  BUF_InitEmpty(&dst, dst_data.data(), dst_data.size());
+  BUF_InitFull(&src, src_data.data(), src_data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&dst);
+    BUF_ResetReadIndex(&src);
+    BUF_WriteCopy(&dst, &src, src_data.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, src_data.size());
+}
+BENCHMARK(BM_WriteCopy)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Fill buffer with pattern
+ */
+static void BM_FillPattern(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    BUF_FillPattern(&buf, 0x5A, data.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_FillPattern)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Compare equal buffer, worst case
+ */
+static void BM_Compare(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  std::vector<std::uint8_t> other(data);
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(BUF_Compare(&buf, other.data(), other.size()));
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_Compare)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Clear buffer data
+ */
+static void BM_Clear(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Clear(&buf);
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 1, data.size());
+}
+BENCHMARK(BM_Clear)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Buffer and view bookkeeping, no data access
+ */
+static void BM_Bookkeeping(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(64);
+  BUF_t buf;
+  BUF_t view;
+
+  for (auto _ : state)
+  {
+    BUF_InitEmpty(&buf, data.data(), data.size());
+    BUF_InitFull(&buf, data.data(), data.size());
+    BUF_MakeViewFull(&view, &buf, 8, 32);
+    BUF_MakeViewToRead(&view, &buf);
+    BUF_SetSize(&buf, 48);
+    BUF_SetAllRead(&buf);
+    BUF_ResetReadIndex(&buf);
+    BUF_Reset(&buf);
+    BUF_SetEndian(&buf, BUF_ENDIAN_LITTLE);
+    benchmark::DoNotOptimize(BUF_GetEndian(&buf));
+    benchmark::DoNotOptimize(BUF_GetSize(&buf) + BUF_GetFreeSize(&buf) + BUF_GetUsedSize(&buf)
+                             + BUF_GetToReadCount(&view) + BUF_GetReadIndex(&buf) + BUF_IsEmpty(&buf)
+                             + BUF_IsFull(&buf) + BUF_GetLastUint8(&view));
+    benchmark::DoNotOptimize(BUF_GetData(&view));
+    benchmark::DoNotOptimize(BUF_GetDataNoConst(&view));
+  }
+  bm_buf_report(state, 1, 0);
+}
+BENCHMARK(BM_Bookkeeping);
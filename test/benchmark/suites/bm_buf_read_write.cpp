@@ -0,0 +1,149 @@
+//! \file bm_buf_read_write.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_inline.h"
+}
+
+/**
+ * \brief Fill buffer with Write accessor, one value after the other
+ */
+template <typename T, std::uint8_t (*Write)(BUF_t*, T)>
+static void BM_Write(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  auto count = data.size() / sizeof(T);
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    for (auto i = count; i > 0; i--)
+    {
+      Write(&buf, static_cast<T>(i));
+    }
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, count, count * sizeof(T));
+}
+
+/**
+ * \brief Read whole buffer with Read accessor
+ */
+template <typename T, T (*Read)(BUF_t*)>
+static void BM_Read(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  auto count = data.size() / sizeof(T);
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    T sum = 0;
+    BUF_ResetReadIndex(&buf);
+    for (auto i = count; i > 0; i--)
+    {
+      sum += Read(&buf);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, count, count * sizeof(T));
+}
+
+/**
+ * \brief Store at each index with Put accessor
+ */
+template <typename T, std::uint8_t (*Put)(BUF_t*, T, BUF_size_t)>
+static void BM_Put(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  auto count = data.size() / sizeof(T);
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < count; i++)
+    {
+      Put(&buf, static_cast<T>(i), static_cast<BUF_size_t>(i * sizeof(T)));
+    }
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, count, count * sizeof(T));
+}
+
+/**
+ * \brief Load at each index with Get accessor
+ */
+template <typename T, T (*Get)(const BUF_t*, BUF_size_t)>
+static void BM_Get(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0), 0x5A);
+  auto count = data.size() / sizeof(T);
+  BUF_t buf;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    T sum = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+      sum += Get(&buf, static_cast<BUF_size_t>(i * sizeof(T)));
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, count, count * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(BM_Write, std::uint8_t, BUF_WriteUint8)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint16_t, BUF_WriteUint16)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint32_t, BUF_WriteUint32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint64_t, BUF_WriteUint64)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint16_t, BUF_WriteUint16LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint32_t, BUF_WriteUint32LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint64_t, BUF_WriteUint64LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint16_t, BUF_WriteUint16Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint32_t, BUF_WriteUint32Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint64_t, BUF_WriteUint64Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, std::uint32_t, BUF_InlineWriteUint32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, float, BUF_WriteFloat32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Write, double, BUF_WriteFloat64)->Apply(bm_buf_sizes);
+
+BENCHMARK_TEMPLATE(BM_Read, std::uint8_t, BUF_ReadUint8)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint16_t, BUF_ReadUint16)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint32_t, BUF_ReadUint32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint16_t, BUF_ReadUint16LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint32_t, BUF_ReadUint32LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint16_t, BUF_ReadUint16Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint32_t, BUF_ReadUint32Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint32_t, BUF_InlineReadUint32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint64_t, BUF_ReadUint64)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, std::uint64_t, BUF_InlineReadUint64)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, float, BUF_ReadFloat32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Read, double, BUF_ReadFloat64)->Apply(bm_buf_sizes);
+
+BENCHMARK_TEMPLATE(BM_Put, std::uint8_t, BUF_PutUint8)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Put, std::uint16_t, BUF_PutUint16)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Put, std::uint32_t, BUF_PutUint32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Put, std::uint16_t, BUF_PutUint16LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Put, std::uint32_t, BUF_PutUint32LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Put, std::uint16_t, BUF_PutUint16Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Put, std::uint32_t, BUF_PutUint32Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Put, std::uint64_t, BUF_PutUint64)->Apply(bm_buf_sizes);
+
+BENCHMARK_TEMPLATE(BM_Get, std::uint8_t, BUF_GetUint8)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Get, std::uint16_t, BUF_GetUint16)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Get, std::uint32_t, BUF_GetUint32)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Get, std::uint16_t, BUF_GetUint16LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Get, std::uint32_t, BUF_GetUint32LE)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Get, std::uint16_t, BUF_GetUint16Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Get, std::uint32_t, BUF_GetUint32Auto)->Apply(bm_buf_sizes);
+BENCHMARK_TEMPLATE(BM_Get, std::uint64_t, BUF_GetUint64)->Apply(bm_buf_sizes);
@@ -0,0 +1,170 @@
+//! \file bm_buf_ring.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_ring.h"
+}
+
+#if defined(BUF_RING_ENABLE)
+
+/**
+ * \brief Fill then drain ring with 4 bytes values on one thread
+ */
+static void BM_RingWriteReadUint32(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  auto count = data.size() / sizeof(std::uint32_t);
+  BUF_Ring_t ring;
+  BUF_RingInit(&ring, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    std::uint32_t sum = 0;
+    for (auto i = count; i > 0; i--)
+    {
+      BUF_RingWriteUint32(&ring, static_cast<std::uint32_t>(i));
+    }
+    for (auto i = count; i > 0; i--)
+    {
+      sum += BUF_RingReadUint32(&ring);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, count * 2, data.size() * 2);
+}
+BENCHMARK(BM_RingWriteReadUint32)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Fill then drain ring with 1 byte values on one thread
+ */
+static void BM_RingWriteReadUint8(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(state.range(0));
+  BUF_Ring_t ring;
+  BUF_RingInit(&ring, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    std::uint32_t sum = 0;
+    for (auto i = data.size(); i > 0; i--)
+    {
+      BUF_RingWriteUint8(&ring, static_cast<std::uint8_t>(i));
+    }
+    for (auto i = data.size(); i > 0; i--)
+    {
+      sum += BUF_RingReadUint8(&ring);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, data.size() * 2, data.size() * 2);
+}
+BENCHMARK(BM_RingWriteReadUint8)->Apply(bm_buf_sizes);
+
+/**
+ * \brief Fill then drain ring with raw blocks of range(1) bytes, wrapping
+ */
+static void BM_RingWriteReadRaw(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data(4096);
+  std::vector<std::uint8_t> block(state.range(0), 0x5A);
+  BUF_Ring_t ring;
+  BUF_RingInit(&ring, data.data(), data.size());
+  BUF_RingWriteUint8(&ring, 0); // Offset so blocks wrap
+  BUF_RingReadUint8(&ring);
+
+  for (auto _ : state)
+  {
+    BUF_RingWriteRaw(&ring, block.data(), block.size());
+    BUF_RingReadRaw(&ring, block.data(), block.size());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, 2, block.size() * 2);
+}
+BENCHMARK(BM_RingWriteReadRaw)->RangeMultiplier(4)->Range(16, 4096);
+
+/**
+ * \brief One producer thread and one consumer thread through ring
+ * \details One iteration is one 64 bytes message written, a full ring is
+ * retried and not counted. Each reload of the other side index moves its
+ * cache line between cores: it happens when the cached copy does not cover
+ * the request, counted as a change of cached or a failed call
+ */
+static void BM_RingProducerConsumer(benchmark::State& state)
+{
+  constexpr std::size_t BLOCK_SIZE = 64;
+  std::vector<std::uint8_t> data(state.range(0));
+  BUF_Ring_t ring;
+  BUF_RingInit(&ring, data.data(), data.size());
+  std::atomic<bool> is_running{true};
+  std::int64_t consumer_reloads = 0;
+
+  std::thread consumer([&]() {
+    std::uint8_t block[BLOCK_SIZE];
+    BUF_size_t cached = ring.consumer.cached;
+    while (is_running.load(std::memory_order_relaxed) || !BUF_RingIsEmpty(&ring))
+    {
+      if (BUF_RingReadRaw(&ring, block, BLOCK_SIZE) == 0)
+      {
+        consumer_reloads++;
+        std::this_thread::yield();
+      }
+      else if (ring.consumer.cached != cached)
+      {
+        cached = ring.consumer.cached;
+        consumer_reloads++;
+      }
+    }
+  });
+
+  std::uint8_t block[BLOCK_SIZE] = {};
+  std::int64_t producer_reloads  = 0;
+  BUF_size_t cached              = ring.producer.cached;
+  for (auto _ : state)
+  {
+    while (BUF_RingWriteRaw(&ring, block, BLOCK_SIZE) == 0)
+    {
+      producer_reloads++;
+      std::this_thread::yield();
+    }
+    if (ring.producer.cached != cached)
+    {
+      cached = ring.producer.cached;
+      producer_reloads++;
+    }
+  }
+  is_running = false;
+  consumer.join();
+  bm_buf_report(state, 1, BLOCK_SIZE);
+  state.counters["producer_reloads"] = benchmark::Counter(producer_reloads, benchmark::Counter::kAvgIterations);
+  state.counters["consumer_reloads"] = benchmark::Counter(consumer_reloads, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RingProducerConsumer)->Arg(1024)->Arg(BM_BUF_MAX_SIZE)->UseRealTime();
+
+/**
+ * \brief Ring state queries
+ */
+static void BM_RingQuery(benchmark::State& state)
+{
+  std::uint8_t data[64];
+  BUF_Ring_t ring;
+  BUF_RingInit(&ring, data, sizeof(data));
+  BUF_RingWriteUint32(&ring, 0x01020304);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(BUF_RingGetSize(&ring) + BUF_RingGetFreeSize(&ring) + BUF_RingGetToReadCount(&ring)
+                             + BUF_RingIsEmpty(&ring) + BUF_RingIsFull(&ring));
+  }
+  bm_buf_report(state, 1, 0);
+}
+BENCHMARK(BM_RingQuery);
+
+#endif
@@ -0,0 +1,76 @@
+//! \file bm_buf_shared.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <mutex>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_shared.h"
+}
+
+#if defined(BUF_SHARED_ENABLE)
+
+//! \brief Log record size
+constexpr BUF_size_t BM_SHARED_RECORD_SIZE = 16;
+
+//! \brief Records appended by each thread, buffer fits 4 threads
+constexpr std::int64_t BM_SHARED_RECORD_COUNT = 1000;
+
+//! \brief Shared buffer size
+constexpr std::size_t BM_SHARED_SIZE = 4 * BM_SHARED_RECORD_COUNT * BM_SHARED_RECORD_SIZE;
+
+static std::uint8_t bm_shared_data[BM_SHARED_SIZE];
+static BUF_t bm_shared_buffer;
+static BUF_Shared_t bm_shared;
+static std::mutex bm_shared_mutex;
+
+/**
+ * \brief Reference, append behind a mutex
+ * \details Thread 0 empties the buffer before the timed loop, threads start
+ * the loop together
+ */
+static void BM_SharedMutexWriteRaw(benchmark::State& state)
+{
+  std::uint8_t record[BM_SHARED_RECORD_SIZE] = {};
+  if (state.thread_index() == 0)
+  {
+    BUF_InitEmpty(&bm_shared_buffer, bm_shared_data, sizeof(bm_shared_data));
+  }
+
+  for (auto _ : state)
+  {
+    std::lock_guard<std::mutex> lock(bm_shared_mutex);
+    benchmark::DoNotOptimize(BUF_WriteRaw(&bm_shared_buffer, record, sizeof(record)));
+  }
+  bm_buf_report(state, 1, BM_SHARED_RECORD_SIZE);
+}
+BENCHMARK(BM_SharedMutexWriteRaw)->ThreadRange(1, 4)->Iterations(BM_SHARED_RECORD_COUNT)->UseRealTime();
+
+/**
+ * \brief Append with atomic reservation
+ */
+static void BM_SharedWriteRaw(benchmark::State& state)
+{
+  std::uint8_t record[BM_SHARED_RECORD_SIZE] = {};
+  if (state.thread_index() == 0)
+  {
+    BUF_InitEmpty(&bm_shared_buffer, bm_shared_data, sizeof(bm_shared_data));
+    BUF_SharedInit(&bm_shared, &bm_shared_buffer);
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(BUF_SharedWriteRaw(&bm_shared, record, sizeof(record)));
+  }
+  if (state.thread_index() == 0)
+  {
+    benchmark::DoNotOptimize(BUF_SharedSync(&bm_shared));
+  }
+  bm_buf_report(state, 1, BM_SHARED_RECORD_SIZE);
+}
+BENCHMARK(BM_SharedWriteRaw)->ThreadRange(1, 4)->Iterations(BM_SHARED_RECORD_COUNT)->UseRealTime();
+
+#endif
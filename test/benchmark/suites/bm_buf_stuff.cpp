@@ -0,0 +1,158 @@
+//! \file bm_buf_stuff.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer_stuff.h"
+}
+
+/**
+ * \brief Payload with one byte to stuff every 64 bytes
+ */
+static std::vector<std::uint8_t> bm_stuff_payload(std::size_t size, std::uint8_t special)
+{
+  std::vector<std::uint8_t> data(size, 'a');
+  for (std::size_t i = 63; i < data.size(); i += 64)
+  {
+    data[i] = special;
+  }
+  return data;
+}
+
+/**
+ * \brief SLIP encode byte by byte, reference
+ */
+static void BM_SlipEncodeByteLoop(benchmark::State& state)
+{
+  std::vector<std::uint8_t> payload = bm_stuff_payload(state.range(0), 0xC0);
+  std::vector<std::uint8_t> encoded(payload.size() + payload.size() / 64 + 1);
+  BUF_t dst;
+  BUF_InitEmpty(&dst, encoded.data(), encoded.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&dst);
+    for (std::uint8_t byte : payload)
+    {
+      if (byte == 0xC0)
+      {
+        BUF_WriteUint8(&dst, 0xDB);
+        BUF_WriteUint8(&dst, 0xDC);
+      }
+      else if (byte == 0xDB)
+      {
+        BUF_WriteUint8(&dst, 0xDB);
+        BUF_WriteUint8(&dst, 0xDD);
+      }
+      else
+      {
+        BUF_WriteUint8(&dst, byte);
+      }
+    }
+    BUF_WriteUint8(&dst, 0xC0);
+    benchmark::DoNotOptimize(dst);
+  }
+  bm_buf_report(state, 1, payload.size());
+}
+BENCHMARK(BM_SlipEncodeByteLoop)->Apply(bm_buf_sizes);
+
+/**
+ * \brief SLIP encode
+ */
+static void BM_SlipEncode(benchmark::State& state)
+{
+  std::vector<std::uint8_t> payload = bm_stuff_payload(state.range(0), 0xC0);
+  std::vector<std::uint8_t> encoded(payload.size() + payload.size() / 64 + 1);
+  BUF_t src;
+  BUF_t dst;
+  BUF_InitFull(&src, payload.data(), payload.size());
+  BUF_InitEmpty(&dst, encoded.data(), encoded.size());
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&src);
+    BUF_Reset(&dst);
+    benchmark::DoNotOptimize(BUF_SlipEncode(&dst, &src));
+  }
+  bm_buf_report(state, 1, payload.size());
+}
+BENCHMARK(BM_SlipEncode)->Apply(bm_buf_sizes);
+
+/**
+ * \brief SLIP decode
+ */
+static void BM_SlipDecode(benchmark::State& state)
+{
+  std::vector<std::uint8_t> payload = bm_stuff_payload(state.range(0), 0xC0);
+  std::vector<std::uint8_t> encoded(payload.size() + payload.size() / 64 + 1);
+  BUF_t src;
+  BUF_t dst;
+  BUF_StuffDecoder_t decoder;
+  BUF_InitFull(&src, payload.data(), payload.size());
+  BUF_InitEmpty(&dst, encoded.data(), encoded.size());
+  BUF_SlipEncode(&dst, &src);
+  BUF_InitEmpty(&src, payload.data(), payload.size());
+  BUF_StuffDecoderInit(&decoder);
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&dst);
+    BUF_Reset(&src);
+    benchmark::DoNotOptimize(BUF_SlipDecode(&src, &dst, &decoder));
+  }
+  bm_buf_report(state, 1, payload.size());
+}
+BENCHMARK(BM_SlipDecode)->Apply(bm_buf_sizes);
+
+/**
+ * \brief COBS encode
+ */
+static void BM_CobsEncode(benchmark::State& state)
+{
+  std::vector<std::uint8_t> payload = bm_stuff_payload(state.range(0), 0x00);
+  std::vector<std::uint8_t> encoded(payload.size() + payload.size() / 254 + 2);
+  BUF_t src;
+  BUF_t dst;
+  BUF_InitFull(&src, payload.data(), payload.size());
+  BUF_InitEmpty(&dst, encoded.data(), encoded.size());
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&src);
+    BUF_Reset(&dst);
+    benchmark::DoNotOptimize(BUF_CobsEncode(&dst, &src));
+  }
+  bm_buf_report(state, 1, payload.size());
+}
+BENCHMARK(BM_CobsEncode)->Apply(bm_buf_sizes);
+
+/**
+ * \brief COBS decode
+ */
+static void BM_CobsDecode(benchmark::State& state)
+{
+  std::vector<std::uint8_t> payload = bm_stuff_payload(state.range(0), 0x00);
+  std::vector<std::uint8_t> encoded(payload.size() + payload.size() / 254 + 2);
+  BUF_t src;
+  BUF_t dst;
+  BUF_StuffDecoder_t decoder;
+  BUF_InitFull(&src, payload.data(), payload.size());
+  BUF_InitEmpty(&dst, encoded.data(), encoded.size());
+  BUF_CobsEncode(&dst, &src);
+  BUF_InitEmpty(&src, payload.data(), payload.size());
+  BUF_StuffDecoderInit(&decoder);
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&dst);
+    BUF_Reset(&src);
+    benchmark::DoNotOptimize(BUF_CobsDecode(&src, &dst, &decoder));
+  }
+  bm_buf_report(state, 1, payload.size());
+}
+BENCHMARK(BM_CobsDecode)->Apply(bm_buf_sizes);
@@ -0,0 +1,162 @@
+//! \file bm_buf_varint.cpp
+//! \brief Buffer benchmark
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <random>
+#include <vector>
+
+#include "bm_buf.h"
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+//! \brief Value count per iteration, 5 bytes each fits uint16_t BUF_size_t
+constexpr std::size_t BM_VARINT_COUNT = 4096;
+
+/**
+ * \brief Value distributions, Arg of the benchmarks
+ * - 0: lengths and small counters, all 1 byte
+ * - 1: mixed, 70 % 1 byte, 20 % 2 bytes, 8 % 3 bytes, 2 % 5 bytes
+ * - 2: uniform 32 bits, mostly 5 bytes
+ */
+static std::vector<std::uint32_t> bm_varint_values(std::int64_t distribution)
+{
+  std::mt19937 rng(42);
+  std::vector<std::uint32_t> values(BM_VARINT_COUNT);
+  for (auto& value : values)
+  {
+    std::uint32_t pick = rng() % 100;
+    if (distribution == 0)
+    {
+      value = rng() & 0x7F;
+    }
+    else if (distribution == 1)
+    {
+      value = (pick < 70) ? (rng() & 0x7F) : (pick < 90) ? (rng() & 0x3FFF) : (pick < 98) ? (rng() & 0x1FFFFF) : rng();
+    }
+    else
+    {
+      value = rng();
+    }
+  }
+  return values;
+}
+
+/**
+ * \brief Encode values in full buffer
+ */
+static std::size_t bm_varint_encode(std::vector<std::uint8_t>& data, BUF_t& buf, std::int64_t distribution)
+{
+  auto values = bm_varint_values(distribution);
+  data.assign(values.size() * BUF_VARINT32_MAX_SIZE, 0);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  for (auto value : values)
+  {
+    BUF_WriteVarU32(&buf, value);
+  }
+  return buf.write_index;
+}
+
+/**
+ * \brief Decode byte per byte with BUF_ReadUint8, as before varint support
+ */
+static void BM_ReadVarU32_Uint8Loop(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data;
+  BUF_t buf;
+  auto size = bm_varint_encode(data, buf, state.range(0));
+
+  for (auto _ : state)
+  {
+    std::uint32_t sum = 0;
+    BUF_ResetReadIndex(&buf);
+    for (auto i = BM_VARINT_COUNT; i > 0; i--)
+    {
+      std::uint32_t value = 0;
+      std::uint8_t shift  = 0;
+      std::uint8_t byte   = 0;
+      do
+      {
+        byte = BUF_ReadUint8(&buf);
+        value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+        shift += 7;
+      } while ((byte & 0x80) != 0);
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, BM_VARINT_COUNT, size);
+}
+
+/**
+ * \brief Decode one value per call
+ */
+static void BM_ReadVarU32(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data;
+  BUF_t buf;
+  auto size = bm_varint_encode(data, buf, state.range(0));
+
+  for (auto _ : state)
+  {
+    std::uint32_t sum = 0;
+    BUF_ResetReadIndex(&buf);
+    for (auto i = BM_VARINT_COUNT; i > 0; i--)
+    {
+      std::uint32_t value = 0;
+      BUF_ReadVarU32(&buf, &value);
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  bm_buf_report(state, BM_VARINT_COUNT, size);
+}
+
+/**
+ * \brief Decode all values in one call
+ */
+static void BM_ReadVarU32Array(benchmark::State& state)
+{
+  std::vector<std::uint8_t> data;
+  BUF_t buf;
+  auto size = bm_varint_encode(data, buf, state.range(0));
+  std::vector<std::uint32_t> values(BM_VARINT_COUNT);
+
+  for (auto _ : state)
+  {
+    BUF_ResetReadIndex(&buf);
+    BUF_ReadVarU32Array(&buf, values.data(), values.size());
+    benchmark::DoNotOptimize(values.data());
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, BM_VARINT_COUNT, size);
+}
+
+/**
+ * \brief Encode one value per call
+ */
+static void BM_WriteVarU32(benchmark::State& state)
+{
+  auto values = bm_varint_values(state.range(0));
+  std::vector<std::uint8_t> data(values.size() * BUF_VARINT32_MAX_SIZE);
+  BUF_t buf;
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  for (auto _ : state)
+  {
+    BUF_Reset(&buf);
+    for (auto value : values)
+    {
+      BUF_WriteVarU32(&buf, value);
+    }
+    benchmark::ClobberMemory();
+  }
+  bm_buf_report(state, BM_VARINT_COUNT, buf.write_index);
+}
+
+BENCHMARK(BM_ReadVarU32_Uint8Loop)->DenseRange(0, 2);
+BENCHMARK(BM_ReadVarU32)->DenseRange(0, 2);
+BENCHMARK(BM_ReadVarU32Array)->DenseRange(0, 2);
+BENCHMARK(BM_WriteVarU32)->DenseRange(0, 2);
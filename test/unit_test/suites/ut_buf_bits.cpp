@@ -0,0 +1,244 @@
+//! \file ut_buf_bits.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_bits.h"
+#include "buffer/buffer_stats.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAre;
+
+class BUF_Bits_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    BUF_InitEmpty(&buffer, data.data(), data.size());
+  }
+
+  /**
+   * \brief Fields of random width, 0 to 64 bits
+   */
+  std::vector<std::pair<std::uint8_t, std::uint64_t>> RandomFields(std::size_t count)
+  {
+    std::mt19937_64 rng(42);
+    std::vector<std::pair<std::uint8_t, std::uint64_t>> fields;
+    for (std::size_t i = 0; i < count; i++)
+    {
+      std::uint8_t size   = static_cast<std::uint8_t>(rng() % 65U);
+      std::uint64_t value = rng();
+      if (size < 64U)
+      {
+        value &= (static_cast<std::uint64_t>(1U) << size) - 1U;
+      }
+      fields.emplace_back(size, value);
+    }
+    return fields;
+  }
+
+  // attributes
+  std::vector<std::uint8_t> data = std::vector<std::uint8_t>(1024);
+  BUF_t buffer;
+  BUF_BitWriter_t writer;
+  BUF_BitReader_t reader;
+};
+
+/**
+ * \brief MSB first packing
+ */
+TEST_F(BUF_Bits_UT, Writer_001)
+{
+  BUF_BitWriterInit(&writer, &buffer, BUF_BIT_MSB_FIRST);
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 3, 0x5));
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 5, 0x13));
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 4, 0xFA));
+  EXPECT_EQ(buffer.write_index, 0);
+  EXPECT_TRUE(BUF_BitWriterFlush(&writer));
+  EXPECT_EQ(buffer.write_index, 2);
+  EXPECT_THAT(std::vector<std::uint8_t>(data.begin(), data.begin() + 2), ElementsAre(0xB3, 0xA0));
+}
+
+/**
+ * \brief LSB first packing
+ */
+TEST_F(BUF_Bits_UT, Writer_002)
+{
+  BUF_BitWriterInit(&writer, &buffer, BUF_BIT_LSB_FIRST);
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 3, 0x5));
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 5, 0x13));
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 4, 0xFA));
+  EXPECT_TRUE(BUF_BitWriterFlush(&writer));
+  EXPECT_EQ(buffer.write_index, 2);
+  EXPECT_THAT(std::vector<std::uint8_t>(data.begin(), data.begin() + 2), ElementsAre(0x9D, 0x0A));
+}
+
+/**
+ * \brief Whole words are stored when accumulator is full
+ */
+TEST_F(BUF_Bits_UT, Writer_003)
+{
+  BUF_BitWriterInit(&writer, &buffer, BUF_BIT_MSB_FIRST);
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 60, 0x0123456789ABCDEULL));
+  EXPECT_EQ(buffer.write_index, 0);
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 8, 0xF5));
+  EXPECT_EQ(buffer.write_index, 8);
+  EXPECT_TRUE(BUF_BitWriterFlush(&writer));
+  EXPECT_THAT(std::vector<std::uint8_t>(data.begin(), data.begin() + 9),
+              ElementsAre(0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x50));
+}
+
+/**
+ * \brief Buffer full, nothing written
+ */
+TEST_F(BUF_Bits_UT, Writer_004)
+{
+  BUF_InitEmpty(&buffer, data.data(), 8);
+  BUF_BitWriterInit(&writer, &buffer, BUF_BIT_LSB_FIRST);
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 60, 0));
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 8, 0xFF));
+  EXPECT_EQ(buffer.write_index, 8);
+  EXPECT_FALSE(BUF_BitWriterPutBits(&writer, 64, 0));
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 59, 0));
+  EXPECT_FALSE(BUF_BitWriterFlush(&writer));
+  EXPECT_EQ(buffer.write_index, 8);
+
+  EXPECT_FALSE(BUF_BitWriterPutBits(&writer, 65, 0));
+  EXPECT_FALSE(BUF_BitWriterPutBits(nullptr, 1, 0));
+  EXPECT_FALSE(BUF_BitWriterFlush(nullptr));
+  EXPECT_FALSE(BUF_BitWriterAlignToByte(nullptr));
+}
+
+/**
+ * \brief Random fields round trip, both orders
+ */
+TEST_F(BUF_Bits_UT, RoundTrip_001)
+{
+  const auto fields = RandomFields(200);
+  for (BUF_BitOrder_t order : {BUF_BIT_MSB_FIRST, BUF_BIT_LSB_FIRST})
+  {
+    std::size_t bit_count = 0;
+    BUF_Reset(&buffer);
+    BUF_BitWriterInit(&writer, &buffer, order);
+    for (const auto& field : fields)
+    {
+      ASSERT_TRUE(BUF_BitWriterPutBits(&writer, field.first, field.second));
+      bit_count += field.first;
+    }
+    ASSERT_TRUE(BUF_BitWriterFlush(&writer));
+    EXPECT_EQ(buffer.write_index, (bit_count + 7U) / 8U);
+
+    BUF_BitReaderInit(&reader, &buffer, order);
+    EXPECT_EQ(BUF_BitReaderGetRemaining(&reader), buffer.write_index * 8U);
+    for (const auto& field : fields)
+    {
+      ASSERT_EQ(BUF_BitReaderGetBits(&reader, field.first), field.second);
+    }
+    EXPECT_EQ(BUF_BitReaderGetRemaining(&reader), buffer.write_index * 8U - bit_count);
+  }
+}
+
+/**
+ * \brief MSB first unpacking, end of data read byte by byte
+ */
+TEST_F(BUF_Bits_UT, Reader_001)
+{
+  data = {0xB3, 0xA0, 0xFF};
+  BUF_InitFull(&buffer, data.data(), data.size());
+  BUF_BitReaderInit(&reader, &buffer, BUF_BIT_MSB_FIRST);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 3), 0x5);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 5), 0x13);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 0), 0);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 4), 0xA);
+  EXPECT_EQ(BUF_BitReaderGetRemaining(&reader), 12);
+
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 13), 0);
+  EXPECT_EQ(BUF_BitReaderGetRemaining(&reader), 12);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 12), 0x0FF);
+  EXPECT_EQ(BUF_BitReaderGetRemaining(&reader), 0);
+}
+
+/**
+ * \brief LSB first unpacking, 64 bits fields across words
+ */
+TEST_F(BUF_Bits_UT, Reader_002)
+{
+  data = {0x9D, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+  BUF_InitFull(&buffer, data.data(), data.size());
+  BUF_BitReaderInit(&reader, &buffer, BUF_BIT_LSB_FIRST);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 3), 0x5);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 5), 0x13);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 4), 0xA);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 64), 0xFFFFFFFFFFFFFFFFULL << 60U);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 64), 0xFFFFFFFFFFFFFFFFULL >> 4U);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 64), 0);
+  EXPECT_EQ(BUF_BitReaderGetRemaining(&reader), 4);
+
+  EXPECT_EQ(BUF_BitReaderGetBits(nullptr, 1), 0);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 65), 0);
+  EXPECT_EQ(BUF_BitReaderGetRemaining(nullptr), 0);
+}
+
+/**
+ * \brief Byte alignment and hand over to byte accessors
+ */
+TEST_F(BUF_Bits_UT, Align_001)
+{
+  BUF_BitWriterInit(&writer, &buffer, BUF_BIT_MSB_FIRST);
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 3, 0x7));
+  EXPECT_TRUE(BUF_BitWriterAlignToByte(&writer));
+  EXPECT_TRUE(BUF_BitWriterPutBits(&writer, 4, 0x9));
+  EXPECT_TRUE(BUF_BitWriterFlush(&writer));
+  EXPECT_EQ(BUF_WriteUint16(&buffer, 0x1234), 2);
+  for (int i = 0; i < 10; i++)
+  {
+    EXPECT_EQ(BUF_WriteUint8(&buffer, static_cast<std::uint8_t>(i)), 1);
+  }
+  EXPECT_THAT(std::vector<std::uint8_t>(data.begin(), data.begin() + 4), ElementsAre(0xE0, 0x90, 0x12, 0x34));
+
+  BUF_BitReaderInit(&reader, &buffer, BUF_BIT_MSB_FIRST);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 3), 0x7);
+  BUF_BitReaderAlignToByte(&reader);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 4), 0x9);
+  BUF_BitReaderSync(&reader);
+  EXPECT_EQ(buffer.read_index, 2);
+  EXPECT_EQ(BUF_ReadUint16(&buffer), 0x1234);
+  EXPECT_EQ(BUF_ReadUint8(&buffer), 0);
+
+  BUF_BitReaderInit(&reader, &buffer, BUF_BIT_LSB_FIRST);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 8), 1);
+  BUF_BitReaderSync(&reader);
+  EXPECT_EQ(BUF_ReadUint8(&buffer), 2);
+}
+
+#if defined(BUF_STATS_ENABLE)
+/**
+ * \brief Bytes loaded ahead and given back by sync are read once in stats
+ */
+TEST_F(BUF_Bits_UT, Stats_001)
+{
+  BUF_Stats_t stats;
+  std::vector<std::uint8_t> out(31);
+  BUF_InitFull(&buffer, data.data(), 32);
+  BUF_StatsInit(&stats);
+  BUF_AttachStats(&buffer, &stats);
+
+  BUF_BitReaderInit(&reader, &buffer, BUF_BIT_MSB_FIRST);
+  EXPECT_EQ(BUF_BitReaderGetBits(&reader, 4), 0);
+  BUF_BitReaderSync(&reader);
+  EXPECT_EQ(stats.bytes_read, 1U);
+  EXPECT_EQ(BUF_ReadRaw(&buffer, out.data(), 31), 31);
+  EXPECT_EQ(buffer.read_index, 32);
+  EXPECT_EQ(stats.bytes_read, 32U);
+  EXPECT_EQ(stats.read_failed, 0U);
+}
+#endif
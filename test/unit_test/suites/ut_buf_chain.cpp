@@ -0,0 +1,146 @@
+//! \file ut_buf_chain.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <unistd.h>
+
+extern "C" {
+#include "buffer/buffer_chain.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Chain_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    // Frame: header 2 bytes, payload view of 3 bytes, trailer 2 bytes
+    BUF_InitFull(&header, header_data, sizeof(header_data));
+    BUF_InitFull(&payload_src, payload_data, sizeof(payload_data));
+    BUF_MakeViewFull(&payload, &payload_src, 1, 3);
+    BUF_InitFull(&trailer, trailer_data, sizeof(trailer_data));
+
+    BUF_ChainInit(&chain, segments, SEGMENT_COUNT);
+    ASSERT_TRUE(BUF_ChainAppend(&chain, &header));
+    ASSERT_TRUE(BUF_ChainAppend(&chain, &payload));
+    ASSERT_TRUE(BUF_ChainAppend(&chain, &trailer));
+  }
+
+  // attributes
+  static constexpr std::size_t SEGMENT_COUNT = 3;
+  BUF_t* segments[SEGMENT_COUNT];
+  BUF_Chain_t chain;
+
+  std::uint8_t header_data[2]  = {0x11, 0x22};
+  std::uint8_t payload_data[5] = {0xFF, 0x33, 0x44, 0x55, 0xFF};
+  std::uint8_t trailer_data[2] = {0x66, 0x77};
+  BUF_t header;
+  BUF_t payload_src;
+  BUF_t payload;
+  BUF_t trailer;
+};
+
+/**
+ * \brief Append up to capacity
+ */
+TEST_F(BUF_Chain_UT, Append_001)
+{
+  EXPECT_EQ(BUF_ChainGetSegmentCount(&chain), SEGMENT_COUNT);
+  EXPECT_EQ(BUF_ChainGetToReadCount(&chain), 7);
+  EXPECT_FALSE(BUF_ChainAppend(&chain, &header));
+  EXPECT_FALSE(BUF_ChainAppend(nullptr, &header));
+
+  BUF_ChainReset(&chain);
+  EXPECT_EQ(BUF_ChainGetSegmentCount(&chain), 0);
+  EXPECT_EQ(BUF_ChainGetToReadCount(&chain), 0);
+  EXPECT_FALSE(BUF_ChainAppend(&chain, nullptr));
+}
+
+/**
+ * \brief Read values straddling segment boundaries
+ */
+TEST_F(BUF_Chain_UT, Read_001)
+{
+  EXPECT_EQ(BUF_ChainReadUint8(&chain), 0x11);
+  EXPECT_EQ(BUF_ChainReadUint32(&chain), 0x22334455);
+  EXPECT_EQ(BUF_ChainReadUint16(&chain), 0x6677);
+  EXPECT_EQ(BUF_ChainGetToReadCount(&chain), 0);
+  EXPECT_EQ(BUF_ChainReadUint8(&chain), 0);
+
+  EXPECT_EQ(header.read_index, 2);
+  EXPECT_EQ(payload.read_index, 3);
+  EXPECT_EQ(trailer.read_index, 2);
+  EXPECT_EQ(payload_src.read_index, 0);
+}
+
+/**
+ * \brief Read raw across all segments, all or nothing
+ */
+TEST_F(BUF_Chain_UT, Read_002)
+{
+  std::vector<std::uint8_t> read(8);
+  EXPECT_EQ(BUF_ChainReadRaw(&chain, read.data(), read.size()), 0);
+  EXPECT_EQ(BUF_ChainGetToReadCount(&chain), 7);
+
+  EXPECT_EQ(BUF_ChainReadRaw(&chain, read.data(), 7), 7);
+  std::vector<std::uint8_t> expected = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77};
+  EXPECT_THAT(expected, ElementsAreArray(read.data(), 7));
+
+  EXPECT_EQ(BUF_ChainReadUint32(&chain), 0);
+  EXPECT_EQ(BUF_ChainReadRaw(nullptr, read.data(), 1), 0);
+  EXPECT_EQ(BUF_ChainReadRaw(&chain, nullptr, 1), 0);
+}
+
+/**
+ * \brief Export iovec without copy and consume partial send
+ */
+TEST_F(BUF_Chain_UT, ExportIovec_001)
+{
+  struct iovec iov[4];
+  ASSERT_EQ(BUF_ChainExportIovec(&chain, iov, 4), 3);
+  EXPECT_EQ(iov[0].iov_base, header_data);
+  EXPECT_EQ(iov[0].iov_len, 2);
+  EXPECT_EQ(iov[1].iov_base, &payload_data[1]);
+  EXPECT_EQ(iov[1].iov_len, 3);
+  EXPECT_EQ(iov[2].iov_base, trailer_data);
+  EXPECT_EQ(iov[2].iov_len, 2);
+
+  EXPECT_EQ(BUF_ChainConsume(&chain, 3), 3);
+  ASSERT_EQ(BUF_ChainExportIovec(&chain, iov, 4), 2);
+  EXPECT_EQ(iov[0].iov_base, &payload_data[2]);
+  EXPECT_EQ(iov[0].iov_len, 2);
+
+  EXPECT_EQ(BUF_ChainExportIovec(&chain, iov, 1), 1);
+  EXPECT_EQ(BUF_ChainExportIovec(nullptr, iov, 4), 0);
+  EXPECT_EQ(BUF_ChainConsume(&chain, 10), 4);
+  EXPECT_EQ(BUF_ChainExportIovec(&chain, iov, 4), 0);
+}
+
+/**
+ * \brief Send whole frame with writev
+ */
+TEST_F(BUF_Chain_UT, ExportIovec_002)
+{
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+
+  struct iovec iov[SEGMENT_COUNT];
+  auto iov_count = BUF_ChainExportIovec(&chain, iov, SEGMENT_COUNT);
+  auto sent      = writev(fds[1], iov, static_cast<int>(iov_count));
+  ASSERT_EQ(sent, 7);
+  EXPECT_EQ(BUF_ChainConsume(&chain, static_cast<std::size_t>(sent)), 7);
+
+  std::vector<std::uint8_t> received(7);
+  ASSERT_EQ(read(fds[0], received.data(), received.size()), 7);
+  std::vector<std::uint8_t> expected = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77};
+  EXPECT_THAT(received, ElementsAreArray(expected));
+
+  close(fds[0]);
+  close(fds[1]);
+}
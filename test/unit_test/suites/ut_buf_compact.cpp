@@ -0,0 +1,119 @@
+//! \file ut_buf_compact.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Compact_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    data = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x00, 0x00};
+    BUF_InitEmpty(&buf, data.data(), data.size());
+    BUF_Commit(&buf, 8);
+  }
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+};
+
+/**
+ * \brief Data to read is moved to the front, indices rebased
+ */
+TEST_F(BUF_Compact_UT, Compact_001)
+{
+  BUF_Consume(&buf, 5);
+  EXPECT_EQ(BUF_Compact(&buf), 5);
+  EXPECT_EQ(buf.read_index, 0);
+  EXPECT_EQ(buf.write_index, 3);
+  EXPECT_EQ(BUF_GetFreeSize(&buf), 7);
+
+  std::vector<std::uint8_t> expected = {0x66, 0x77, 0x88};
+  EXPECT_THAT(std::vector<std::uint8_t>(data.begin(), data.begin() + 3), ElementsAreArray(expected));
+
+  EXPECT_EQ(BUF_ReadUint16(&buf), 0x6677);
+}
+
+/**
+ * \brief Nothing read, all read, NULL parameters
+ */
+TEST_F(BUF_Compact_UT, Compact_002)
+{
+  EXPECT_EQ(BUF_Compact(&buf), 0);
+  EXPECT_EQ(buf.write_index, 8);
+
+  BUF_SetAllRead(&buf);
+  EXPECT_EQ(BUF_Compact(&buf), 8);
+  EXPECT_TRUE(BUF_IsEmpty(&buf));
+  EXPECT_EQ(BUF_GetFreeSize(&buf), 10);
+
+  EXPECT_EQ(BUF_Compact(nullptr), 0);
+}
+
+/**
+ * \brief Compaction below threshold is skipped
+ */
+TEST_F(BUF_Compact_UT, CompactIfNeeded_001)
+{
+  BUF_Consume(&buf, 4);
+  EXPECT_EQ(BUF_CompactIfNeeded(&buf, BUF_COMPACT_THRESHOLD_DEFAULT), 0);
+  EXPECT_EQ(buf.read_index, 4);
+
+  BUF_Consume(&buf, 1);
+  EXPECT_EQ(BUF_CompactIfNeeded(&buf, BUF_COMPACT_THRESHOLD_DEFAULT), 5);
+  EXPECT_EQ(buf.read_index, 0);
+  EXPECT_EQ(buf.write_index, 3);
+
+  EXPECT_EQ(BUF_CompactIfNeeded(nullptr, 0), 0);
+}
+
+/**
+ * \brief Empty buffer is rebased whatever the threshold
+ */
+TEST_F(BUF_Compact_UT, CompactIfNeeded_002)
+{
+  BUF_Consume(&buf, 2);
+  EXPECT_EQ(BUF_CompactIfNeeded(&buf, 100), 0);
+
+  BUF_SetAllRead(&buf);
+  EXPECT_EQ(BUF_CompactIfNeeded(&buf, 100), 8);
+  EXPECT_EQ(buf.read_index, 0);
+  EXPECT_EQ(buf.write_index, 0);
+}
+
+/**
+ * \brief Streaming reader keeps one buffer
+ */
+TEST_F(BUF_Compact_UT, CompactIfNeeded_003)
+{
+  BUF_Reset(&buf);
+  std::uint8_t next_write = 0;
+  std::uint8_t next_read  = 0;
+  BUF_WriteUint8(&buf, next_write++);
+
+  for (int i = 0; i < 100; i++)
+  {
+    BUF_size_t size   = 0;
+    std::uint8_t* dst = BUF_Reserve(&buf, &size);
+    ASSERT_NE(dst, nullptr);
+    ASSERT_GE(size, 2);
+    dst[0] = next_write++;
+    dst[1] = next_write++;
+    BUF_Commit(&buf, 2);
+
+    EXPECT_EQ(BUF_ReadUint8(&buf), next_read++);
+    EXPECT_EQ(BUF_ReadUint8(&buf), next_read++);
+    BUF_CompactIfNeeded(&buf, BUF_COMPACT_THRESHOLD_DEFAULT);
+  }
+  EXPECT_EQ(BUF_GetToReadCount(&buf), 1);
+}
@@ -0,0 +1,171 @@
+//! \file ut_buf_crc.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_crc.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Crc_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    BUF_InitFull(&buf, reinterpret_cast<std::uint8_t*>(check.data()), check.size());
+  }
+
+  // Bitwise references, independent from table and hardware paths
+  static std::uint16_t ref_crc16(const std::vector<std::uint8_t>& bytes)
+  {
+    std::uint16_t crc = 0xFFFF;
+    for (auto byte : bytes)
+    {
+      crc ^= static_cast<std::uint16_t>(byte << 8);
+      for (int bit = 0; bit < 8; bit++)
+      {
+        crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021) : static_cast<std::uint16_t>(crc << 1);
+      }
+    }
+    return crc;
+  }
+
+  static std::uint32_t ref_crc32(const std::vector<std::uint8_t>& bytes, std::uint32_t poly)
+  {
+    std::uint32_t crc = 0xFFFFFFFF;
+    for (auto byte : bytes)
+    {
+      crc ^= byte;
+      for (int bit = 0; bit < 8; bit++)
+      {
+        crc = (crc & 1) ? ((crc >> 1) ^ poly) : (crc >> 1);
+      }
+    }
+    return ~crc;
+  }
+
+  // attributes
+  BUF_t buf;
+  std::string check = "123456789";
+};
+
+/**
+ * \brief Check values of the CRC catalogue over "123456789"
+ */
+TEST_F(BUF_Crc_UT, KnownVector_001)
+{
+  EXPECT_EQ(BUF_Crc16Ccitt(&buf), 0x29B1);
+  EXPECT_EQ(BUF_Crc32(&buf), 0xCBF43926);
+  EXPECT_EQ(BUF_Crc32c(&buf), 0xE3069283);
+  EXPECT_EQ(buf.read_index, 0);
+}
+
+/**
+ * \brief All sizes and offsets against bitwise reference, covers slicing,
+ * hardware and tail paths
+ */
+TEST_F(BUF_Crc_UT, Reference_001)
+{
+  std::vector<std::uint8_t> data(300);
+  for (std::size_t i = 0; i < data.size(); i++)
+  {
+    data[i] = static_cast<std::uint8_t>((i * 131) ^ (i >> 3));
+  }
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  for (std::size_t size = 0; size <= 260; size += 1)
+  {
+    for (std::size_t index : {0, 1, 7})
+    {
+      std::vector<std::uint8_t> part(data.begin() + index, data.begin() + index + size);
+      ASSERT_EQ(BUF_Crc16CcittRange(&buf, index, size), ref_crc16(part)) << size;
+      ASSERT_EQ(BUF_Crc32Range(&buf, index, size), ref_crc32(part, 0xEDB88320)) << size;
+      ASSERT_EQ(BUF_Crc32cRange(&buf, index, size), ref_crc32(part, 0x82F63B78)) << size;
+    }
+  }
+}
+
+/**
+ * \brief Incremental update equals one shot
+ */
+TEST_F(BUF_Crc_UT, Update_001)
+{
+  auto data = reinterpret_cast<const std::uint8_t*>(check.data());
+
+  auto crc16 = BUF_Crc16CcittUpdate(BUF_CRC16_CCITT_INIT, data, 4);
+  EXPECT_EQ(BUF_Crc16CcittUpdate(crc16, &data[4], 5), 0x29B1);
+
+  auto crc32 = BUF_Crc32Update(BUF_CRC32_INIT, data, 4);
+  EXPECT_EQ(BUF_Crc32Update(crc32, &data[4], 5), 0xCBF43926);
+
+  auto crc32c = BUF_Crc32cUpdate(BUF_CRC32_INIT, data, 4);
+  EXPECT_EQ(BUF_Crc32cUpdate(crc32c, &data[4], 5), 0xE3069283);
+
+  EXPECT_EQ(BUF_Crc32Update(0x1234, nullptr, 4), 0x1234);
+}
+
+/**
+ * \brief CRC of data to read only
+ */
+TEST_F(BUF_Crc_UT, ToRead_001)
+{
+  std::string framed = "xx123456789";
+  BUF_InitFull(&buf, reinterpret_cast<std::uint8_t*>(framed.data()), framed.size());
+  BUF_ReadUint16(&buf);
+
+  EXPECT_EQ(BUF_Crc32(&buf), 0xCBF43926);
+  EXPECT_EQ(BUF_Crc32Range(&buf, 2, 9), 0xCBF43926);
+}
+
+/**
+ * \brief Bad input parameters and out of bounds range
+ */
+TEST_F(BUF_Crc_UT, BadParameter_001)
+{
+  EXPECT_EQ(BUF_Crc16Ccitt(nullptr), 0);
+  EXPECT_EQ(BUF_Crc32(nullptr), 0);
+  EXPECT_EQ(BUF_Crc32c(nullptr), 0);
+  EXPECT_EQ(BUF_Crc32Range(&buf, 1, 9), 0);
+  EXPECT_EQ(BUF_Crc32cRange(&buf, 10, 0), 0);
+  EXPECT_EQ(BUF_Crc16CcittRange(&buf, 0, 10), 0);
+  EXPECT_EQ(BUF_WriteCrc32(nullptr), 0);
+}
+
+/**
+ * \brief Append CRC in buffer byte order
+ */
+TEST_F(BUF_Crc_UT, WriteCrc_001)
+{
+  std::vector<std::uint8_t> data(9 + 4);
+  memcpy(data.data(), check.data(), check.size());
+
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  buf.write_index = 9;
+  EXPECT_EQ(BUF_WriteCrc32(&buf), 4);
+  std::vector<std::uint8_t> expected_be = {0xCB, 0xF4, 0x39, 0x26};
+  EXPECT_THAT(expected_be, ElementsAreArray(&data[9], 4));
+
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  BUF_SetEndian(&buf, BUF_ENDIAN_LITTLE);
+  buf.write_index = 9;
+  EXPECT_EQ(BUF_WriteCrc32c(&buf), 4);
+  std::vector<std::uint8_t> expected_le = {0x83, 0x92, 0x06, 0xE3};
+  EXPECT_THAT(expected_le, ElementsAreArray(&data[9], 4));
+
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  buf.write_index = 9;
+  EXPECT_EQ(BUF_WriteCrc16Ccitt(&buf), 2);
+  EXPECT_EQ(BUF_GetUint16(&buf, 9), 0x29B1);
+
+  BUF_InitFull(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_WriteCrc32(&buf), 0);
+}
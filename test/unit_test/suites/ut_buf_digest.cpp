@@ -0,0 +1,191 @@
+//! \file ut_buf_digest.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_crc.h"
+#include "buffer/buffer_digest.h"
+}
+
+#if defined(BUF_DIGEST_ENABLE)
+
+using namespace testing;
+
+class BUF_Digest_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    BUF_InitEmpty(&buf, data.data(), data.size());
+    BUF_DigestInit(&digest, BUF_DIGEST_CRC32);
+    BUF_AttachDigest(&buf, &digest);
+  }
+
+  // attributes
+  std::vector<std::uint8_t> data = std::vector<std::uint8_t>(64);
+  BUF_t buf;
+  BUF_Digest_t digest;
+  std::string check = "123456789";
+};
+
+/**
+ * \brief Check values over "123456789"
+ */
+TEST_F(BUF_Digest_UT, KnownVector_001)
+{
+  auto bytes = reinterpret_cast<const std::uint8_t*>(check.data());
+
+  BUF_DigestUpdate(&digest, bytes, check.size());
+  EXPECT_EQ(BUF_DigestGetValue(&digest), 0xCBF43926);
+
+  BUF_DigestInit(&digest, BUF_DIGEST_FLETCHER16);
+  BUF_DigestUpdate(&digest, bytes, 4);
+  BUF_DigestUpdate(&digest, &bytes[4], 5);
+  EXPECT_EQ(BUF_DigestGetValue(&digest), 0x1EDE);
+}
+
+/**
+ * \brief Every write function updates digest with written bytes only
+ */
+TEST_F(BUF_Digest_UT, Write_001)
+{
+  std::vector<std::uint8_t> src_data = {0xA0, 0xA1, 0xA2};
+  BUF_t src;
+  BUF_InitFull(&src, src_data.data(), src_data.size());
+  std::uint16_t array16[2] = {0x1122, 0x3344};
+  std::uint32_t array32[1] = {0x55667788};
+
+  BUF_WriteUint8(&buf, 0x01);
+  BUF_WriteUint16(&buf, 0x0203);
+  BUF_WriteUint32(&buf, 0x04050607);
+  BUF_WriteUint64(&buf, 0x08090A0B0C0D0E0F);
+  BUF_WriteUint16LE(&buf, 0x0203);
+  BUF_WriteUint32LE(&buf, 0x04050607);
+  BUF_WriteUint64LE(&buf, 0x08090A0B0C0D0E0F);
+  BUF_WriteUint16Array(&buf, array16, 2);
+  BUF_WriteUint32Array(&buf, array32, 1);
+  BUF_WriteString(&buf, "ab", 2);
+  BUF_WriteRaw(&buf, src_data.data(), 1);
+  BUF_WriteCopy(&buf, &src, 2);
+  BUF_FillPattern(&buf, 0x5A, 3);
+  BUF_PutUint8(&buf, 0xFF, 0);
+
+  auto written = BUF_GetUsedSize(&buf);
+  EXPECT_EQ(written, 1 + 2 + 4 + 8 + 2 + 4 + 8 + 4 + 4 + 2 + 1 + 2 + 3);
+  data[0] = 0x01;
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), BUF_Crc32Range(&buf, 0, written));
+}
+
+/**
+ * \brief Failed writes are not part of digest
+ */
+TEST_F(BUF_Digest_UT, WriteFailed_001)
+{
+  BUF_SetSize(&buf, 3);
+  EXPECT_EQ(BUF_WriteUint16(&buf, 0x0102), 2);
+  EXPECT_EQ(BUF_WriteUint16(&buf, 0x0304), 0);
+  EXPECT_EQ(BUF_WriteUint32(&buf, 0x05060708), 0);
+
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), BUF_Crc32Range(&buf, 0, 2));
+}
+
+/**
+ * \brief Bytes filled in place are part of digest once committed
+ */
+TEST_F(BUF_Digest_UT, Commit_001)
+{
+  BUF_size_t size = 0;
+  std::uint8_t* area = BUF_Reserve(&buf, &size);
+  ASSERT_NE(area, nullptr);
+  std::copy(check.begin(), check.end(), area);
+  EXPECT_EQ(BUF_Commit(&buf, check.size()), check.size());
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), 0xCBF43926);
+}
+
+/**
+ * \brief Finalize restarts digest for next frame
+ */
+TEST_F(BUF_Digest_UT, Finalize_001)
+{
+  BUF_WriteString(&buf, check.data(), check.size());
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), 0xCBF43926);
+
+  BUF_Reset(&buf);
+  BUF_WriteString(&buf, check.data(), check.size());
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), 0xCBF43926);
+}
+
+/**
+ * \brief Fletcher-16 over data written
+ */
+TEST_F(BUF_Digest_UT, Fletcher_001)
+{
+  BUF_DigestInit(&digest, BUF_DIGEST_FLETCHER16);
+  BUF_WriteString(&buf, check.data(), 3);
+  BUF_WriteString(&buf, &check[3], 6);
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), 0x1EDE);
+}
+
+/**
+ * \brief Long Fletcher-16 input against modulo at each byte
+ */
+TEST_F(BUF_Digest_UT, Fletcher_002)
+{
+  std::vector<std::uint8_t> bytes(20000, 0xFF);
+  std::uint32_t sum1 = 0;
+  std::uint32_t sum2 = 0;
+  for (auto byte : bytes)
+  {
+    sum1 = (sum1 + byte) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+
+  BUF_DigestInit(&digest, BUF_DIGEST_FLETCHER16);
+  BUF_DigestUpdate(&digest, bytes.data(), bytes.size());
+  EXPECT_EQ(BUF_DigestGetValue(&digest), (sum2 << 8) | sum1);
+}
+
+/**
+ * \brief Detach, init and view detach digest
+ */
+TEST_F(BUF_Digest_UT, Detach_001)
+{
+  BUF_t view;
+  BUF_WriteUint8(&buf, 0x31);
+  BUF_MakeViewFull(&view, &buf, 0, 8);
+  BUF_WriteUint8(&view, 0x00);
+
+  BUF_AttachDigest(&buf, nullptr);
+  BUF_WriteUint8(&buf, 0x32);
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), 0);
+
+  BUF_AttachDigest(&buf, &digest);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), 0);
+
+  BUF_AttachDigest(&buf, &digest);
+  EXPECT_EQ(BUF_FinalizeDigest(&buf), BUF_Crc32Update(0, data.data(), 1));
+}
+
+/**
+ * \brief Bad input parameters
+ */
+TEST_F(BUF_Digest_UT, BadParameter_001)
+{
+  BUF_DigestInit(nullptr, BUF_DIGEST_CRC32);
+  BUF_DigestUpdate(nullptr, data.data(), 1);
+  BUF_DigestUpdate(&digest, nullptr, 1);
+  BUF_AttachDigest(nullptr, &digest);
+  EXPECT_EQ(BUF_DigestGetValue(nullptr), 0);
+  EXPECT_EQ(BUF_FinalizeDigest(nullptr), 0);
+  EXPECT_EQ(BUF_DigestGetValue(&digest), 0);
+}
+
+#endif
@@ -0,0 +1,153 @@
+//! \file ut_buf_find.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+using namespace testing;
+
+class BUF_Find_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    data.assign(100, 'a');
+    BUF_InitFull(&buf, data.data(), data.size());
+  }
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+};
+
+/**
+ * \brief Byte found at every position, in SIMD blocks and tail
+ */
+TEST_F(BUF_Find_UT, FindByte_001)
+{
+  for (std::size_t i = 0; i < data.size(); i++)
+  {
+    data[i] = 'x';
+    EXPECT_EQ(BUF_FindByte(&buf, 'x'), i);
+    data[i] = 'a';
+  }
+  EXPECT_EQ(BUF_FindByte(&buf, 'x'), BUF_INDEX_NONE);
+}
+
+/**
+ * \brief Search starts at read_index and stops at write_index
+ */
+TEST_F(BUF_Find_UT, FindByte_002)
+{
+  data[10] = 'x';
+  data[60] = 'x';
+  data[90] = 'y';
+  buf.write_index = 80;
+  EXPECT_EQ(BUF_FindByte(&buf, 'x'), 10);
+  BUF_Consume(&buf, 11);
+  EXPECT_EQ(BUF_FindByte(&buf, 'x'), 60);
+  EXPECT_EQ(buf.read_index, 11);
+  EXPECT_EQ(BUF_FindByte(&buf, 'y'), BUF_INDEX_NONE);
+  EXPECT_EQ(BUF_FindByte(nullptr, 'x'), BUF_INDEX_NONE);
+}
+
+/**
+ * \brief First byte of set found
+ */
+TEST_F(BUF_Find_UT, FindAnyOf_001)
+{
+  const std::uint8_t set[] = {'\r', '\n', ',', ';', '|', '\t', ' ', '\0'};
+  for (std::size_t i = 0; i < data.size(); i++)
+  {
+    data[i] = set[i % sizeof(set)];
+    EXPECT_EQ(BUF_FindAnyOf(&buf, set, sizeof(set)), i);
+    data[i] = 'a';
+  }
+  data[40] = ';';
+  data[70] = ',';
+  EXPECT_EQ(BUF_FindAnyOf(&buf, set, 3), 70);
+  EXPECT_EQ(BUF_FindAnyOf(&buf, set, 4), 40);
+  EXPECT_EQ(BUF_FindAnyOf(&buf, set, 2), BUF_INDEX_NONE);
+  EXPECT_EQ(BUF_FindAnyOf(&buf, set, 0), BUF_INDEX_NONE);
+  EXPECT_EQ(BUF_FindAnyOf(&buf, set, BUF_FIND_SET_MAX + 1), BUF_INDEX_NONE);
+  EXPECT_EQ(BUF_FindAnyOf(&buf, nullptr, 1), BUF_INDEX_NONE);
+}
+
+/**
+ * \brief Pattern found at every position, partial matches skipped
+ */
+TEST_F(BUF_Find_UT, FindPattern_001)
+{
+  const std::uint8_t pattern[] = {'x', 'a', 'a', 'y'};
+  for (std::size_t i = 0; i + sizeof(pattern) <= data.size(); i++)
+  {
+    std::memcpy(&data[i], pattern, sizeof(pattern));
+    EXPECT_EQ(BUF_FindPattern(&buf, pattern, sizeof(pattern)), i);
+    std::memset(&data[i], 'a', sizeof(pattern));
+  }
+
+  // first and last bytes match, middle does not
+  data[20] = 'x';
+  data[23] = 'y';
+  data[21] = 'b';
+  EXPECT_EQ(BUF_FindPattern(&buf, pattern, sizeof(pattern)), BUF_INDEX_NONE);
+  // pattern cut by write_index
+  std::memcpy(&data[97], pattern, 3);
+  EXPECT_EQ(BUF_FindPattern(&buf, pattern, sizeof(pattern)), BUF_INDEX_NONE);
+}
+
+/**
+ * \brief Single byte pattern, invalid parameters
+ */
+TEST_F(BUF_Find_UT, FindPattern_002)
+{
+  const std::uint8_t pattern[] = {'z'};
+  data[33] = 'z';
+  EXPECT_EQ(BUF_FindPattern(&buf, pattern, 1), 33);
+  EXPECT_EQ(BUF_FindPattern(&buf, pattern, 0), BUF_INDEX_NONE);
+  EXPECT_EQ(BUF_FindPattern(&buf, nullptr, 1), BUF_INDEX_NONE);
+  EXPECT_EQ(BUF_FindPattern(nullptr, pattern, 1), BUF_INDEX_NONE);
+
+  std::vector<std::uint8_t> big(200, 'a');
+  EXPECT_EQ(BUF_FindPattern(&buf, big.data(), big.size()), BUF_INDEX_NONE);
+}
+
+/**
+ * \brief Frames extracted as views, partial frame kept to read
+ */
+TEST_F(BUF_Find_UT, NextFrame_001)
+{
+  std::string text = "GET /\r\n\r\nHost: x\r\npart";
+  std::memcpy(data.data(), text.data(), text.size());
+  buf.write_index = text.size();
+  const std::uint8_t crlf[] = {'\r', '\n'};
+  BUF_t frame;
+
+  ASSERT_TRUE(BUF_NextFrame(&buf, &frame, crlf, sizeof(crlf)));
+  EXPECT_EQ(BUF_GetData(&frame), data.data());
+  EXPECT_EQ(BUF_GetToReadCount(&frame), 5);
+  EXPECT_EQ(buf.read_index, 7);
+
+  ASSERT_TRUE(BUF_NextFrame(&buf, &frame, crlf, sizeof(crlf)));
+  EXPECT_EQ(BUF_GetToReadCount(&frame), 0);
+
+  ASSERT_TRUE(BUF_NextFrame(&buf, &frame, crlf, sizeof(crlf)));
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(BUF_GetData(&frame)), BUF_GetToReadCount(&frame)),
+            "Host: x");
+
+  EXPECT_FALSE(BUF_NextFrame(&buf, &frame, crlf, sizeof(crlf)));
+  EXPECT_EQ(buf.read_index, 18);
+  EXPECT_EQ(BUF_GetToReadCount(&buf), 4);
+
+  EXPECT_FALSE(BUF_NextFrame(&buf, nullptr, crlf, sizeof(crlf)));
+  EXPECT_FALSE(BUF_NextFrame(nullptr, &frame, crlf, sizeof(crlf)));
+}
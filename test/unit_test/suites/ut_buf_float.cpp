@@ -0,0 +1,187 @@
+//! \file ut_buf_float.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Float_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {}
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+};
+
+/** \brief Big-endian layout, 1.0f and -2.5 */
+TEST_F(BUF_Float_UT, WriteFloat_001)
+{
+  data.assign(13, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteFloat32(&buf, 1.0F), 4);
+  EXPECT_EQ(BUF_WriteFloat64(&buf, -2.5), 8);
+  EXPECT_EQ(BUF_WriteFloat32(&buf, 1.0F), 0);
+  EXPECT_EQ(BUF_WriteFloat64(&buf, 1.0), 0);
+  EXPECT_EQ(buf.write_index, 12);
+
+  std::vector<std::uint8_t> expected = {0x3F, 0x80, 0x00, 0x00, 0xC0, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+
+  EXPECT_EQ(BUF_WriteFloat32(nullptr, 1.0F), 0);
+  EXPECT_EQ(BUF_WriteFloat64(nullptr, 1.0), 0);
+}
+
+/** \brief Little-endian layout */
+TEST_F(BUF_Float_UT, WriteFloatLE_001)
+{
+  data.assign(12, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteFloat32LE(&buf, 1.0F), 4);
+  EXPECT_EQ(BUF_WriteFloat64LE(&buf, -2.5), 8);
+
+  std::vector<std::uint8_t> expected = {0x00, 0x00, 0x80, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xC0};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+/** \brief Round trip keeps special values */
+TEST_F(BUF_Float_UT, ReadFloat_001)
+{
+  data.assign(40, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  BUF_WriteFloat32(&buf, -0.0F);
+  BUF_WriteFloat32(&buf, std::numeric_limits<float>::infinity());
+  BUF_WriteFloat64(&buf, std::numeric_limits<double>::denorm_min());
+  BUF_WriteFloat64(&buf, std::numeric_limits<double>::quiet_NaN());
+  BUF_WriteFloat32LE(&buf, 3.25F);
+  BUF_WriteFloat64LE(&buf, -1e300);
+
+  float f32 = BUF_ReadFloat32(&buf);
+  EXPECT_EQ(f32, 0.0F);
+  EXPECT_TRUE(std::signbit(f32));
+  EXPECT_EQ(BUF_ReadFloat32(&buf), std::numeric_limits<float>::infinity());
+  EXPECT_EQ(BUF_ReadFloat64(&buf), std::numeric_limits<double>::denorm_min());
+  EXPECT_TRUE(std::isnan(BUF_ReadFloat64(&buf)));
+  EXPECT_EQ(BUF_ReadFloat32LE(&buf), 3.25F);
+  EXPECT_EQ(BUF_ReadFloat64LE(&buf), -1e300);
+  EXPECT_EQ(buf.read_index, 36);
+
+  EXPECT_EQ(BUF_ReadFloat32(&buf), 0.0F);
+  EXPECT_EQ(BUF_ReadFloat64(&buf), 0.0);
+  EXPECT_EQ(BUF_ReadFloat64LE(&buf), 0.0);
+  EXPECT_EQ(buf.read_index, 36);
+  EXPECT_EQ(BUF_ReadFloat32(nullptr), 0.0F);
+  EXPECT_EQ(BUF_ReadFloat64LE(nullptr), 0.0);
+}
+
+/** \brief Get and put by index, bounds */
+TEST_F(BUF_Float_UT, GetPutFloat_001)
+{
+  data.assign(12, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_PutFloat32(&buf, 1.0F, 0), 4);
+  EXPECT_EQ(BUF_PutFloat64LE(&buf, -2.5, 4), 8);
+  EXPECT_EQ(BUF_PutFloat32(&buf, 1.0F, 9), 0);
+  EXPECT_EQ(BUF_PutFloat64(&buf, 1.0, 5), 0);
+  EXPECT_EQ(buf.write_index, 0);
+
+  EXPECT_EQ(BUF_GetFloat32(&buf, 0), 1.0F);
+  EXPECT_NE(BUF_GetFloat32LE(&buf, 0), 1.0F);
+  EXPECT_EQ(BUF_GetFloat64LE(&buf, 4), -2.5);
+  EXPECT_EQ(BUF_GetFloat64(&buf, 5), 0.0);
+
+  EXPECT_EQ(BUF_PutFloat64(&buf, -2.5, 4), 8);
+  EXPECT_EQ(BUF_GetFloat64(&buf, 4), -2.5);
+  EXPECT_EQ(BUF_PutFloat32LE(&buf, 1.0F, 0), 4);
+  EXPECT_EQ(BUF_GetFloat32LE(&buf, 0), 1.0F);
+
+  EXPECT_EQ(BUF_GetFloat32(nullptr, 0), 0.0F);
+  EXPECT_EQ(BUF_PutFloat64LE(nullptr, 1.0, 0), 0);
+}
+
+/** \brief Arrays match element accessors, SIMD and tail paths */
+TEST_F(BUF_Float_UT, FloatArray_001)
+{
+  std::vector<float> f32(37);
+  std::vector<double> f64(19);
+  for (std::size_t i = 0; i < f32.size(); i++)
+  {
+    f32[i] = static_cast<float>(i) * -1.5F;
+  }
+  for (std::size_t i = 0; i < f64.size(); i++)
+  {
+    f64[i] = static_cast<double>(i) / 3.0;
+  }
+
+  std::vector<std::uint8_t> expected(2 * (f32.size() * 4 + f64.size() * 8));
+  BUF_InitEmpty(&buf, expected.data(), expected.size());
+  for (auto value : f32)
+  {
+    BUF_WriteFloat32(&buf, value);
+  }
+  for (auto value : f64)
+  {
+    BUF_WriteFloat64(&buf, value);
+  }
+  for (auto value : f32)
+  {
+    BUF_WriteFloat32LE(&buf, value);
+  }
+  for (auto value : f64)
+  {
+    BUF_WriteFloat64LE(&buf, value);
+  }
+
+  data.assign(expected.size(), 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_WriteFloat32Array(&buf, f32.data(), f32.size()), f32.size() * 4);
+  EXPECT_EQ(BUF_WriteFloat64Array(&buf, f64.data(), f64.size()), f64.size() * 8);
+  EXPECT_EQ(BUF_WriteFloat32ArrayLE(&buf, f32.data(), f32.size()), f32.size() * 4);
+  EXPECT_EQ(BUF_WriteFloat64ArrayLE(&buf, f64.data(), f64.size()), f64.size() * 8);
+  EXPECT_THAT(data, ElementsAreArray(expected));
+
+  std::vector<float> f32_read(f32.size());
+  std::vector<double> f64_read(f64.size());
+  EXPECT_EQ(BUF_ReadFloat32Array(&buf, f32_read.data(), f32_read.size()), f32.size() * 4);
+  EXPECT_THAT(f32_read, ElementsAreArray(f32));
+  EXPECT_EQ(BUF_ReadFloat64Array(&buf, f64_read.data(), f64_read.size()), f64.size() * 8);
+  EXPECT_THAT(f64_read, ElementsAreArray(f64));
+  EXPECT_EQ(BUF_ReadFloat32ArrayLE(&buf, f32_read.data(), f32_read.size()), f32.size() * 4);
+  EXPECT_THAT(f32_read, ElementsAreArray(f32));
+  EXPECT_EQ(BUF_ReadFloat64ArrayLE(&buf, f64_read.data(), f64_read.size()), f64.size() * 8);
+  EXPECT_THAT(f64_read, ElementsAreArray(f64));
+}
+
+/** \brief Arrays are all or nothing */
+TEST_F(BUF_Float_UT, FloatArray_002)
+{
+  std::vector<double> f64 = {1.0, 2.0};
+  data.assign(15, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteFloat64Array(&buf, f64.data(), 2), 0);
+  EXPECT_EQ(BUF_WriteFloat64ArrayLE(&buf, f64.data(), 0), 0);
+  EXPECT_EQ(BUF_WriteFloat64ArrayLE(&buf, nullptr, 1), 0);
+  EXPECT_EQ(buf.write_index, 0);
+  EXPECT_EQ(BUF_WriteFloat64ArrayLE(&buf, f64.data(), 1), 8);
+  EXPECT_EQ(BUF_ReadFloat64ArrayLE(&buf, f64.data(), 2), 0);
+  EXPECT_EQ(BUF_ReadFloat32Array(nullptr, nullptr, 1), 0);
+  EXPECT_EQ(buf.read_index, 0);
+}
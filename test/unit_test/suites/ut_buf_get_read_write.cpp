@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <limits>
+
 extern "C" {
 #include "buffer/buffer.h"
 }
@@ -78,6 +80,63 @@ TEST_F(BUF_GetReadWrite_UT, GetUint32_001)
   EXPECT_EQ(value, 0);
 }
 
+TEST_F(BUF_GetReadWrite_UT, GetUint64_001)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x11, 0x22, 0x33};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  auto value = BUF_GetUint64(&buf, 0);
+  EXPECT_EQ(value, 0xAABBCCDDEEFF1122);
+
+  value = BUF_GetUint64(&buf, 1);
+  EXPECT_EQ(value, 0xBBCCDDEEFF112233);
+
+  value = BUF_GetUint64(&buf, 2);
+  EXPECT_EQ(value, 0);
+
+  EXPECT_EQ(BUF_GetUint64(nullptr, 0), 0);
+}
+
+/**
+ * \brief Put uint64 data at index, read and write indexes untouched
+ */
+TEST_F(BUF_GetReadWrite_UT, PutUint64_001)
+{
+  data.assign(9, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_PutUint64(&buf, 0x1122334455667788, 1), 8);
+  EXPECT_EQ(BUF_PutUint64(&buf, 0x1122334455667788, 2), 0);
+  EXPECT_EQ(BUF_PutUint64(nullptr, 0x1122334455667788, 0), 0);
+  EXPECT_EQ(buf.write_index, 0);
+
+  std::vector<std::uint8_t> expected = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+/**
+ * \brief Get and put at index close to BUF_size_t max does not wrap around
+ */
+TEST_F(BUF_GetReadWrite_UT, GetPutIndexOverflow_001)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  const auto max_index = std::numeric_limits<BUF_size_t>::max();
+  for (BUF_size_t index : {max_index, static_cast<BUF_size_t>(max_index - 1), static_cast<BUF_size_t>(max_index - 3)})
+  {
+    EXPECT_EQ(BUF_GetUint16(&buf, index), 0);
+    EXPECT_EQ(BUF_GetUint32(&buf, index), 0);
+    EXPECT_EQ(BUF_PutUint16(&buf, 0x1122, index), 0);
+    EXPECT_EQ(BUF_PutUint32(&buf, 0x11223344, index), 0);
+    EXPECT_EQ(BUF_GetUint64(&buf, index), 0);
+    EXPECT_EQ(BUF_PutUint64(&buf, 0x1122334455667788, index), 0);
+  }
+
+  std::vector<std::uint8_t> expected = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
 /**
  * \brief Get last uint8 data
  */
@@ -147,6 +206,24 @@ TEST_F(BUF_GetReadWrite_UT, ReadUint32_001)
   EXPECT_EQ(BUF_ReadUint32(nullptr), 0x00000000);
 }
 
+/**
+ * \brief Read uint64 data
+ */
+TEST_F(BUF_GetReadWrite_UT, ReadUint64_001)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_ReadUint64(&buf), 0xAABBCCDDEEFF1122);
+  EXPECT_EQ(BUF_ReadUint64(&buf), 0x0000000000000000);
+  EXPECT_EQ(buf.read_index, 8);
+
+  EXPECT_EQ(BUF_ReadUint64(nullptr), 0x0000000000000000);
+
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_ReadUint64(&buf), 0x0000000000000000);
+}
+
 /**
  * \brief Write uint8 data
  */
@@ -238,6 +315,30 @@ TEST_F(BUF_GetReadWrite_UT, WriteUint64_001)
   EXPECT_EQ(BUF_WriteUint64(&buf, 0x0000000000000000), 0);
 }
 
+/**
+ * \brief Write uint16, uint32 and uint64 data not enough space, nothing is
+ * written
+ */
+TEST_F(BUF_GetReadWrite_UT, WriteUint_002)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x11};
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteUint64(&buf, 0x1122334455667788), 0);
+  EXPECT_EQ(buf.write_index, 0);
+
+  EXPECT_EQ(BUF_WriteUint32(&buf, 0x11223344), 4);
+  EXPECT_EQ(BUF_WriteUint32(&buf, 0x55667788), 0);
+  EXPECT_EQ(buf.write_index, 4);
+
+  EXPECT_EQ(BUF_WriteUint16(&buf, 0x5566), 2);
+  EXPECT_EQ(BUF_WriteUint16(&buf, 0x7788), 0);
+  EXPECT_EQ(buf.write_index, 6);
+
+  std::vector<std::uint8_t> expected = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x11};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
 /**
  * \brief Write raw data
  */
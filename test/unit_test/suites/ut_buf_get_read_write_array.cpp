@@ -0,0 +1,220 @@
+//! \file ut_buf_get_read_write_array.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_GetReadWriteArray_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {}
+
+  // Build big-endian reference bytes, long enough to cover SIMD and scalar tail
+  template <typename T>
+  static std::vector<std::uint8_t> to_big_endian(const std::vector<T>& values)
+  {
+    std::vector<std::uint8_t> bytes;
+    for (auto value : values)
+    {
+      for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8)
+      {
+        bytes.push_back(static_cast<std::uint8_t>(value >> shift));
+      }
+    }
+    return bytes;
+  }
+
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+  static constexpr std::size_t COUNT = 37;
+};
+
+/**
+ * \brief Write uint16 array
+ */
+TEST_F(BUF_GetReadWriteArray_UT, WriteUint16Array_001)
+{
+  std::vector<std::uint16_t> values(COUNT);
+  for (std::size_t i = 0; i < COUNT; i++)
+  {
+    values[i] = static_cast<std::uint16_t>(0x0102 * (i + 1));
+  }
+  data.assign(COUNT * 2, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteUint16Array(&buf, values.data(), values.size()), COUNT * 2);
+  EXPECT_EQ(buf.write_index, COUNT * 2);
+  EXPECT_THAT(to_big_endian(values), ElementsAreArray(buf.data, buf.write_index));
+}
+
+/**
+ * \brief Write uint32 array
+ */
+TEST_F(BUF_GetReadWriteArray_UT, WriteUint32Array_001)
+{
+  std::vector<std::uint32_t> values(COUNT);
+  for (std::size_t i = 0; i < COUNT; i++)
+  {
+    values[i] = static_cast<std::uint32_t>(0x01020304 * (i + 1));
+  }
+  data.assign(COUNT * 4, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteUint32Array(&buf, values.data(), values.size()), COUNT * 4);
+  EXPECT_EQ(buf.write_index, COUNT * 4);
+  EXPECT_THAT(to_big_endian(values), ElementsAreArray(buf.data, buf.write_index));
+}
+
+/**
+ * \brief Write array not enough space, nothing is written
+ */
+TEST_F(BUF_GetReadWriteArray_UT, WriteArray_002)
+{
+  std::vector<std::uint16_t> values16 = {0x1122, 0x3344, 0x5566};
+  std::vector<std::uint32_t> values32 = {0x11223344, 0x55667788};
+  data.assign(5, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteUint16Array(&buf, values16.data(), values16.size()), 0);
+  EXPECT_EQ(BUF_WriteUint32Array(&buf, values32.data(), values32.size()), 0);
+  EXPECT_EQ(buf.write_index, 0);
+  EXPECT_THAT(data, Each(Eq(0x00)));
+}
+
+/**
+ * \brief Write array bad input parameters
+ */
+TEST_F(BUF_GetReadWriteArray_UT, WriteArray_003)
+{
+  std::vector<std::uint16_t> values16 = {0x1122};
+  std::vector<std::uint32_t> values32 = {0x11223344};
+  data.assign(8, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteUint16Array(nullptr, values16.data(), 1), 0);
+  EXPECT_EQ(BUF_WriteUint16Array(&buf, nullptr, 1), 0);
+  EXPECT_EQ(BUF_WriteUint16Array(&buf, values16.data(), 0), 0);
+  EXPECT_EQ(BUF_WriteUint32Array(nullptr, values32.data(), 1), 0);
+  EXPECT_EQ(BUF_WriteUint32Array(&buf, nullptr, 1), 0);
+  EXPECT_EQ(BUF_WriteUint32Array(&buf, values32.data(), 0), 0);
+  EXPECT_EQ(buf.write_index, 0);
+}
+
+/**
+ * \brief Read uint16 array
+ */
+TEST_F(BUF_GetReadWriteArray_UT, ReadUint16Array_001)
+{
+  std::vector<std::uint16_t> expected(COUNT);
+  for (std::size_t i = 0; i < COUNT; i++)
+  {
+    expected[i] = static_cast<std::uint16_t>(0xA1B2 + (i * 0x0103));
+  }
+  data = to_big_endian(expected);
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  std::vector<std::uint16_t> values(COUNT);
+  EXPECT_EQ(BUF_ReadUint16Array(&buf, values.data(), values.size()), COUNT * 2);
+  EXPECT_EQ(buf.read_index, COUNT * 2);
+  EXPECT_THAT(values, ElementsAreArray(expected));
+}
+
+/**
+ * \brief Read uint32 array
+ */
+TEST_F(BUF_GetReadWriteArray_UT, ReadUint32Array_001)
+{
+  std::vector<std::uint32_t> expected(COUNT);
+  for (std::size_t i = 0; i < COUNT; i++)
+  {
+    expected[i] = static_cast<std::uint32_t>(0xA1B2C3D4 + (i * 0x01030507));
+  }
+  data = to_big_endian(expected);
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  std::vector<std::uint32_t> values(COUNT);
+  EXPECT_EQ(BUF_ReadUint32Array(&buf, values.data(), values.size()), COUNT * 4);
+  EXPECT_EQ(buf.read_index, COUNT * 4);
+  EXPECT_THAT(values, ElementsAreArray(expected));
+}
+
+/**
+ * \brief Read array not enough data to read, nothing is read
+ */
+TEST_F(BUF_GetReadWriteArray_UT, ReadArray_002)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  std::vector<std::uint16_t> values16(3);
+  std::vector<std::uint32_t> values32(2);
+  EXPECT_EQ(BUF_ReadUint16Array(&buf, values16.data(), values16.size()), 0);
+  EXPECT_EQ(BUF_ReadUint32Array(&buf, values32.data(), values32.size()), 0);
+  EXPECT_EQ(buf.read_index, 0);
+
+  EXPECT_EQ(BUF_ReadUint16Array(nullptr, values16.data(), 1), 0);
+  EXPECT_EQ(BUF_ReadUint16Array(&buf, nullptr, 1), 0);
+  EXPECT_EQ(BUF_ReadUint32Array(nullptr, values32.data(), 1), 0);
+  EXPECT_EQ(BUF_ReadUint32Array(&buf, nullptr, 1), 0);
+}
+
+/**
+ * \brief Get and put arrays by index
+ */
+TEST_F(BUF_GetReadWriteArray_UT, GetPutArray_001)
+{
+  data.assign(2 + (COUNT * 4), 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  std::vector<std::uint32_t> values32(COUNT);
+  for (std::size_t i = 0; i < COUNT; i++)
+  {
+    values32[i] = static_cast<std::uint32_t>(0x10203040 + i);
+  }
+  EXPECT_EQ(BUF_PutUint32Array(&buf, values32.data(), values32.size(), 2), COUNT * 4);
+  EXPECT_EQ(buf.write_index, 0);
+  EXPECT_EQ(BUF_GetUint32(&buf, 2), values32[0]);
+
+  std::vector<std::uint32_t> get32(COUNT);
+  EXPECT_EQ(BUF_GetUint32Array(&buf, get32.data(), get32.size(), 2), COUNT * 4);
+  EXPECT_THAT(get32, ElementsAreArray(values32));
+
+  std::vector<std::uint16_t> values16 = {0x1122, 0x3344};
+  EXPECT_EQ(BUF_PutUint16Array(&buf, values16.data(), values16.size(), 0), 4);
+  std::vector<std::uint16_t> get16(2);
+  EXPECT_EQ(BUF_GetUint16Array(&buf, get16.data(), get16.size(), 0), 4);
+  EXPECT_THAT(get16, ElementsAreArray(values16));
+}
+
+/**
+ * \brief Get and put arrays out of bounds
+ */
+TEST_F(BUF_GetReadWriteArray_UT, GetPutArray_002)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  std::vector<std::uint16_t> values16 = {0x1122, 0x3344};
+  std::vector<std::uint32_t> values32 = {0x11223344};
+  EXPECT_EQ(BUF_PutUint16Array(&buf, values16.data(), values16.size(), 3), 0);
+  EXPECT_EQ(BUF_PutUint32Array(&buf, values32.data(), values32.size(), 3), 0);
+  EXPECT_EQ(BUF_PutUint32Array(&buf, values32.data(), values32.size(), 7), 0);
+  EXPECT_EQ(BUF_GetUint16Array(&buf, values16.data(), values16.size(), 3), 0);
+  EXPECT_EQ(BUF_GetUint32Array(&buf, values32.data(), values32.size(), 3), 0);
+  EXPECT_EQ(BUF_GetUint32Array(nullptr, values32.data(), values32.size(), 0), 0);
+  EXPECT_EQ(BUF_PutUint16Array(nullptr, values16.data(), values16.size(), 0), 0);
+
+  std::vector<std::uint8_t> expected = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
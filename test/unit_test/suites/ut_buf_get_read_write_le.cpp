@@ -0,0 +1,195 @@
+//! \file ut_buf_get_read_write_le.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_GetReadWriteLE_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {}
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+};
+
+TEST_F(BUF_GetReadWriteLE_UT, GetUint16LE_001)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_GetUint16LE(&buf, 0), 0xBBAA);
+  EXPECT_EQ(BUF_GetUint16LE(&buf, 2), 0xDDCC);
+  EXPECT_EQ(BUF_GetUint16LE(&buf, 3), 0);
+  EXPECT_EQ(BUF_GetUint16LE(nullptr, 0), 0);
+}
+
+TEST_F(BUF_GetReadWriteLE_UT, GetUint32LE_001)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_GetUint32LE(&buf, 0), 0xDDCCBBAA);
+  EXPECT_EQ(BUF_GetUint32LE(&buf, 2), 0xFFEEDDCC);
+  EXPECT_EQ(BUF_GetUint32LE(&buf, 3), 0);
+  EXPECT_EQ(BUF_GetUint32LE(nullptr, 0), 0);
+}
+
+TEST_F(BUF_GetReadWriteLE_UT, GetUint64LE_001)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x11, 0x22, 0x33};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_GetUint64LE(&buf, 0), 0x2211FFEEDDCCBBAA);
+  EXPECT_EQ(BUF_GetUint64LE(&buf, 1), 0x332211FFEEDDCCBB);
+  EXPECT_EQ(BUF_GetUint64LE(&buf, 2), 0);
+  EXPECT_EQ(BUF_GetUint64LE(nullptr, 0), 0);
+}
+
+TEST_F(BUF_GetReadWriteLE_UT, PutUint64LE_001)
+{
+  data.assign(9, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_PutUint64LE(&buf, 0x1122334455667788, 1), 8);
+  EXPECT_EQ(BUF_PutUint64LE(&buf, 0x1122334455667788, 2), 0);
+  EXPECT_EQ(BUF_PutUint64LE(nullptr, 0x1122334455667788, 0), 0);
+  EXPECT_EQ(buf.write_index, 0);
+
+  std::vector<std::uint8_t> expected = {0x00, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+TEST_F(BUF_GetReadWriteLE_UT, ReadUint64LE_001)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x11, 0x22, 0x33};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_ReadUint64LE(&buf), 0x2211FFEEDDCCBBAA);
+  EXPECT_EQ(BUF_ReadUint64LE(&buf), 0);
+  EXPECT_EQ(buf.read_index, 8);
+  EXPECT_EQ(BUF_ReadUint64LE(nullptr), 0);
+}
+
+TEST_F(BUF_GetReadWriteLE_UT, PutUint16LE_32LE_001)
+{
+  data.assign(6, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_PutUint16LE(&buf, 0x1122, 0), 2);
+  EXPECT_EQ(BUF_PutUint32LE(&buf, 0x33445566, 2), 4);
+  EXPECT_EQ(BUF_PutUint16LE(&buf, 0x1122, 5), 0);
+  EXPECT_EQ(BUF_PutUint32LE(&buf, 0x33445566, 3), 0);
+  EXPECT_EQ(buf.write_index, 0);
+
+  std::vector<std::uint8_t> expected = {0x22, 0x11, 0x66, 0x55, 0x44, 0x33};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+TEST_F(BUF_GetReadWriteLE_UT, ReadUint16LE_32LE_001)
+{
+  data = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x11};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_ReadUint16LE(&buf), 0xBBAA);
+  EXPECT_EQ(BUF_ReadUint32LE(&buf), 0xFFEEDDCC);
+  EXPECT_EQ(BUF_ReadUint16LE(&buf), 0);
+  EXPECT_EQ(BUF_ReadUint32LE(&buf), 0);
+  EXPECT_EQ(buf.read_index, 6);
+
+  EXPECT_EQ(BUF_ReadUint16LE(nullptr), 0);
+  EXPECT_EQ(BUF_ReadUint32LE(nullptr), 0);
+}
+
+TEST_F(BUF_GetReadWriteLE_UT, WriteUintLE_001)
+{
+  data.assign(14, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteUint16LE(&buf, 0x1122), 2);
+  EXPECT_EQ(BUF_WriteUint32LE(&buf, 0x33445566), 4);
+  EXPECT_EQ(BUF_WriteUint64LE(&buf, 0x778899AABBCCDDEE), 8);
+  EXPECT_EQ(BUF_WriteUint16LE(&buf, 0x1122), 0);
+  EXPECT_EQ(buf.write_index, 14);
+
+  std::vector<std::uint8_t> expected = {
+    0x22, 0x11, 0x66, 0x55, 0x44, 0x33, 0xEE, 0xDD, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+
+  EXPECT_EQ(BUF_WriteUint16LE(nullptr, 0x1122), 0);
+  EXPECT_EQ(BUF_WriteUint32LE(nullptr, 0x11223344), 0);
+  EXPECT_EQ(BUF_WriteUint64LE(nullptr, 0x1122334455667788), 0);
+}
+
+/**
+ * \brief Default byte order is big-endian, view inherits byte order
+ */
+TEST_F(BUF_GetReadWriteLE_UT, Endian_001)
+{
+  data.assign(8, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_GetEndian(&buf), BUF_ENDIAN_BIG);
+  EXPECT_EQ(BUF_GetEndian(nullptr), BUF_ENDIAN_BIG);
+
+  BUF_SetEndian(&buf, BUF_ENDIAN_LITTLE);
+  EXPECT_EQ(BUF_GetEndian(&buf), BUF_ENDIAN_LITTLE);
+
+  BUF_t view;
+  BUF_MakeViewFull(&view, &buf, 2, 4);
+  EXPECT_EQ(BUF_GetEndian(&view), BUF_ENDIAN_LITTLE);
+
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_GetEndian(&buf), BUF_ENDIAN_BIG);
+  BUF_SetEndian(nullptr, BUF_ENDIAN_LITTLE);
+}
+
+/**
+ * \brief Auto accessors follow buffer byte order
+ */
+TEST_F(BUF_GetReadWriteLE_UT, Auto_001)
+{
+  data.assign(14, 0x00);
+  for (auto endian : {BUF_ENDIAN_BIG, BUF_ENDIAN_LITTLE})
+  {
+    BUF_InitEmpty(&buf, data.data(), data.size());
+    BUF_SetEndian(&buf, endian);
+
+    EXPECT_EQ(BUF_WriteUint16Auto(&buf, 0x1122), 2);
+    EXPECT_EQ(BUF_WriteUint32Auto(&buf, 0x33445566), 4);
+    EXPECT_EQ(BUF_WriteUint64Auto(&buf, 0x778899AABBCCDDEE), 8);
+
+    if (endian == BUF_ENDIAN_BIG)
+    {
+      EXPECT_EQ(data[0], 0x11);
+      EXPECT_EQ(BUF_GetUint32(&buf, 2), 0x33445566);
+    }
+    else
+    {
+      EXPECT_EQ(data[0], 0x22);
+      EXPECT_EQ(BUF_GetUint32LE(&buf, 2), 0x33445566);
+    }
+    EXPECT_EQ(BUF_GetUint16Auto(&buf, 0), 0x1122);
+    EXPECT_EQ(BUF_GetUint32Auto(&buf, 2), 0x33445566);
+    EXPECT_EQ(BUF_ReadUint16Auto(&buf), 0x1122);
+    EXPECT_EQ(BUF_ReadUint32Auto(&buf), 0x33445566);
+    EXPECT_EQ(BUF_GetUint64Auto(&buf, 6), 0x778899AABBCCDDEE);
+    EXPECT_EQ(BUF_ReadUint64Auto(&buf), 0x778899AABBCCDDEE);
+
+    EXPECT_EQ(BUF_PutUint16Auto(&buf, 0xA1A2, 0), 2);
+    EXPECT_EQ(BUF_PutUint32Auto(&buf, 0xB1B2B3B4, 2), 4);
+    EXPECT_EQ(BUF_GetUint16Auto(&buf, 0), 0xA1A2);
+    EXPECT_EQ(BUF_GetUint32Auto(&buf, 2), 0xB1B2B3B4);
+    EXPECT_EQ(BUF_PutUint64Auto(&buf, 0xC1C2C3C4C5C6C7C8, 6), 8);
+    EXPECT_EQ(BUF_GetUint64Auto(&buf, 6), 0xC1C2C3C4C5C6C7C8);
+  }
+}
@@ -0,0 +1,105 @@
+//! \file ut_buf_inline.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+extern "C" {
+#include "buffer/buffer_inline.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Inline_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {}
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+};
+
+/**
+ * \brief Inline write then read back, big-endian layout
+ */
+TEST_F(BUF_Inline_UT, WriteRead_001)
+{
+  data.assign(15, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_InlineWriteUint8(&buf, 0x11), 1);
+  EXPECT_EQ(BUF_InlineWriteUint16(&buf, 0x2233), 2);
+  EXPECT_EQ(BUF_InlineWriteUint32(&buf, 0x44556677), 4);
+  EXPECT_EQ(BUF_InlineWriteUint64(&buf, 0x8899AABBCCDDEEFF), 8);
+  EXPECT_EQ(buf.write_index, 15);
+
+  std::vector<std::uint8_t> expected = {
+    0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+
+  EXPECT_EQ(BUF_InlineReadUint8(&buf), 0x11);
+  EXPECT_EQ(BUF_InlineReadUint16(&buf), 0x2233);
+  EXPECT_EQ(BUF_InlineReadUint32(&buf), 0x44556677);
+  EXPECT_EQ(BUF_InlineReadUint32(&buf), 0x8899AABB);
+  EXPECT_EQ(buf.read_index, 11);
+}
+
+/**
+ * \brief Inline write not enough space, nothing is written
+ */
+TEST_F(BUF_Inline_UT, Write_002)
+{
+  data = {0xAA, 0xBB, 0xCC};
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_InlineWriteUint64(&buf, 0x1122334455667788), 0);
+  EXPECT_EQ(BUF_InlineWriteUint32(&buf, 0x11223344), 0);
+  EXPECT_EQ(BUF_InlineWriteUint16(&buf, 0x1122), 2);
+  EXPECT_EQ(BUF_InlineWriteUint16(&buf, 0x3344), 0);
+  EXPECT_EQ(BUF_InlineWriteUint8(&buf, 0x33), 1);
+  EXPECT_EQ(BUF_InlineWriteUint8(&buf, 0x44), 0);
+  EXPECT_EQ(buf.write_index, 3);
+
+  std::vector<std::uint8_t> expected = {0x11, 0x22, 0x33};
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+/**
+ * \brief Inline read not enough data, nothing is read
+ */
+TEST_F(BUF_Inline_UT, Read_002)
+{
+  data = {0xAA, 0xBB, 0xCC};
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_InlineReadUint32(&buf), 0);
+  EXPECT_EQ(BUF_InlineReadUint16(&buf), 0xAABB);
+  EXPECT_EQ(BUF_InlineReadUint16(&buf), 0);
+  EXPECT_EQ(BUF_InlineReadUint8(&buf), 0xCC);
+  EXPECT_EQ(BUF_InlineReadUint8(&buf), 0);
+  EXPECT_EQ(buf.read_index, 3);
+}
+
+/**
+ * \brief Inline bad input parameters
+ */
+TEST_F(BUF_Inline_UT, BadParameter_001)
+{
+  EXPECT_EQ(BUF_InlineWriteUint8(nullptr, 0x11), 0);
+  EXPECT_EQ(BUF_InlineWriteUint16(nullptr, 0x1122), 0);
+  EXPECT_EQ(BUF_InlineWriteUint32(nullptr, 0x11223344), 0);
+  EXPECT_EQ(BUF_InlineWriteUint64(nullptr, 0x1122334455667788), 0);
+  EXPECT_EQ(BUF_InlineReadUint8(nullptr), 0);
+  EXPECT_EQ(BUF_InlineReadUint16(nullptr), 0);
+  EXPECT_EQ(BUF_InlineReadUint32(nullptr), 0);
+
+  data.assign(8, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  buf.data = nullptr;
+  EXPECT_EQ(BUF_InlineWriteUint32(&buf, 0x11223344), 0);
+  EXPECT_EQ(buf.write_index, 0);
+}
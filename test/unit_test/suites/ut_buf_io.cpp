@@ -0,0 +1,350 @@
+//! \file ut_buf_io.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_io.h"
+}
+
+#if defined(BUF_IO_ENABLE)
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Io_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    ASSERT_EQ(pipe(fds), 0);
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<std::uint8_t>(i);
+    }
+    BUF_InitFull(&src, data.data(), data.size());
+    BUF_InitEmpty(&dst, received.data(), received.size());
+  }
+
+  void TearDown()
+  {
+    close(fds[0]);
+    close(fds[1]);
+  }
+
+  static void SetNonBlocking(int fd)
+  {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  }
+
+  // attributes
+  int fds[2];
+  std::vector<std::uint8_t> data = std::vector<std::uint8_t>(100);
+  std::vector<std::uint8_t> received = std::vector<std::uint8_t>(100);
+  BUF_t src;
+  BUF_t dst;
+  BUF_IoStatus_t status = BUF_IO_ERROR;
+};
+
+/**
+ * \brief Buffer to pipe to buffer, indices moved
+ */
+TEST_F(BUF_Io_UT, WriteReadFd_001)
+{
+  EXPECT_EQ(BUF_WriteToFd(&src, fds[1], &status), 100);
+  EXPECT_EQ(status, BUF_IO_OK);
+  EXPECT_EQ(src.read_index, 100);
+
+  EXPECT_EQ(BUF_ReadFromFd(&dst, fds[0], &status), 100);
+  EXPECT_EQ(status, BUF_IO_OK);
+  EXPECT_EQ(dst.write_index, 100);
+  EXPECT_THAT(received, ElementsAreArray(data));
+}
+
+/**
+ * \brief Read of empty non-blocking pipe, of closed pipe, in full buffer
+ */
+TEST_F(BUF_Io_UT, ReadFromFd_001)
+{
+  SetNonBlocking(fds[0]);
+  EXPECT_EQ(BUF_ReadFromFd(&dst, fds[0], &status), 0);
+  EXPECT_EQ(status, BUF_IO_AGAIN);
+
+  EXPECT_EQ(BUF_ReadFromFd(&src, fds[0], &status), 0);
+  EXPECT_EQ(status, BUF_IO_OK);
+
+  close(fds[1]);
+  fds[1] = -1;
+  EXPECT_EQ(BUF_ReadFromFd(&dst, fds[0], &status), 0);
+  EXPECT_EQ(status, BUF_IO_EOF);
+  EXPECT_EQ(dst.write_index, 0);
+}
+
+/**
+ * \brief Invalid parameters and descriptor
+ */
+TEST_F(BUF_Io_UT, ReadWriteFd_002)
+{
+  EXPECT_EQ(BUF_ReadFromFd(nullptr, fds[0], &status), 0);
+  EXPECT_EQ(status, BUF_IO_ERROR);
+  EXPECT_EQ(BUF_WriteToFd(nullptr, fds[1], &status), 0);
+  EXPECT_EQ(status, BUF_IO_ERROR);
+  EXPECT_EQ(BUF_ReadFromFd(&dst, -1, &status), 0);
+  EXPECT_EQ(status, BUF_IO_ERROR);
+  EXPECT_EQ(BUF_WriteToFd(&src, -1, &status), 0);
+  EXPECT_EQ(status, BUF_IO_ERROR);
+  EXPECT_EQ(src.read_index, 0);
+  EXPECT_EQ(BUF_ReadvFromFd(nullptr, 1, fds[0], &status), 0);
+  EXPECT_EQ(status, BUF_IO_ERROR);
+  EXPECT_EQ(BUF_WritevToFd(nullptr, 1, fds[1], nullptr), 0);
+}
+
+/**
+ * \brief Short writes on small socket buffer are continued, EAGAIN reported
+ * with bytes written so far
+ */
+TEST_F(BUF_Io_UT, WriteToFd_001)
+{
+  int sv[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+  int size = 4096;
+  setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+  SetNonBlocking(sv[0]);
+  SetNonBlocking(sv[1]);
+
+  std::vector<std::uint8_t> big(60000);
+  std::vector<std::uint8_t> out(big.size());
+  for (std::size_t i = 0; i < big.size(); i++)
+  {
+    big[i] = static_cast<std::uint8_t>(i * 7U);
+  }
+  BUF_InitFull(&src, big.data(), big.size());
+  BUF_InitEmpty(&dst, out.data(), out.size());
+
+  std::size_t written = BUF_WriteToFd(&src, sv[0], &status);
+  EXPECT_EQ(status, BUF_IO_AGAIN);
+  EXPECT_LT(written, big.size());
+  EXPECT_EQ(src.read_index, written);
+
+  while (!BUF_IsFull(&dst))
+  {
+    BUF_ReadFromFd(&dst, sv[1], &status);
+    ASSERT_NE(status, BUF_IO_ERROR);
+    written += BUF_WriteToFd(&src, sv[0], &status);
+  }
+  EXPECT_EQ(written, big.size());
+  EXPECT_EQ(status, BUF_IO_OK);
+  EXPECT_THAT(out, ElementsAreArray(big));
+
+  close(sv[0]);
+  close(sv[1]);
+}
+
+/**
+ * \brief One readv fills buffers in order
+ */
+TEST_F(BUF_Io_UT, ReadvFromFd_001)
+{
+  ASSERT_EQ(write(fds[1], data.data(), 10), 10);
+
+  BUF_t bufs[2];
+  BUF_InitEmpty(&bufs[0], received.data(), 4);
+  BUF_InitEmpty(&bufs[1], &received[4], 8);
+  EXPECT_EQ(BUF_ReadvFromFd(bufs, 2, fds[0], &status), 10);
+  EXPECT_EQ(status, BUF_IO_OK);
+  EXPECT_EQ(bufs[0].write_index, 4);
+  EXPECT_EQ(bufs[1].write_index, 6);
+  EXPECT_THAT(std::vector<std::uint8_t>(received.begin(), received.begin() + 10),
+              ElementsAreArray(data.data(), 10));
+
+  EXPECT_EQ(BUF_ReadvFromFd(bufs, 1, fds[0], &status), 0);
+  EXPECT_EQ(status, BUF_IO_OK);
+
+  close(fds[1]);
+  fds[1] = -1;
+  EXPECT_EQ(BUF_ReadvFromFd(bufs, 2, fds[0], &status), 0);
+  EXPECT_EQ(status, BUF_IO_EOF);
+}
+
+/**
+ * \brief Header and payload buffers sent with writev, empty buffer skipped
+ */
+TEST_F(BUF_Io_UT, WritevToFd_001)
+{
+  int sv[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+
+  std::vector<std::uint8_t> header(4);
+  BUF_t bufs[3];
+  BUF_InitEmpty(&bufs[0], header.data(), header.size());
+  BUF_WriteUint32(&bufs[0], 0xA1B2C3D4);
+  BUF_InitEmpty(&bufs[1], received.data(), 8);
+  BUF_InitFull(&bufs[2], data.data(), 20);
+  BUF_Consume(&bufs[2], 2);
+
+  EXPECT_EQ(BUF_WritevToFd(bufs, 3, sv[0], &status), 22);
+  EXPECT_EQ(status, BUF_IO_OK);
+  EXPECT_EQ(BUF_GetToReadCount(&bufs[0]), 0);
+  EXPECT_EQ(BUF_GetToReadCount(&bufs[2]), 0);
+
+  std::vector<std::uint8_t> out(22);
+  ASSERT_EQ(read(sv[1], out.data(), out.size()), 22);
+  std::vector<std::uint8_t> expected = {0xA1, 0xB2, 0xC3, 0xD4};
+  expected.insert(expected.end(), data.begin() + 2, data.begin() + 20);
+  EXPECT_THAT(out, ElementsAreArray(expected));
+
+  EXPECT_EQ(BUF_WritevToFd(bufs, 3, sv[0], &status), 0);
+  EXPECT_EQ(status, BUF_IO_OK);
+
+  close(sv[0]);
+  close(sv[1]);
+}
+
+/**
+ * \brief Short writev continued across buffers
+ */
+TEST_F(BUF_Io_UT, WritevToFd_002)
+{
+  int sv[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+  int size = 4096;
+  setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+  SetNonBlocking(sv[0]);
+  SetNonBlocking(sv[1]);
+
+  std::vector<std::uint8_t> big(3 * 20000);
+  std::vector<std::uint8_t> out(big.size());
+  for (std::size_t i = 0; i < big.size(); i++)
+  {
+    big[i] = static_cast<std::uint8_t>(i * 13U);
+  }
+  BUF_t bufs[3];
+  for (std::size_t i = 0; i < 3; i++)
+  {
+    BUF_InitFull(&bufs[i], &big[i * 20000], 20000);
+  }
+  BUF_InitEmpty(&dst, out.data(), out.size());
+
+  std::size_t written = BUF_WritevToFd(bufs, 3, sv[0], &status);
+  EXPECT_EQ(status, BUF_IO_AGAIN);
+  while (!BUF_IsFull(&dst))
+  {
+    BUF_ReadFromFd(&dst, sv[1], &status);
+    ASSERT_NE(status, BUF_IO_ERROR);
+    written += BUF_WritevToFd(bufs, 3, sv[0], &status);
+  }
+  EXPECT_EQ(written, big.size());
+  EXPECT_EQ(status, BUF_IO_OK);
+  EXPECT_THAT(out, ElementsAreArray(big));
+
+  close(sv[0]);
+  close(sv[1]);
+}
+
+class BUF_Map_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    content.resize(200000);
+    for (std::size_t i = 0; i < content.size(); i++)
+    {
+      content[i] = static_cast<std::uint8_t>((i * 31U) ^ (i >> 8U));
+    }
+    ASSERT_EQ(write(fd, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+    close(fd);
+  }
+
+  void TearDown()
+  {
+    unlink(path);
+  }
+
+  // attributes
+  char path[32] = "/tmp/ut_buf_map_XXXXXX";
+  std::vector<std::uint8_t> content;
+  BUF_Map_t map;
+  BUF_t buf;
+};
+
+/**
+ * \brief Whole file walked by windows, unread bytes kept across windows
+ */
+TEST_F(BUF_Map_UT, MapFile_001)
+{
+  ASSERT_TRUE(BUF_MapFile(&map, &buf, path, BUF_MAP_READ_ONLY));
+  EXPECT_EQ(buf.read_index, 0);
+  EXPECT_EQ(buf.write_index, buf.size);
+  EXPECT_LE(buf.size, content.size());
+
+  std::vector<std::uint8_t> out;
+  do
+  {
+    // leave a record split across windows to read after BUF_MapNext
+    while (BUF_GetToReadCount(&buf) >= 3)
+    {
+      std::uint8_t record[3];
+      BUF_ReadRaw(&buf, record, sizeof(record));
+      out.insert(out.end(), record, record + sizeof(record));
+    }
+  } while (BUF_MapNext(&map, &buf));
+
+  std::uint8_t tail[2];
+  BUF_size_t tail_size = BUF_GetToReadCount(&buf);
+  ASSERT_EQ(tail_size, content.size() % 3);
+  BUF_ReadRaw(&buf, tail, tail_size);
+  out.insert(out.end(), tail, tail + tail_size);
+  EXPECT_THAT(out, ElementsAreArray(content));
+
+  BUF_Unmap(&map, &buf);
+  EXPECT_EQ(BUF_GetData(&buf), nullptr);
+  EXPECT_EQ(BUF_GetToReadCount(&buf), 0);
+}
+
+/**
+ * \brief Private mapping is writable, file is unchanged
+ */
+TEST_F(BUF_Map_UT, MapFile_002)
+{
+  ASSERT_TRUE(BUF_MapFile(&map, &buf, path, BUF_MAP_PRIVATE));
+  BUF_PutUint32(&buf, 0xDEADBEEF, 0);
+  EXPECT_EQ(BUF_ReadUint32(&buf), 0xDEADBEEF);
+  BUF_Unmap(&map, &buf);
+
+  ASSERT_TRUE(BUF_MapFile(&map, &buf, path, BUF_MAP_READ_ONLY));
+  EXPECT_EQ(BUF_ReadUint8(&buf), content[0]);
+  BUF_Unmap(&map, &buf);
+}
+
+/**
+ * \brief Missing file, empty file, NULL parameters
+ */
+TEST_F(BUF_Map_UT, MapFile_003)
+{
+  EXPECT_FALSE(BUF_MapFile(&map, &buf, "/nonexistent/ut_buf_map", BUF_MAP_READ_ONLY));
+  EXPECT_EQ(BUF_GetData(&buf), nullptr);
+  EXPECT_FALSE(BUF_MapFile(nullptr, &buf, path, BUF_MAP_READ_ONLY));
+  EXPECT_FALSE(BUF_MapFile(&map, nullptr, path, BUF_MAP_READ_ONLY));
+  EXPECT_FALSE(BUF_MapFile(&map, &buf, nullptr, BUF_MAP_READ_ONLY));
+
+  ASSERT_EQ(truncate(path, 0), 0);
+  ASSERT_TRUE(BUF_MapFile(&map, &buf, path, BUF_MAP_READ_ONLY));
+  EXPECT_TRUE(BUF_IsEmpty(&buf));
+  EXPECT_FALSE(BUF_MapNext(&map, &buf));
+  BUF_Unmap(&map, &buf);
+  BUF_Unmap(&map, nullptr);
+}
+
+#endif
@@ -0,0 +1,153 @@
+//! \file ut_buf_pack.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_pack.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+typedef struct {
+  std::uint8_t kind;
+  std::uint16_t id;
+  std::uint32_t timestamp;
+  std::int16_t axis[3];
+  std::uint32_t bins[2];
+  std::uint64_t sequence;
+} ut_msg_t;
+
+#define UT_MSG_FIELDS(X)                            \
+  X(kind, BUF_FIELD_UINT8, BUF_ENDIAN_BIG)          \
+  X(id, BUF_FIELD_UINT16, BUF_ENDIAN_BIG)           \
+  X(timestamp, BUF_FIELD_UINT32, BUF_ENDIAN_LITTLE) \
+  X(axis, BUF_FIELD_UINT16, BUF_ENDIAN_LITTLE)      \
+  X(bins, BUF_FIELD_UINT32, BUF_ENDIAN_BIG)         \
+  X(sequence, BUF_FIELD_UINT64, BUF_ENDIAN_BIG)
+
+BUF_PACK_DEFINE(UtMsg, ut_msg_t, UT_MSG_FIELDS)
+
+class BUF_Pack_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    std::memset(&msg, 0, sizeof(msg));
+    msg.kind      = 0xA5;
+    msg.id        = 0x1234;
+    msg.timestamp = 0x89ABCDEF;
+    msg.axis[0]   = 1;
+    msg.axis[1]   = -2;
+    msg.axis[2]   = 0x0304;
+    msg.bins[0]   = 0x01020304;
+    msg.bins[1]   = 0x05060708;
+    msg.sequence  = 0x1122334455667788ULL;
+    BUF_InitEmpty(&buf, data.data(), data.size());
+  }
+
+  // attributes
+  ut_msg_t msg;
+  std::array<std::uint8_t, 64> data{};
+  BUF_t buf;
+};
+
+// Wire bytes of msg, in field order
+static const std::array<std::uint8_t, 29> ut_msg_wire = {
+  0xA5,                                           // kind
+  0x12, 0x34,                                     // id, big-endian
+  0xEF, 0xCD, 0xAB, 0x89,                         // timestamp, little-endian
+  0x01, 0x00, 0xFE, 0xFF, 0x04, 0x03,             // axis, little-endian
+  0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, // bins, big-endian
+  0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, // sequence, big-endian
+};
+
+/** \brief Packed size is the sum of fields, without struct padding */
+TEST_F(BUF_Pack_UT, GetSize_001)
+{
+  EXPECT_EQ(29U, UtMsgGetSize());
+  EXPECT_GT(sizeof(ut_msg_t), 29U);
+}
+
+/** \brief Pack writes fields in list order and byte order */
+TEST_F(BUF_Pack_UT, Pack_001)
+{
+  EXPECT_EQ(29U, UtMsgPack(&buf, &msg));
+  EXPECT_EQ(29U, BUF_GetUsedSize(&buf));
+  EXPECT_THAT(std::vector<std::uint8_t>(data.begin(), data.begin() + 29), ElementsAreArray(ut_msg_wire));
+}
+
+/** \brief Pack is all or nothing */
+TEST_F(BUF_Pack_UT, Pack_002)
+{
+  BUF_InitEmpty(&buf, data.data(), 28U);
+
+  EXPECT_EQ(0U, UtMsgPack(&buf, &msg));
+  EXPECT_EQ(0U, BUF_GetUsedSize(&buf));
+  EXPECT_EQ(0U, data[0]);
+}
+
+/** \brief Unpack reads back the packed struct */
+TEST_F(BUF_Pack_UT, Unpack_001)
+{
+  ut_msg_t out;
+  std::memset(&out, 0, sizeof(out));
+  std::memcpy(data.data(), ut_msg_wire.data(), ut_msg_wire.size());
+  BUF_InitFull(&buf, data.data(), ut_msg_wire.size());
+
+  EXPECT_EQ(29U, UtMsgUnpack(&buf, &out));
+  EXPECT_EQ(0U, BUF_GetToReadCount(&buf));
+  EXPECT_EQ(0, std::memcmp(&msg, &out, sizeof(out)));
+}
+
+/** \brief Unpack is all or nothing */
+TEST_F(BUF_Pack_UT, Unpack_002)
+{
+  ut_msg_t out;
+  std::memset(&out, 0x5A, sizeof(out));
+  ut_msg_t untouched = out;
+  BUF_InitFull(&buf, data.data(), 28U);
+
+  EXPECT_EQ(0U, UtMsgUnpack(&buf, &out));
+  EXPECT_EQ(28U, BUF_GetToReadCount(&buf));
+  EXPECT_EQ(0, std::memcmp(&untouched, &out, sizeof(out)));
+}
+
+/** \brief Consecutive structs round trip */
+TEST_F(BUF_Pack_UT, RoundTrip_001)
+{
+  ut_msg_t second = msg;
+  second.id       = 0xBEEF;
+  second.axis[2]  = -32768;
+  ut_msg_t out[2];
+  std::memset(out, 0, sizeof(out));
+
+  EXPECT_EQ(29U, UtMsgPack(&buf, &msg));
+  EXPECT_EQ(29U, UtMsgPack(&buf, &second));
+  EXPECT_EQ(29U, UtMsgUnpack(&buf, &out[0]));
+  EXPECT_EQ(29U, UtMsgUnpack(&buf, &out[1]));
+  EXPECT_EQ(0, std::memcmp(&msg, &out[0], sizeof(msg)));
+  EXPECT_EQ(0, std::memcmp(&second, &out[1], sizeof(second)));
+  EXPECT_EQ(0U, UtMsgUnpack(&buf, &out[0]));
+}
+
+/** \brief NULL parameters */
+TEST_F(BUF_Pack_UT, Null_001)
+{
+  BUF_t no_data = {};
+
+  EXPECT_EQ(0U, UtMsgPack(NULL, &msg));
+  EXPECT_EQ(0U, UtMsgPack(&buf, NULL));
+  EXPECT_EQ(0U, UtMsgPack(&no_data, &msg));
+  EXPECT_EQ(0U, UtMsgUnpack(NULL, &msg));
+  EXPECT_EQ(0U, UtMsgUnpack(&buf, NULL));
+  EXPECT_EQ(0U, UtMsgUnpack(&no_data, &msg));
+}
@@ -0,0 +1,95 @@
+//! \file ut_buf_peek_consume.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_PeekConsume_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    data = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+    BUF_InitFull(&buf, data.data(), data.size());
+  }
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+};
+
+/**
+ * \brief ReadRaw copies and moves read_index
+ */
+TEST_F(BUF_PeekConsume_UT, ReadRaw_001)
+{
+  std::vector<std::uint8_t> dst(5, 0x00);
+  EXPECT_EQ(BUF_ReadUint8(&buf), 0x11);
+  EXPECT_EQ(BUF_ReadRaw(&buf, dst.data(), 5), 5);
+  EXPECT_EQ(buf.read_index, 6);
+
+  std::vector<std::uint8_t> expected = {0x22, 0x33, 0x44, 0x55, 0x66};
+  EXPECT_THAT(dst, ElementsAreArray(expected));
+}
+
+/**
+ * \brief ReadRaw is all or nothing
+ */
+TEST_F(BUF_PeekConsume_UT, ReadRaw_002)
+{
+  std::vector<std::uint8_t> dst(9, 0x00);
+  EXPECT_EQ(BUF_ReadRaw(&buf, dst.data(), 9), 0);
+  EXPECT_EQ(BUF_ReadRaw(&buf, dst.data(), 0), 0);
+  EXPECT_EQ(BUF_ReadRaw(&buf, nullptr, 1), 0);
+  EXPECT_EQ(BUF_ReadRaw(nullptr, dst.data(), 1), 0);
+  EXPECT_EQ(BUF_ReadRaw(&buf, &data[2], 4), 0);
+  EXPECT_EQ(buf.read_index, 0);
+  EXPECT_THAT(dst, Each(Eq(0x00)));
+}
+
+/**
+ * \brief Peek borrows data to read, Consume releases it
+ */
+TEST_F(BUF_PeekConsume_UT, PeekConsume_001)
+{
+  BUF_ReadUint16(&buf);
+
+  BUF_size_t size = 0;
+  const std::uint8_t* bytes = BUF_Peek(&buf, &size);
+  ASSERT_EQ(bytes, &data[2]);
+  EXPECT_EQ(size, 6);
+  EXPECT_EQ(buf.read_index, 2);
+
+  EXPECT_EQ(BUF_Consume(&buf, 4), 4);
+  EXPECT_EQ(BUF_ReadUint16(&buf), 0x7788);
+  EXPECT_EQ(BUF_Peek(&buf, &size), nullptr);
+  EXPECT_EQ(size, 0);
+}
+
+/**
+ * \brief Consume over data to read is refused, NULL parameters
+ */
+TEST_F(BUF_PeekConsume_UT, PeekConsume_002)
+{
+  BUF_size_t size = 3;
+  EXPECT_EQ(BUF_Consume(&buf, 9), 0);
+  EXPECT_EQ(BUF_Consume(&buf, 0), 0);
+  EXPECT_EQ(BUF_Consume(nullptr, 1), 0);
+  EXPECT_EQ(buf.read_index, 0);
+
+  EXPECT_EQ(BUF_Peek(nullptr, &size), nullptr);
+  EXPECT_EQ(size, 0);
+  EXPECT_EQ(BUF_Peek(&buf, nullptr), data.data());
+
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_Peek(&buf, &size), nullptr);
+  EXPECT_EQ(BUF_Consume(&buf, 1), 0);
+}
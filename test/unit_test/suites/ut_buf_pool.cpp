@@ -0,0 +1,217 @@
+//! \file ut_buf_pool.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_pool.h"
+}
+
+using namespace testing;
+
+class BUF_Pool_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    ASSERT_TRUE(BUF_PoolInit(&pool, arena, sizeof(arena), DATA_SIZE));
+  }
+
+  // attributes
+  static constexpr BUF_size_t DATA_SIZE = 30;
+  static constexpr std::size_t BLOCK_COUNT = 4;
+  BUF_Pool_t pool;
+  alignas(BUF_POOL_ALIGNMENT) std::uint8_t arena[BUF_POOL_ARENA_SIZE(BLOCK_COUNT, DATA_SIZE) + 3];
+};
+
+/**
+ * \brief Init carves arena in blocks
+ */
+TEST_F(BUF_Pool_UT, Init_001)
+{
+  BUF_Pool_t other;
+  EXPECT_FALSE(BUF_PoolInit(nullptr, arena, sizeof(arena), DATA_SIZE));
+  EXPECT_FALSE(BUF_PoolInit(&other, nullptr, sizeof(arena), DATA_SIZE));
+  EXPECT_FALSE(BUF_PoolInit(&other, arena, BUF_POOL_BLOCK_SIZE(DATA_SIZE) - 1, DATA_SIZE));
+  EXPECT_FALSE(BUF_PoolInit(&other, &arena[1], sizeof(arena) - 1, DATA_SIZE));
+
+  EXPECT_EQ(BUF_PoolGetBlockCount(&pool), BLOCK_COUNT);
+  EXPECT_EQ(BUF_PoolGetUsedCount(&pool), 0);
+  EXPECT_EQ(BUF_PoolGetHighWaterMark(&pool), 0);
+  EXPECT_EQ(BUF_PoolGetFailedCount(&pool), 0);
+  EXPECT_EQ(BUF_PoolGetBlockCount(nullptr), 0);
+}
+
+/**
+ * \brief Acquired buffers are empty, disjoint and inside arena
+ */
+TEST_F(BUF_Pool_UT, Acquire_001)
+{
+  std::vector<BUF_t*> buffers;
+  for (std::size_t i = 0; i < BLOCK_COUNT; i++)
+  {
+    BUF_t* buffer = BUF_PoolAcquire(&pool);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(BUF_GetSize(buffer), DATA_SIZE);
+    EXPECT_TRUE(BUF_IsEmpty(buffer));
+    EXPECT_GE(BUF_GetData(buffer), arena);
+    EXPECT_LE(BUF_GetData(buffer) + DATA_SIZE, arena + sizeof(arena));
+    EXPECT_EQ(BUF_FillPattern(buffer, static_cast<std::uint8_t>(i), DATA_SIZE), DATA_SIZE);
+    buffers.push_back(buffer);
+  }
+  for (std::size_t i = 0; i < BLOCK_COUNT; i++)
+  {
+    for (BUF_size_t j = 0; j < DATA_SIZE; j++)
+    {
+      ASSERT_EQ(BUF_GetUint8(buffers[i], j), i);
+    }
+  }
+
+  EXPECT_EQ(BUF_PoolAcquire(&pool), nullptr);
+  EXPECT_EQ(BUF_PoolGetUsedCount(&pool), BLOCK_COUNT);
+  EXPECT_EQ(BUF_PoolGetFailedCount(&pool), 1);
+}
+
+/**
+ * \brief Released block is reused and reinitialized
+ */
+TEST_F(BUF_Pool_UT, Release_001)
+{
+  BUF_t* first  = BUF_PoolAcquire(&pool);
+  BUF_t* second = BUF_PoolAcquire(&pool);
+  BUF_WriteUint32(first, 0x01020304);
+
+  EXPECT_TRUE(BUF_PoolRelease(&pool, first));
+  EXPECT_EQ(BUF_PoolGetUsedCount(&pool), 1);
+  EXPECT_EQ(BUF_PoolGetHighWaterMark(&pool), 2);
+
+  BUF_t* again = BUF_PoolAcquire(&pool);
+  EXPECT_EQ(again, first);
+  EXPECT_TRUE(BUF_IsEmpty(again));
+  EXPECT_TRUE(BUF_PoolRelease(&pool, again));
+  EXPECT_TRUE(BUF_PoolRelease(&pool, second));
+  EXPECT_EQ(BUF_PoolGetUsedCount(&pool), 0);
+  EXPECT_EQ(BUF_PoolGetHighWaterMark(&pool), 2);
+}
+
+/**
+ * \brief Release of a buffer not from pool
+ */
+TEST_F(BUF_Pool_UT, Release_002)
+{
+  BUF_t other;
+  BUF_t* buffer = BUF_PoolAcquire(&pool);
+
+  EXPECT_FALSE(BUF_PoolRelease(&pool, &other));
+  EXPECT_FALSE(BUF_PoolRelease(&pool, reinterpret_cast<BUF_t*>(arena)));
+  EXPECT_FALSE(BUF_PoolRelease(&pool, reinterpret_cast<BUF_t*>(reinterpret_cast<std::uint8_t*>(buffer) + 8)));
+  EXPECT_FALSE(BUF_PoolRelease(&pool, nullptr));
+  EXPECT_FALSE(BUF_PoolRelease(nullptr, buffer));
+  EXPECT_EQ(BUF_PoolGetUsedCount(&pool), 1);
+}
+
+/**
+ * \brief Second release of a block is rejected
+ */
+TEST_F(BUF_Pool_UT, Release_003)
+{
+  BUF_t* first  = BUF_PoolAcquire(&pool);
+  BUF_t* second = BUF_PoolAcquire(&pool);
+  auto* never   = reinterpret_cast<BUF_t*>(&arena[(BLOCK_COUNT - 1) * BUF_POOL_BLOCK_SIZE(DATA_SIZE)
+                                                + BUF_POOL_ALIGN(sizeof(std::uint32_t))]);
+
+  EXPECT_TRUE(BUF_PoolRelease(&pool, first));
+  EXPECT_FALSE(BUF_PoolRelease(&pool, first));
+  EXPECT_FALSE(BUF_PoolRelease(&pool, never));
+  EXPECT_EQ(BUF_PoolGetUsedCount(&pool), 1);
+
+  EXPECT_EQ(BUF_PoolAcquire(&pool), first);
+  EXPECT_NE(BUF_PoolAcquire(&pool), first);
+  EXPECT_TRUE(BUF_PoolRelease(&pool, second));
+  EXPECT_FALSE(BUF_PoolRelease(&pool, second));
+}
+
+#if defined(BUF_POOL_ATOMIC_ENABLE)
+
+/**
+ * \brief Atomic variant on one thread
+ */
+TEST_F(BUF_Pool_UT, Atomic_001)
+{
+  std::vector<BUF_t*> buffers;
+  for (std::size_t i = 0; i < BLOCK_COUNT; i++)
+  {
+    buffers.push_back(BUF_PoolAcquireAtomic(&pool));
+    ASSERT_NE(buffers.back(), nullptr);
+  }
+  EXPECT_EQ(BUF_PoolAcquireAtomic(&pool), nullptr);
+  EXPECT_EQ(BUF_PoolGetFailedCount(&pool), 1);
+
+  for (auto buffer : buffers)
+  {
+    EXPECT_TRUE(BUF_PoolReleaseAtomic(&pool, buffer));
+  }
+  EXPECT_FALSE(BUF_PoolReleaseAtomic(&pool, nullptr));
+  EXPECT_FALSE(BUF_PoolReleaseAtomic(&pool, buffers.front()));
+  EXPECT_EQ(BUF_PoolGetUsedCount(&pool), 0);
+  EXPECT_EQ(BUF_PoolGetHighWaterMark(&pool), BLOCK_COUNT);
+}
+
+/**
+ * \brief Stress several threads, a block is never owned twice
+ */
+TEST_F(BUF_Pool_UT, Atomic_002)
+{
+  constexpr int THREAD_COUNT = 4;
+  constexpr int LOOP_COUNT   = 20000;
+  std::atomic<std::uint8_t> owners[BLOCK_COUNT] = {};
+  std::atomic<bool> is_shared{false};
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < THREAD_COUNT; t++)
+  {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < LOOP_COUNT; i++)
+      {
+        BUF_t* buffer = BUF_PoolAcquireAtomic(&pool);
+        if (buffer != nullptr)
+        {
+          auto block = static_cast<std::size_t>(BUF_GetData(buffer) - arena) / BUF_POOL_BLOCK_SIZE(DATA_SIZE);
+          if (owners[block].fetch_add(1) != 0)
+          {
+            is_shared = true;
+          }
+          BUF_WriteUint8(buffer, static_cast<std::uint8_t>(t));
+          if (BUF_ReadUint8(buffer) != t)
+          {
+            is_shared = true;
+          }
+          owners[block].fetch_sub(1);
+          BUF_PoolReleaseAtomic(&pool, buffer);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_FALSE(is_shared);
+  EXPECT_EQ(BUF_PoolGetUsedCount(&pool), 0);
+  EXPECT_LE(BUF_PoolGetHighWaterMark(&pool), BLOCK_COUNT);
+  for (std::size_t i = 0; i < BLOCK_COUNT; i++)
+  {
+    EXPECT_NE(BUF_PoolAcquire(&pool), nullptr);
+  }
+  EXPECT_EQ(BUF_PoolAcquire(&pool), nullptr);
+}
+
+#endif
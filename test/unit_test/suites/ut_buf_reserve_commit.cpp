@@ -0,0 +1,84 @@
+//! \file ut_buf_reserve_commit.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_ReserveCommit_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    data.assign(8, 0x00);
+    BUF_InitEmpty(&buf, data.data(), data.size());
+  }
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+};
+
+/**
+ * \brief Fill in place, then commit
+ */
+TEST_F(BUF_ReserveCommit_UT, ReserveCommit_001)
+{
+  BUF_WriteUint16(&buf, 0x1122);
+
+  BUF_size_t size = 0;
+  std::uint8_t* area = BUF_Reserve(&buf, &size);
+  ASSERT_EQ(area, &data[2]);
+  EXPECT_EQ(size, 6);
+  EXPECT_EQ(buf.write_index, 2);
+
+  const std::uint8_t payload[] = {0x33, 0x44, 0x55};
+  std::memcpy(area, payload, sizeof(payload));
+  EXPECT_EQ(BUF_Commit(&buf, sizeof(payload)), sizeof(payload));
+  EXPECT_EQ(buf.write_index, 5);
+
+  EXPECT_EQ(BUF_ReadUint32(&buf), 0x11223344);
+  EXPECT_EQ(BUF_ReadUint8(&buf), 0x55);
+}
+
+/**
+ * \brief Commit over free size is refused, full buffer has no area
+ */
+TEST_F(BUF_ReserveCommit_UT, ReserveCommit_002)
+{
+  BUF_size_t size = 0;
+  ASSERT_NE(BUF_Reserve(&buf, &size), nullptr);
+  EXPECT_EQ(BUF_Commit(&buf, size + 1), 0);
+  EXPECT_EQ(BUF_Commit(&buf, 0), 0);
+  EXPECT_EQ(buf.write_index, 0);
+
+  EXPECT_EQ(BUF_Commit(&buf, size), size);
+  EXPECT_EQ(BUF_Reserve(&buf, &size), nullptr);
+  EXPECT_EQ(size, 0);
+  EXPECT_EQ(BUF_Commit(&buf, 1), 0);
+}
+
+/**
+ * \brief NULL parameters
+ */
+TEST_F(BUF_ReserveCommit_UT, ReserveCommit_003)
+{
+  BUF_size_t size = 5;
+  EXPECT_EQ(BUF_Reserve(nullptr, &size), nullptr);
+  EXPECT_EQ(size, 0);
+  EXPECT_EQ(BUF_Reserve(&buf, nullptr), data.data());
+  EXPECT_EQ(BUF_Commit(nullptr, 1), 0);
+
+  buf.data = nullptr;
+  EXPECT_EQ(BUF_Reserve(&buf, &size), nullptr);
+  EXPECT_EQ(BUF_Commit(&buf, 1), 0);
+}
@@ -0,0 +1,201 @@
+//! \file ut_buf_ring.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+
+extern "C" {
+#include "buffer/buffer_ring.h"
+}
+
+#if defined(BUF_RING_ENABLE)
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Ring_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    ASSERT_TRUE(BUF_RingInit(&ring, data, DATA_SIZE));
+  }
+
+  // attributes
+  BUF_Ring_t ring;
+  static constexpr uint8_t DATA_SIZE = 8;
+  std::uint8_t data[DATA_SIZE];
+};
+
+/**
+ * \brief Init requires a power of two size
+ */
+TEST_F(BUF_Ring_UT, Init_001)
+{
+  BUF_Ring_t other;
+  EXPECT_FALSE(BUF_RingInit(&other, data, 6));
+  EXPECT_FALSE(BUF_RingInit(&other, data, 0));
+  EXPECT_FALSE(BUF_RingInit(&other, nullptr, 8));
+  EXPECT_FALSE(BUF_RingInit(nullptr, data, 8));
+  EXPECT_TRUE(BUF_RingInit(&other, data, 1));
+  EXPECT_TRUE(BUF_RingInit(&other, data, 4));
+
+  EXPECT_EQ(BUF_RingGetSize(&ring), DATA_SIZE);
+  EXPECT_EQ(BUF_RingGetFreeSize(&ring), DATA_SIZE);
+  EXPECT_EQ(BUF_RingGetToReadCount(&ring), 0);
+  EXPECT_TRUE(BUF_RingIsEmpty(&ring));
+  EXPECT_FALSE(BUF_RingIsFull(&ring));
+}
+
+/**
+ * \brief Read-only fields, producer and consumer each own a cache line
+ */
+TEST_F(BUF_Ring_UT, Layout_001)
+{
+  auto line     = [](const void* p) { return reinterpret_cast<std::uintptr_t>(p) / BUF_CACHE_LINE_SIZE; };
+  auto base     = reinterpret_cast<std::uintptr_t>(&ring);
+  auto producer = reinterpret_cast<std::uintptr_t>(&ring.producer);
+  auto consumer = reinterpret_cast<std::uintptr_t>(&ring.consumer);
+  EXPECT_EQ(alignof(BUF_Ring_t), BUF_CACHE_LINE_SIZE);
+  EXPECT_EQ(base % BUF_CACHE_LINE_SIZE, 0U);
+  EXPECT_EQ(producer % BUF_CACHE_LINE_SIZE, 0U);
+  EXPECT_EQ(consumer % BUF_CACHE_LINE_SIZE, 0U);
+  EXPECT_EQ(line(&ring.data), line(&ring.mask));
+  EXPECT_NE(line(&ring.mask), line(&ring.producer.cached));
+  EXPECT_NE(line(&ring.producer.cached), line(&ring.consumer.index));
+}
+
+/**
+ * \brief Write then read back, big-endian layout
+ */
+TEST_F(BUF_Ring_UT, WriteRead_001)
+{
+  EXPECT_EQ(BUF_RingWriteUint8(&ring, 0x11), 1);
+  EXPECT_EQ(BUF_RingWriteUint16(&ring, 0x2233), 2);
+  EXPECT_EQ(BUF_RingWriteUint32(&ring, 0x44556677), 4);
+  EXPECT_EQ(BUF_RingGetToReadCount(&ring), 7);
+  EXPECT_EQ(BUF_RingGetFreeSize(&ring), 1);
+
+  std::vector<std::uint8_t> expected = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77};
+  EXPECT_THAT(expected, ElementsAreArray(data, expected.size()));
+
+  EXPECT_EQ(BUF_RingReadUint8(&ring), 0x11);
+  EXPECT_EQ(BUF_RingReadUint16(&ring), 0x2233);
+  EXPECT_EQ(BUF_RingReadUint32(&ring), 0x44556677);
+  EXPECT_TRUE(BUF_RingIsEmpty(&ring));
+}
+
+/**
+ * \brief Write and read wrap around the end of data
+ */
+TEST_F(BUF_Ring_UT, WriteRead_002)
+{
+  for (int loop = 0; loop < 100; loop++)
+  {
+    EXPECT_EQ(BUF_RingWriteUint32(&ring, 0xA0B0C0D0 + loop), 4);
+    EXPECT_EQ(BUF_RingWriteUint16(&ring, 0x1000 + loop), 2);
+    EXPECT_EQ(BUF_RingReadUint32(&ring), 0xA0B0C0D0 + loop);
+    EXPECT_EQ(BUF_RingReadUint16(&ring), 0x1000 + loop);
+  }
+  EXPECT_TRUE(BUF_RingIsEmpty(&ring));
+}
+
+/**
+ * \brief Write not enough space and read not enough data, all or nothing
+ */
+TEST_F(BUF_Ring_UT, WriteRead_003)
+{
+  std::vector<std::uint8_t> raw = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+  EXPECT_EQ(BUF_RingWriteRaw(&ring, raw.data(), raw.size()), raw.size());
+  EXPECT_EQ(BUF_RingWriteUint32(&ring, 0x11223344), 0);
+  EXPECT_EQ(BUF_RingWriteUint16(&ring, 0x1122), 2);
+  EXPECT_TRUE(BUF_RingIsFull(&ring));
+  EXPECT_EQ(BUF_RingWriteUint8(&ring, 0x33), 0);
+
+  std::vector<std::uint8_t> read(DATA_SIZE + 1);
+  EXPECT_EQ(BUF_RingReadRaw(&ring, read.data(), read.size()), 0);
+  EXPECT_EQ(BUF_RingReadRaw(&ring, read.data(), DATA_SIZE), DATA_SIZE);
+  EXPECT_EQ(BUF_RingReadUint32(&ring), 0);
+  EXPECT_EQ(BUF_RingReadUint8(&ring), 0);
+
+  std::vector<std::uint8_t> expected = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x11, 0x22};
+  EXPECT_THAT(expected, ElementsAreArray(read.data(), DATA_SIZE));
+}
+
+/**
+ * \brief Bad input parameters
+ */
+TEST_F(BUF_Ring_UT, BadParameter_001)
+{
+  std::uint8_t raw[4] = {};
+  EXPECT_EQ(BUF_RingWriteRaw(nullptr, raw, sizeof(raw)), 0);
+  EXPECT_EQ(BUF_RingWriteRaw(&ring, nullptr, sizeof(raw)), 0);
+  EXPECT_EQ(BUF_RingWriteRaw(&ring, raw, 0), 0);
+  EXPECT_EQ(BUF_RingReadRaw(nullptr, raw, sizeof(raw)), 0);
+  EXPECT_EQ(BUF_RingReadRaw(&ring, nullptr, sizeof(raw)), 0);
+  EXPECT_EQ(BUF_RingWriteUint32(nullptr, 0x11223344), 0);
+  EXPECT_EQ(BUF_RingReadUint32(nullptr), 0);
+  EXPECT_EQ(BUF_RingGetSize(nullptr), 0);
+  EXPECT_EQ(BUF_RingGetToReadCount(nullptr), 0);
+  EXPECT_EQ(BUF_RingGetFreeSize(nullptr), 0);
+  EXPECT_TRUE(BUF_RingIsEmpty(nullptr));
+  EXPECT_FALSE(BUF_RingIsFull(nullptr));
+
+  EXPECT_EQ(BUF_RingWriteUint16(&ring, 0x1122), 2);
+  BUF_RingReset(&ring);
+  EXPECT_TRUE(BUF_RingIsEmpty(&ring));
+}
+
+/**
+ * \brief Stress one producer thread and one consumer thread
+ * \details Small ring so that both sides constantly wrap and wait each other
+ */
+TEST(BUF_RingStress_UT, ProducerConsumer_001)
+{
+  static constexpr std::uint32_t MESSAGE_COUNT = 200000;
+  static std::uint8_t storage[64];
+  BUF_Ring_t ring;
+  ASSERT_TRUE(BUF_RingInit(&ring, storage, sizeof(storage)));
+
+  std::thread producer([&ring]() {
+    for (std::uint32_t i = 0; i < MESSAGE_COUNT; i++)
+    {
+      std::uint8_t message[6];
+      message[0] = static_cast<std::uint8_t>(i >> 24);
+      message[1] = static_cast<std::uint8_t>(i >> 16);
+      message[2] = static_cast<std::uint8_t>(i >> 8);
+      message[3] = static_cast<std::uint8_t>(i);
+      message[4] = static_cast<std::uint8_t>(~i >> 8);
+      message[5] = static_cast<std::uint8_t>(~i);
+      while (BUF_RingWriteRaw(&ring, message, sizeof(message)) == 0)
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::uint32_t errors = 0;
+  for (std::uint32_t i = 0; i < MESSAGE_COUNT; i++)
+  {
+    while (BUF_RingGetToReadCount(&ring) < 6)
+    {
+      std::this_thread::yield();
+    }
+    std::uint32_t value = BUF_RingReadUint32(&ring);
+    std::uint16_t check = BUF_RingReadUint16(&ring);
+    if ((value != i) || (check != static_cast<std::uint16_t>(~i)))
+    {
+      errors++;
+    }
+  }
+  producer.join();
+
+  EXPECT_EQ(errors, 0);
+  EXPECT_TRUE(BUF_RingIsEmpty(&ring));
+}
+
+#endif
@@ -0,0 +1,325 @@
+//! \file ut_buf_shared.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_shared.h"
+}
+
+#if defined(BUF_SHARED_ENABLE)
+
+using namespace testing;
+using ::testing::ElementsAre;
+
+class BUF_Shared_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    BUF_InitEmpty(&buf, data.data(), data.size());
+    ASSERT_TRUE(BUF_SharedInit(&shared, &buf));
+  }
+
+  // attributes
+  std::array<std::uint8_t, 10> data{};
+  BUF_t buf;
+  BUF_Shared_t shared;
+};
+
+/** \brief Appends are published by sync only */
+TEST_F(BUF_Shared_UT, WriteRaw_001)
+{
+  const std::uint8_t first[]  = {1, 2, 3};
+  const std::uint8_t second[] = {4, 5};
+
+  EXPECT_EQ(3U, BUF_SharedWriteRaw(&shared, first, sizeof(first)));
+  EXPECT_EQ(2U, BUF_SharedWriteRaw(&shared, second, sizeof(second)));
+  EXPECT_EQ(0U, BUF_GetToReadCount(&buf));
+  EXPECT_EQ(5U, BUF_SharedSync(&shared));
+  EXPECT_EQ(0U, BUF_SharedSync(&shared));
+  EXPECT_EQ(5U, BUF_GetToReadCount(&buf));
+  EXPECT_THAT(data, ElementsAre(1, 2, 3, 4, 5, 0, 0, 0, 0, 0));
+}
+
+/** \brief Bytes are published up to the first slot in flight */
+TEST_F(BUF_Shared_UT, Reserve_001)
+{
+  BUF_SharedSlot_t first;
+  BUF_SharedSlot_t second;
+  BUF_SharedSlot_t third;
+  ASSERT_NE(nullptr, BUF_SharedReserve(&shared, 2, &first));
+  ASSERT_NE(nullptr, BUF_SharedReserve(&shared, 3, &second));
+  ASSERT_NE(nullptr, BUF_SharedReserve(&shared, 1, &third));
+  ASSERT_EQ(first.data + 2, second.data);
+  ASSERT_EQ(second.data + 3, third.data);
+
+  third.data[0] = 0xC0;
+  EXPECT_EQ(1U, BUF_SharedCommit(&shared, &third));
+  EXPECT_EQ(0U, BUF_SharedSync(&shared));
+  first.data[0] = 0xA0;
+  EXPECT_EQ(2U, BUF_SharedCommit(&shared, &first));
+  EXPECT_EQ(2U, BUF_SharedSync(&shared));
+  EXPECT_EQ(0xA0, BUF_ReadUint8(&buf));
+  second.data[0] = 0xB0;
+  EXPECT_EQ(3U, BUF_SharedCommit(&shared, &second));
+  EXPECT_EQ(4U, BUF_SharedSync(&shared));
+  EXPECT_EQ(5U, BUF_GetToReadCount(&buf));
+}
+
+/** \brief A stalled slot does not hold back slots committed before it */
+TEST_F(BUF_Shared_UT, Reserve_002)
+{
+  const std::uint8_t record[] = {1, 2};
+  BUF_SharedSlot_t stalled;
+
+  EXPECT_EQ(2U, BUF_SharedWriteRaw(&shared, record, sizeof(record)));
+  ASSERT_NE(nullptr, BUF_SharedReserve(&shared, 3, &stalled));
+  EXPECT_EQ(2U, BUF_SharedWriteRaw(&shared, record, sizeof(record)));
+  EXPECT_EQ(2U, BUF_SharedSync(&shared));
+  EXPECT_EQ(0U, BUF_SharedSync(&shared));
+  EXPECT_EQ(3U, BUF_SharedCommit(&shared, &stalled));
+  EXPECT_EQ(5U, BUF_SharedSync(&shared));
+}
+
+/** \brief Reservation fails while all in-flight entries are taken */
+TEST_F(BUF_Shared_UT, Reserve_003)
+{
+  BUF_SharedSlot_t slots[BUF_SHARED_IN_FLIGHT_COUNT];
+  BUF_SharedSlot_t extra;
+  std::uint8_t storage[BUF_SHARED_IN_FLIGHT_COUNT + 1];
+  BUF_InitEmpty(&buf, storage, sizeof(storage));
+  ASSERT_TRUE(BUF_SharedInit(&shared, &buf));
+
+  for (auto& slot : slots)
+  {
+    ASSERT_NE(nullptr, BUF_SharedReserve(&shared, 1, &slot));
+  }
+  EXPECT_EQ(nullptr, BUF_SharedReserve(&shared, 1, &extra));
+  EXPECT_EQ(0U, BUF_SharedCommit(&shared, &extra));
+  EXPECT_EQ(1U, BUF_SharedCommit(&shared, &slots[0]));
+  EXPECT_NE(nullptr, BUF_SharedReserve(&shared, 1, &extra));
+  EXPECT_EQ(1U, BUF_SharedSync(&shared));
+}
+
+/** \brief A slot committed twice does not free the entry of another slot */
+TEST_F(BUF_Shared_UT, Commit_001)
+{
+  BUF_SharedSlot_t first;
+  BUF_SharedSlot_t second;
+  ASSERT_NE(nullptr, BUF_SharedReserve(&shared, 2, &first));
+  EXPECT_EQ(2U, BUF_SharedCommit(&shared, &first));
+  EXPECT_EQ(nullptr, first.data);
+  ASSERT_NE(nullptr, BUF_SharedReserve(&shared, 3, &second));
+  ASSERT_EQ(first.entry, second.entry);
+
+  EXPECT_EQ(0U, BUF_SharedCommit(&shared, &first));
+  EXPECT_EQ(2U, BUF_SharedSync(&shared));
+  EXPECT_EQ(0U, BUF_SharedSync(&shared));
+  EXPECT_EQ(3U, BUF_SharedCommit(&shared, &second));
+  EXPECT_EQ(3U, BUF_SharedSync(&shared));
+}
+
+/** \brief Appends that do not fit fail, smaller ones still fit */
+TEST_F(BUF_Shared_UT, Full_001)
+{
+  const std::uint8_t record[6] = {};
+
+  EXPECT_EQ(6U, BUF_SharedWriteRaw(&shared, record, 6));
+  EXPECT_EQ(0U, BUF_SharedWriteRaw(&shared, record, 6));
+  BUF_SharedSlot_t slot;
+  EXPECT_EQ(nullptr, BUF_SharedReserve(&shared, 5, &slot));
+  EXPECT_EQ(4U, BUF_SharedWriteRaw(&shared, record, 4));
+  EXPECT_EQ(0U, BUF_SharedWriteRaw(&shared, record, 1));
+  EXPECT_EQ(10U, BUF_SharedSync(&shared));
+  EXPECT_TRUE(BUF_IsFull(&buf));
+}
+
+/** \brief Append starts at write_index, reset empties buffer */
+TEST_F(BUF_Shared_UT, Init_001)
+{
+  const std::uint8_t record[] = {7, 8};
+  BUF_WriteUint8(&buf, 6);
+  ASSERT_TRUE(BUF_SharedInit(&shared, &buf));
+
+  EXPECT_EQ(2U, BUF_SharedWriteRaw(&shared, record, sizeof(record)));
+  EXPECT_EQ(2U, BUF_SharedSync(&shared));
+  EXPECT_THAT(data, ElementsAre(6, 7, 8, 0, 0, 0, 0, 0, 0, 0));
+
+  BUF_SharedReset(&shared);
+  EXPECT_EQ(0U, BUF_GetUsedSize(&buf));
+  EXPECT_EQ(10U, BUF_SharedWriteRaw(&shared, data.data(), 10));
+  EXPECT_EQ(10U, BUF_SharedSync(&shared));
+}
+
+/** \brief NULL and empty parameters */
+TEST_F(BUF_Shared_UT, Null_001)
+{
+  BUF_t no_data = {};
+  std::uint8_t byte = 0;
+
+  EXPECT_FALSE(BUF_SharedInit(NULL, &buf));
+  EXPECT_FALSE(BUF_SharedInit(&shared, NULL));
+  EXPECT_FALSE(BUF_SharedInit(&shared, &no_data));
+  BUF_SharedSlot_t slot;
+
+  EXPECT_EQ(nullptr, BUF_SharedReserve(NULL, 1, &slot));
+  EXPECT_EQ(nullptr, BUF_SharedReserve(&shared, 0, &slot));
+  EXPECT_EQ(nullptr, BUF_SharedReserve(&shared, 1, NULL));
+  EXPECT_EQ(0U, BUF_SharedCommit(NULL, &slot));
+  EXPECT_EQ(0U, BUF_SharedCommit(&shared, NULL));
+  EXPECT_EQ(0U, BUF_SharedWriteRaw(&shared, NULL, 1));
+  EXPECT_EQ(0U, BUF_SharedWriteRaw(&shared, &byte, 0));
+  EXPECT_EQ(0U, BUF_SharedSync(NULL));
+  BUF_SharedReset(NULL);
+}
+
+/**
+ * \brief Stress several producers and one consumer reading while they run
+ * \details Records carry thread, sequence and check, each thread must show
+ * up with consecutive sequences, records are never torn
+ */
+TEST(BUF_SharedStress_UT, Producers_001)
+{
+  constexpr int THREAD_COUNT         = 4;
+  constexpr std::uint32_t LOOP_COUNT = 1500;
+  constexpr BUF_size_t RECORD_SIZE   = 8;
+  static std::uint8_t storage[THREAD_COUNT * LOOP_COUNT * RECORD_SIZE];
+  BUF_t buffer;
+  BUF_Shared_t shared;
+  std::atomic<int> running{THREAD_COUNT};
+  std::vector<std::thread> threads;
+  BUF_InitEmpty(&buffer, storage, sizeof(storage));
+  ASSERT_TRUE(BUF_SharedInit(&shared, &buffer));
+
+  for (int t = 0; t < THREAD_COUNT; t++)
+  {
+    threads.emplace_back([&, t]() {
+      for (std::uint32_t i = 0; i < LOOP_COUNT; i++)
+      {
+        BUF_SharedSlot_t reserved;
+        std::uint8_t* slot = BUF_SharedReserve(&shared, RECORD_SIZE, &reserved);
+        if (slot != nullptr)
+        {
+          slot[0] = static_cast<std::uint8_t>(t);
+          slot[1] = static_cast<std::uint8_t>(i >> 24);
+          slot[2] = static_cast<std::uint8_t>(i >> 16);
+          slot[3] = static_cast<std::uint8_t>(i >> 8);
+          slot[4] = static_cast<std::uint8_t>(i);
+          slot[5] = static_cast<std::uint8_t>(~i >> 8);
+          slot[6] = static_cast<std::uint8_t>(~i);
+          slot[7] = static_cast<std::uint8_t>(~t);
+          BUF_SharedCommit(&shared, &reserved);
+        }
+      }
+      running--;
+    });
+  }
+
+  std::uint32_t next[THREAD_COUNT] = {};
+  std::uint32_t errors             = 0;
+  bool is_running                  = true;
+  while (is_running)
+  {
+    is_running = (running > 0);
+    BUF_SharedSync(&shared);
+    while (BUF_GetToReadCount(&buffer) >= RECORD_SIZE)
+    {
+      std::uint8_t thread   = BUF_ReadUint8(&buffer);
+      std::uint32_t value   = BUF_ReadUint32(&buffer);
+      std::uint16_t check   = BUF_ReadUint16(&buffer);
+      std::uint8_t thread_n = BUF_ReadUint8(&buffer);
+      if ((thread >= THREAD_COUNT) || (thread_n != static_cast<std::uint8_t>(~thread)) || (value != next[thread])
+          || (check != static_cast<std::uint16_t>(~value)))
+      {
+        errors++;
+      }
+      else
+      {
+        next[thread]++;
+      }
+    }
+    std::this_thread::yield();
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(errors, 0);
+  EXPECT_EQ(BUF_GetToReadCount(&buffer), 0);
+  EXPECT_TRUE(BUF_IsFull(&buffer));
+  for (int t = 0; t < THREAD_COUNT; t++)
+  {
+    EXPECT_EQ(next[t], LOOP_COUNT);
+  }
+}
+
+/**
+ * \brief Stress producers racing past the end of a small buffer
+ * \details Only whole records are published, the slot crossing the end is
+ * dropped
+ */
+TEST(BUF_SharedStress_UT, Overflow_001)
+{
+  constexpr int THREAD_COUNT       = 4;
+  constexpr int ROUND_COUNT        = 200;
+  constexpr BUF_size_t RECORD_SIZE = 7;
+  static std::uint8_t storage[100];
+  BUF_t buffer;
+  BUF_Shared_t shared;
+  std::uint32_t errors = 0;
+  BUF_InitEmpty(&buffer, storage, sizeof(storage));
+  ASSERT_TRUE(BUF_SharedInit(&shared, &buffer));
+
+  for (int round = 0; round < ROUND_COUNT; round++)
+  {
+    std::atomic<std::uint32_t> written{0};
+    std::vector<std::thread> threads;
+    BUF_SharedReset(&shared);
+    for (int t = 0; t < THREAD_COUNT; t++)
+    {
+      threads.emplace_back([&, t]() {
+        std::uint8_t record[RECORD_SIZE];
+        std::fill(std::begin(record), std::end(record), static_cast<std::uint8_t>(0xA0 + t));
+        while (BUF_SharedWriteRaw(&shared, record, RECORD_SIZE) == RECORD_SIZE)
+        {
+          written += RECORD_SIZE;
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    BUF_SharedSync(&shared);
+    if (BUF_GetToReadCount(&buffer) != written)
+    {
+      errors++;
+    }
+    while (BUF_GetToReadCount(&buffer) >= RECORD_SIZE)
+    {
+      std::uint8_t record[RECORD_SIZE];
+      BUF_ReadRaw(&buffer, record, RECORD_SIZE);
+      if ((record[0] < 0xA0) || (std::count(std::begin(record), std::end(record), record[0]) != RECORD_SIZE))
+      {
+        errors++;
+      }
+    }
+  }
+
+  EXPECT_EQ(errors, 0);
+}
+
+#endif
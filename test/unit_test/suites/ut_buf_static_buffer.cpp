@@ -0,0 +1,157 @@
+//! \file ut_buf_static_buffer.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include "buffer/buffer.hpp"
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_StaticBuffer_UT : public ::testing::Test
+{
+protected:
+  // attributes
+  buf::StaticBuffer<16> buffer;
+};
+
+static_assert(buf::StaticBuffer<16>::capacity() == 16, "capacity is constexpr");
+
+/**
+ * \brief Write then read every width, big-endian by default
+ */
+TEST_F(BUF_StaticBuffer_UT, WriteRead_001)
+{
+  EXPECT_TRUE(buffer.write<std::uint8_t>(0x01));
+  EXPECT_TRUE(buffer.write<std::uint16_t>(0x0203));
+  EXPECT_TRUE(buffer.write<std::uint32_t>(0x04050607));
+  EXPECT_TRUE(buffer.write<std::int64_t>(-2));
+  EXPECT_TRUE(buffer.write<std::uint8_t>(0x08));
+  EXPECT_EQ(buffer.free_size(), 0);
+  EXPECT_FALSE(buffer.write<std::uint8_t>(0x09));
+
+  std::vector<std::uint8_t> expected = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF,
+                                        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x08};
+  EXPECT_THAT(expected, ElementsAreArray(buffer.data(), 16));
+
+  EXPECT_EQ(buffer.read<std::uint8_t>(), 0x01);
+  EXPECT_EQ(buffer.read<std::uint16_t>(), 0x0203);
+  EXPECT_EQ(buffer.read<std::uint32_t>(), 0x04050607);
+  EXPECT_EQ(buffer.read<std::int64_t>(), -2);
+  EXPECT_EQ(buffer.to_read_count(), 1);
+  EXPECT_EQ(buffer.read<std::uint16_t>(), 0);
+  EXPECT_EQ(buffer.read<std::uint8_t>(), 0x08);
+}
+
+/**
+ * \brief Little-endian write and read
+ */
+TEST_F(BUF_StaticBuffer_UT, WriteReadLE_001)
+{
+  EXPECT_TRUE((buffer.write<std::uint32_t, BUF_ENDIAN_LITTLE>(0x01020304)));
+  std::vector<std::uint8_t> expected = {0x04, 0x03, 0x02, 0x01};
+  EXPECT_THAT(expected, ElementsAreArray(buffer.data(), 4));
+  EXPECT_EQ((buffer.read<std::uint32_t, BUF_ENDIAN_LITTLE>()), 0x01020304);
+}
+
+/**
+ * \brief Fixed layout put and get
+ */
+TEST_F(BUF_StaticBuffer_UT, PutGet_001)
+{
+  buffer.put<0, std::uint16_t>(0xCAFE);
+  buffer.put<12, std::uint32_t, BUF_ENDIAN_LITTLE>(0x01020304);
+  EXPECT_EQ(buffer.to_read_count(), 0);
+  EXPECT_EQ((buffer.get<0, std::uint16_t>()), 0xCAFE);
+  EXPECT_EQ((buffer.get<12, std::uint32_t>()), 0x04030201);
+  EXPECT_EQ((buffer.get<15, std::uint8_t>()), 0x01);
+}
+
+/**
+ * \brief C functions and C++ accessors share the same buffer
+ */
+TEST_F(BUF_StaticBuffer_UT, Interop_001)
+{
+  BUF_WriteUint16(buffer.c_buf(), 0x0102);
+  EXPECT_TRUE(buffer.write<std::uint16_t>(0x0304));
+  EXPECT_EQ(BUF_GetUsedSize(buffer.c_buf()), 4);
+  EXPECT_EQ(BUF_ReadUint32(buffer.c_buf()), 0x01020304);
+  EXPECT_EQ(BUF_GetSize(buffer.c_buf()), buffer.capacity());
+
+  buffer.reset();
+  EXPECT_TRUE(BUF_IsEmpty(buffer.c_buf()));
+}
+
+/**
+ * \brief Span on buffer owned by C code
+ */
+TEST_F(BUF_StaticBuffer_UT, Span_001)
+{
+  std::uint8_t data[6];
+  BUF_t c_buffer;
+  BUF_InitEmpty(&c_buffer, data, sizeof(data));
+  buf::Span span(c_buffer);
+
+  EXPECT_EQ(span.c_buf(), &c_buffer);
+  EXPECT_EQ(span.capacity(), 6);
+  EXPECT_TRUE(span.write<std::uint32_t>(0x01020304));
+  EXPECT_FALSE(span.write<std::uint32_t>(0x05060708));
+  EXPECT_EQ(span.free_size(), 2);
+  EXPECT_EQ(BUF_ReadUint16(&c_buffer), 0x0102);
+  EXPECT_EQ(span.to_read_count(), 2);
+  EXPECT_EQ(span.read<std::uint16_t>(), 0x0304);
+  EXPECT_EQ(span.read<std::uint8_t>(), 0);
+  span.reset();
+  EXPECT_TRUE(BUF_IsEmpty(&c_buffer));
+
+  BUF_t no_data = {};
+  buf::Span empty(no_data);
+  EXPECT_FALSE(empty.write<std::uint8_t>(0x01));
+  EXPECT_EQ(empty.read<std::uint8_t>(), 0);
+}
+
+/**
+ * \brief Copy owns its storage
+ */
+TEST_F(BUF_StaticBuffer_UT, Copy_001)
+{
+  buffer.write<std::uint16_t>(0x0102);
+  buf::StaticBuffer<16> copy(buffer);
+  buffer.put<0, std::uint8_t>(0xFF);
+
+  EXPECT_EQ(copy.c_buf()->data, copy.data());
+  EXPECT_EQ(copy.read<std::uint16_t>(), 0x0102);
+
+  copy = buffer;
+  EXPECT_EQ(copy.c_buf()->data, copy.data());
+  EXPECT_EQ(copy.read<std::uint16_t>(), 0xFF02);
+  EXPECT_EQ(buffer.span().read<std::uint16_t>(), 0xFF02);
+}
+
+#if defined(BUF_STATS_ENABLE)
+/**
+ * \brief Copy does not share stats of source
+ */
+TEST_F(BUF_StaticBuffer_UT, Copy_002)
+{
+  BUF_Stats_t stats;
+  BUF_StatsInit(&stats);
+  BUF_AttachStats(buffer.c_buf(), &stats);
+  buffer.write<std::uint16_t>(0x0102);
+
+  buf::StaticBuffer<16> copy(buffer);
+  EXPECT_EQ(copy.c_buf()->stats, nullptr);
+  EXPECT_TRUE(copy.write<std::uint32_t>(0x03040506));
+  EXPECT_EQ(stats.bytes_written, 2U);
+
+  buf::StaticBuffer<16> assigned;
+  assigned = buffer;
+  EXPECT_EQ(assigned.c_buf()->stats, nullptr);
+  EXPECT_EQ(buffer.c_buf()->stats, &stats);
+}
+#endif
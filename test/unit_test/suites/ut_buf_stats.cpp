@@ -0,0 +1,211 @@
+//! \file ut_buf_stats.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_stats.h"
+}
+
+#if defined(BUF_STATS_ENABLE)
+
+using namespace testing;
+
+class BUF_Stats_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    BUF_InitEmpty(&buf, data.data(), data.size());
+    BUF_StatsInit(&stats);
+    BUF_AttachStats(&buf, &stats);
+  }
+
+  BUF_Stats_t Snapshot()
+  {
+    BUF_Stats_t snapshot;
+    BUF_StatsGetSnapshot(&stats, &snapshot);
+    return snapshot;
+  }
+
+  // attributes
+  std::vector<std::uint8_t> data = std::vector<std::uint8_t>(16);
+  BUF_t buf;
+  BUF_Stats_t stats;
+};
+
+/**
+ * \brief Written and read bytes, high-water mark
+ */
+TEST_F(BUF_Stats_UT, ReadWrite_001)
+{
+  std::uint16_t array[2] = {0x0102, 0x0304};
+  std::uint16_t out[2];
+
+  BUF_WriteUint8(&buf, 0x01);
+  BUF_WriteUint16LE(&buf, 0x0203);
+  BUF_WriteUint32Array(&buf, reinterpret_cast<std::uint32_t*>(array), 1);
+  BUF_WriteRaw(&buf, data.data() + 12, 1);
+  BUF_ReadUint16(&buf);
+  BUF_ReadUint16Array(&buf, out, 2);
+  BUF_Reset(&buf);
+  BUF_WriteUint32(&buf, 0x01020304);
+
+  auto snapshot = Snapshot();
+  EXPECT_EQ(snapshot.bytes_written, 1 + 2 + 4 + 1 + 4);
+  EXPECT_EQ(snapshot.bytes_read, 2 + 4);
+  EXPECT_EQ(snapshot.write_index_high_water, 8);
+  EXPECT_EQ(snapshot.write_failed, 0);
+  EXPECT_EQ(snapshot.read_failed, 0);
+}
+
+/**
+ * \brief Refused and truncated accesses
+ */
+TEST_F(BUF_Stats_UT, Failed_001)
+{
+  std::uint32_t array[4] = {};
+
+  BUF_SetSize(&buf, 6);
+  EXPECT_EQ(BUF_ReadUint8(&buf), 0);
+  EXPECT_EQ(BUF_WriteUint32(&buf, 0x01020304), 4);
+  EXPECT_EQ(BUF_WriteUint32(&buf, 0x01020304), 0);
+  EXPECT_EQ(BUF_WriteUint64LE(&buf, 1), 0);
+  EXPECT_EQ(BUF_WriteUint32Array(&buf, array, 1), 0);
+  EXPECT_EQ(BUF_ReadUint32Array(&buf, array, 2), 0);
+  EXPECT_EQ(BUF_WriteRaw(&buf, data.data() + 8, 3), 0);
+  EXPECT_EQ(BUF_FillPattern(&buf, 0x00, 3), 2);
+
+  auto snapshot = Snapshot();
+  EXPECT_EQ(snapshot.write_failed, 5);
+  EXPECT_EQ(snapshot.read_failed, 2);
+  EXPECT_EQ(snapshot.bytes_written, 6);
+  EXPECT_EQ(snapshot.write_index_high_water, 6);
+}
+
+/**
+ * \brief Zero-size fill, commit and consume are not failed accesses
+ */
+TEST_F(BUF_Stats_UT, ZeroSize_001)
+{
+  EXPECT_EQ(BUF_FillPattern(&buf, 0x00, 0), 0);
+  EXPECT_EQ(BUF_Commit(&buf, 0), 0);
+  EXPECT_EQ(BUF_Consume(&buf, 0), 0);
+
+  auto snapshot = Snapshot();
+  EXPECT_EQ(snapshot.write_failed, 0);
+  EXPECT_EQ(snapshot.bytes_written, 0);
+  EXPECT_EQ(snapshot.read_failed, 0);
+  EXPECT_EQ(snapshot.bytes_read, 0);
+}
+
+/**
+ * \brief Copy counts read on source and write on destination
+ */
+TEST_F(BUF_Stats_UT, WriteCopy_001)
+{
+  std::vector<std::uint8_t> src_data(20, 0x5A);
+  BUF_t src;
+  BUF_Stats_t src_stats;
+  BUF_InitFull(&src, src_data.data(), src_data.size());
+  BUF_StatsInit(&src_stats);
+  BUF_AttachStats(&src, &src_stats);
+
+  EXPECT_EQ(BUF_WriteCopy(&buf, &src, 4), 4);
+  EXPECT_EQ(BUF_WriteCopy(&buf, &src, 16), 12);
+
+  auto snapshot = Snapshot();
+  EXPECT_EQ(snapshot.bytes_written, 16);
+  EXPECT_EQ(snapshot.write_failed, 1);
+  BUF_StatsGetSnapshot(&src_stats, &snapshot);
+  EXPECT_EQ(snapshot.bytes_read, 16);
+  EXPECT_EQ(snapshot.bytes_written, 0);
+}
+
+/**
+ * \brief Compare and views, views are not attached
+ */
+TEST_F(BUF_Stats_UT, CompareView_001)
+{
+  BUF_t view;
+  BUF_WriteUint32(&buf, 0x01020304);
+  BUF_MakeViewToRead(&view, &buf);
+  BUF_MakeViewFull(&view, &buf, 0, 2);
+  BUF_Compare(&buf, data.data(), 4);
+  BUF_ReadUint16(&view);
+
+  auto snapshot = Snapshot();
+  EXPECT_EQ(snapshot.view_count, 2);
+  EXPECT_EQ(snapshot.compare_count, 1);
+  EXPECT_EQ(snapshot.bytes_read, 0);
+}
+
+/**
+ * \brief Detached and init buffers do not update stats
+ */
+TEST_F(BUF_Stats_UT, Detach_001)
+{
+  BUF_AttachStats(&buf, nullptr);
+  BUF_WriteUint8(&buf, 0x01);
+  BUF_AttachStats(&buf, &stats);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  BUF_WriteUint8(&buf, 0x01);
+
+  auto snapshot = Snapshot();
+  EXPECT_EQ(snapshot.bytes_written, 0);
+  EXPECT_EQ(snapshot.write_index_high_water, 0);
+}
+
+/**
+ * \brief Stats shared by buffers of several threads
+ */
+TEST_F(BUF_Stats_UT, Shared_001)
+{
+  constexpr int THREAD_COUNT = 4;
+  constexpr int LOOP_COUNT   = 10000;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < THREAD_COUNT; t++)
+  {
+    threads.emplace_back([this, t]() {
+      std::uint8_t local_data[4 + 4 * THREAD_COUNT];
+      BUF_t local;
+      BUF_InitEmpty(&local, local_data, 4 + 4 * t);
+      BUF_AttachStats(&local, &stats);
+      for (int i = 0; i < LOOP_COUNT; i++)
+      {
+        BUF_Reset(&local);
+        BUF_FillPattern(&local, 0x00, 4 + 4 * t);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  auto snapshot = Snapshot();
+  EXPECT_EQ(snapshot.bytes_written, LOOP_COUNT * (4 + 8 + 12 + 16));
+  EXPECT_EQ(snapshot.write_index_high_water, 16);
+}
+
+/**
+ * \brief Bad input parameters
+ */
+TEST_F(BUF_Stats_UT, BadParameter_001)
+{
+  BUF_StatsInit(nullptr);
+  BUF_AttachStats(nullptr, &stats);
+  BUF_StatsGetSnapshot(nullptr, &stats);
+  BUF_StatsGetSnapshot(&stats, nullptr);
+  BUF_StatsAddWritten(nullptr, 1, 1);
+  EXPECT_EQ(Snapshot().bytes_written, 0);
+}
+
+#endif
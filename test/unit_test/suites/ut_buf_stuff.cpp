@@ -0,0 +1,248 @@
+//! \file ut_buf_stuff.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer_stuff.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Stuff_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    BUF_InitEmpty(&encoded, encoded_data.data(), encoded_data.size());
+    BUF_InitEmpty(&decoded, decoded_data.data(), decoded_data.size());
+    BUF_StuffDecoderInit(&decoder);
+  }
+
+  /**
+   * \brief Encode payload, check encoding and decode it back
+   */
+  void RoundTrip(BUF_size_t (*encode)(BUF_t*, BUF_t*),
+                 BUF_StuffStatus_t (*decode)(BUF_t*, BUF_t*, BUF_StuffDecoder_t*),
+                 std::vector<std::uint8_t> payload,
+                 const std::vector<std::uint8_t>& expected)
+  {
+    BUF_t src;
+    BUF_InitFull(&src, payload.data(), payload.size());
+    BUF_Reset(&encoded);
+    BUF_Reset(&decoded);
+    ASSERT_EQ(encode(&encoded, &src), expected.size());
+    EXPECT_EQ(BUF_GetToReadCount(&src), 0);
+    EXPECT_THAT(std::vector<std::uint8_t>(encoded_data.begin(), encoded_data.begin() + encoded.write_index),
+                ElementsAreArray(expected));
+
+    EXPECT_EQ(decode(&decoded, &encoded, &decoder), BUF_STUFF_FRAME);
+    EXPECT_EQ(BUF_GetToReadCount(&encoded), 0);
+    EXPECT_THAT(std::vector<std::uint8_t>(decoded_data.begin(), decoded_data.begin() + decoded.write_index),
+                ElementsAreArray(payload));
+  }
+
+  // attributes
+  std::vector<std::uint8_t> encoded_data = std::vector<std::uint8_t>(600);
+  std::vector<std::uint8_t> decoded_data = std::vector<std::uint8_t>(300);
+  BUF_t encoded;
+  BUF_t decoded;
+  BUF_StuffDecoder_t decoder;
+};
+
+/**
+ * \brief COBS reference vectors
+ */
+TEST_F(BUF_Stuff_UT, Cobs_001)
+{
+  RoundTrip(BUF_CobsEncode, BUF_CobsDecode, {0x00}, {0x01, 0x01, 0x00});
+  RoundTrip(BUF_CobsEncode, BUF_CobsDecode, {0x00, 0x00}, {0x01, 0x01, 0x01, 0x00});
+  RoundTrip(BUF_CobsEncode, BUF_CobsDecode, {0x11, 0x22, 0x00, 0x33}, {0x03, 0x11, 0x22, 0x02, 0x33, 0x00});
+  RoundTrip(BUF_CobsEncode, BUF_CobsDecode, {0x11, 0x22, 0x33, 0x44}, {0x05, 0x11, 0x22, 0x33, 0x44, 0x00});
+  RoundTrip(BUF_CobsEncode, BUF_CobsDecode, {0x11, 0x00, 0x00, 0x00}, {0x02, 0x11, 0x01, 0x01, 0x01, 0x00});
+}
+
+/**
+ * \brief COBS full blocks of 254 bytes
+ */
+TEST_F(BUF_Stuff_UT, Cobs_002)
+{
+  std::vector<std::uint8_t> payload;
+  std::vector<std::uint8_t> expected = {0xFF};
+  for (int i = 1; i <= 254; i++)
+  {
+    payload.push_back(static_cast<std::uint8_t>(i));
+    expected.push_back(static_cast<std::uint8_t>(i));
+  }
+  expected.push_back(0x00);
+  RoundTrip(BUF_CobsEncode, BUF_CobsDecode, payload, expected);
+
+  payload.push_back(0xFF);
+  expected.back() = 0x02;
+  expected.push_back(0xFF);
+  expected.push_back(0x00);
+  RoundTrip(BUF_CobsEncode, BUF_CobsDecode, payload, expected);
+
+  payload.pop_back();
+  payload.insert(payload.begin(), 0x00);
+  expected.assign(payload.begin() + 1, payload.end());
+  expected.insert(expected.begin(), {0x01, 0xFF});
+  expected.push_back(0x00);
+  RoundTrip(BUF_CobsEncode, BUF_CobsDecode, payload, expected);
+}
+
+/**
+ * \brief SLIP escapes END and ESC
+ */
+TEST_F(BUF_Stuff_UT, Slip_001)
+{
+  RoundTrip(BUF_SlipEncode, BUF_SlipDecode, {0xC0, 0xDB, 0x01}, {0xDB, 0xDC, 0xDB, 0xDD, 0x01, 0xC0});
+  RoundTrip(BUF_SlipEncode, BUF_SlipDecode, {0x01, 0x02, 0x03}, {0x01, 0x02, 0x03, 0xC0});
+}
+
+/**
+ * \brief HDLC escapes flag and escape, frame between flags
+ */
+TEST_F(BUF_Stuff_UT, Hdlc_001)
+{
+  RoundTrip(BUF_HdlcEncode, BUF_HdlcDecode, {0x7E, 0x7D, 0x01}, {0x7E, 0x7D, 0x5E, 0x7D, 0x5D, 0x01, 0x7E});
+  RoundTrip(BUF_HdlcEncode, BUF_HdlcDecode, {0x41}, {0x7E, 0x41, 0x7E});
+}
+
+/**
+ * \brief HDLC shared flag, escaped control byte, empty frames skipped
+ */
+TEST_F(BUF_Stuff_UT, Hdlc_002)
+{
+  encoded_data = {0x7E, 0x7E, 0x01, 0x7E, 0x7D, 0x31, 0x7E, 0x7E};
+  BUF_InitFull(&encoded, encoded_data.data(), encoded_data.size());
+
+  EXPECT_EQ(BUF_HdlcDecode(&decoded, &encoded, &decoder), BUF_STUFF_FRAME);
+  EXPECT_EQ(decoded.write_index, 1);
+  EXPECT_EQ(decoded_data[0], 0x01);
+  BUF_Reset(&decoded);
+
+  EXPECT_EQ(BUF_HdlcDecode(&decoded, &encoded, &decoder), BUF_STUFF_FRAME);
+  EXPECT_EQ(decoded.write_index, 1);
+  EXPECT_EQ(decoded_data[0], 0x11);
+
+  EXPECT_EQ(BUF_HdlcDecode(&decoded, &encoded, &decoder), BUF_STUFF_MORE);
+  EXPECT_EQ(BUF_GetToReadCount(&encoded), 0);
+}
+
+/**
+ * \brief Frames split at every byte are decoded across calls
+ */
+TEST_F(BUF_Stuff_UT, Streaming_001)
+{
+  struct Codec
+  {
+    BUF_size_t (*encode)(BUF_t*, BUF_t*);
+    BUF_StuffStatus_t (*decode)(BUF_t*, BUF_t*, BUF_StuffDecoder_t*);
+  };
+  const Codec codecs[] = {{BUF_CobsEncode, BUF_CobsDecode},
+                          {BUF_SlipEncode, BUF_SlipDecode},
+                          {BUF_HdlcEncode, BUF_HdlcDecode}};
+  std::vector<std::vector<std::uint8_t>> frames = {
+    {0x00, 0xC0, 0x7E, 0x11}, {0xDB, 0xDB, 0x7D, 0x00, 0x00}, {0x22}};
+
+  for (const Codec& codec : codecs)
+  {
+    BUF_Reset(&encoded);
+    for (std::vector<std::uint8_t> frame : frames)
+    {
+      BUF_t src;
+      BUF_InitFull(&src, frame.data(), frame.size());
+      ASSERT_GT(codec.encode(&encoded, &src), 0);
+    }
+
+    std::size_t count = 0;
+    BUF_Reset(&decoded);
+    BUF_StuffDecoderInit(&decoder);
+    for (BUF_size_t i = 0; i < encoded.write_index; i++)
+    {
+      BUF_t chunk;
+      BUF_MakeViewFull(&chunk, &encoded, i, 1);
+      BUF_StuffStatus_t status = codec.decode(&decoded, &chunk, &decoder);
+      ASSERT_NE(status, BUF_STUFF_ERROR);
+      if (status == BUF_STUFF_FRAME)
+      {
+        ASSERT_LT(count, frames.size());
+        EXPECT_THAT(std::vector<std::uint8_t>(decoded_data.begin(), decoded_data.begin() + decoded.write_index),
+                    ElementsAreArray(frames[count]));
+        count++;
+        BUF_Reset(&decoded);
+      }
+    }
+    EXPECT_EQ(count, frames.size());
+  }
+}
+
+/**
+ * \brief Truncated COBS block and aborted SLIP frame are errors, next frame
+ * is decoded
+ */
+TEST_F(BUF_Stuff_UT, Error_001)
+{
+  encoded_data = {0x04, 0x11, 0x00, 0x02, 0x22, 0x00};
+  BUF_InitFull(&encoded, encoded_data.data(), encoded_data.size());
+  EXPECT_EQ(BUF_CobsDecode(&decoded, &encoded, &decoder), BUF_STUFF_ERROR);
+  BUF_Reset(&decoded);
+  EXPECT_EQ(BUF_CobsDecode(&decoded, &encoded, &decoder), BUF_STUFF_FRAME);
+  EXPECT_EQ(decoded.write_index, 1);
+  EXPECT_EQ(decoded_data[0], 0x22);
+
+  encoded_data = {0x01, 0xDB, 0xC0, 0x33, 0xC0};
+  BUF_InitFull(&encoded, encoded_data.data(), encoded_data.size());
+  BUF_Reset(&decoded);
+  EXPECT_EQ(BUF_SlipDecode(&decoded, &encoded, &decoder), BUF_STUFF_ERROR);
+  BUF_Reset(&decoded);
+  EXPECT_EQ(BUF_SlipDecode(&decoded, &encoded, &decoder), BUF_STUFF_FRAME);
+  EXPECT_EQ(decoded_data[0], 0x33);
+}
+
+/**
+ * \brief Frame larger than dst is dropped up to its delimiter
+ */
+TEST_F(BUF_Stuff_UT, Error_002)
+{
+  encoded_data = {0x01, 0x02, 0x03, 0x04, 0xC0, 0x05, 0xC0};
+  BUF_InitFull(&encoded, encoded_data.data(), encoded_data.size());
+  BUF_InitEmpty(&decoded, decoded_data.data(), 2);
+
+  EXPECT_EQ(BUF_SlipDecode(&decoded, &encoded, &decoder), BUF_STUFF_ERROR);
+  BUF_Reset(&decoded);
+  EXPECT_EQ(BUF_SlipDecode(&decoded, &encoded, &decoder), BUF_STUFF_FRAME);
+  EXPECT_EQ(decoded.write_index, 1);
+  EXPECT_EQ(decoded_data[0], 0x05);
+}
+
+/**
+ * \brief Encoders are all or nothing, NULL parameters
+ */
+TEST_F(BUF_Stuff_UT, Encode_001)
+{
+  std::vector<std::uint8_t> payload = {0x7E, 0x7E, 0x7E};
+  BUF_t src;
+  BUF_InitFull(&src, payload.data(), payload.size());
+  BUF_InitEmpty(&encoded, encoded_data.data(), 7);
+
+  EXPECT_EQ(BUF_HdlcEncode(&encoded, &src), 0);
+  EXPECT_EQ(encoded.write_index, 0);
+  EXPECT_EQ(src.read_index, 0);
+  EXPECT_EQ(BUF_CobsEncode(&encoded, &src), 5);
+  EXPECT_EQ(src.read_index, 3);
+  src.read_index = 0;
+  EXPECT_EQ(BUF_SlipEncode(&encoded, &src), 0);
+  EXPECT_EQ(encoded.write_index, 5);
+
+  EXPECT_EQ(BUF_CobsEncode(nullptr, &src), 0);
+  EXPECT_EQ(BUF_SlipEncode(&encoded, nullptr), 0);
+  EXPECT_EQ(BUF_HdlcDecode(&decoded, &encoded, nullptr), BUF_STUFF_ERROR);
+}
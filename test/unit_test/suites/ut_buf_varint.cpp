@@ -0,0 +1,199 @@
+//! \file ut_buf_varint.cpp
+//! \brief Buffer unit test
+//! \date  2024-04
+//! \author Nicolas Boutin
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "buffer/buffer.h"
+}
+
+using namespace testing;
+using ::testing::ElementsAreArray;
+
+class BUF_Varint_UT : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {}
+  // attributes
+  BUF_t buf;
+  std::vector<std::uint8_t> data;
+};
+
+/** \brief Encodings from the LEB128 definition */
+TEST_F(BUF_Varint_UT, WriteVarU32_001)
+{
+  data.assign(16, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteVarU32(&buf, 0), 1);
+  EXPECT_EQ(BUF_WriteVarU32(&buf, 127), 1);
+  EXPECT_EQ(BUF_WriteVarU32(&buf, 128), 2);
+  EXPECT_EQ(BUF_WriteVarU32(&buf, 300), 2);
+  EXPECT_EQ(BUF_WriteVarU32(&buf, 0xFFFFFFFF), 5);
+  EXPECT_EQ(buf.write_index, 11);
+
+  std::vector<std::uint8_t> expected = {0x00, 0x7F, 0x80, 0x01, 0xAC, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+  EXPECT_THAT(std::vector<std::uint8_t>(data.begin(), data.begin() + 11), ElementsAreArray(expected));
+}
+
+/** \brief All or nothing when full */
+TEST_F(BUF_Varint_UT, WriteVarU64_001)
+{
+  data.assign(11, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteVarU64(&buf, 0xFFFFFFFFFFFFFFFF), BUF_VARINT64_MAX_SIZE);
+  EXPECT_EQ(data[9], 0x01);
+  EXPECT_EQ(BUF_WriteVarU64(&buf, 0x80), 0);
+  EXPECT_EQ(buf.write_index, 10);
+  EXPECT_EQ(BUF_WriteVarU64(&buf, 0x7F), 1);
+
+  EXPECT_EQ(BUF_WriteVarU32(nullptr, 1), 0);
+  EXPECT_EQ(BUF_WriteVarU64(nullptr, 1), 0);
+  EXPECT_EQ(BUF_WriteVarS32(nullptr, 1), 0);
+  EXPECT_EQ(BUF_WriteVarS64(nullptr, 1), 0);
+}
+
+/** \brief Zigzag keeps small negative values short */
+TEST_F(BUF_Varint_UT, WriteVarS32_001)
+{
+  data.assign(16, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  EXPECT_EQ(BUF_WriteVarS32(&buf, 0), 1);
+  EXPECT_EQ(BUF_WriteVarS32(&buf, -1), 1);
+  EXPECT_EQ(BUF_WriteVarS32(&buf, 1), 1);
+  EXPECT_EQ(BUF_WriteVarS32(&buf, -64), 1);
+  EXPECT_EQ(BUF_WriteVarS32(&buf, 64), 2);
+  EXPECT_EQ(BUF_WriteVarS32(&buf, std::numeric_limits<std::int32_t>::min()), 5);
+
+  std::vector<std::uint8_t> expected = {0x00, 0x01, 0x02, 0x7F, 0x80, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+  EXPECT_THAT(std::vector<std::uint8_t>(data.begin(), data.begin() + 11), ElementsAreArray(expected));
+}
+
+/** \brief Round trip of limits */
+TEST_F(BUF_Varint_UT, ReadVar_001)
+{
+  data.assign(64, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+
+  BUF_WriteVarU32(&buf, 0xFFFFFFFF);
+  BUF_WriteVarU64(&buf, 0xFFFFFFFFFFFFFFFF);
+  BUF_WriteVarS32(&buf, std::numeric_limits<std::int32_t>::min());
+  BUF_WriteVarS32(&buf, std::numeric_limits<std::int32_t>::max());
+  BUF_WriteVarS64(&buf, std::numeric_limits<std::int64_t>::min());
+  BUF_WriteVarS64(&buf, -300);
+
+  std::uint32_t u32 = 0;
+  std::uint64_t u64 = 0;
+  std::int32_t s32  = 0;
+  std::int64_t s64  = 0;
+  EXPECT_EQ(BUF_ReadVarU32(&buf, &u32), 5);
+  EXPECT_EQ(u32, 0xFFFFFFFF);
+  EXPECT_EQ(BUF_ReadVarU64(&buf, &u64), 10);
+  EXPECT_EQ(u64, 0xFFFFFFFFFFFFFFFF);
+  EXPECT_EQ(BUF_ReadVarS32(&buf, &s32), 5);
+  EXPECT_EQ(s32, std::numeric_limits<std::int32_t>::min());
+  EXPECT_EQ(BUF_ReadVarS32(&buf, &s32), 5);
+  EXPECT_EQ(s32, std::numeric_limits<std::int32_t>::max());
+  EXPECT_EQ(BUF_ReadVarS64(&buf, &s64), 10);
+  EXPECT_EQ(s64, std::numeric_limits<std::int64_t>::min());
+  EXPECT_EQ(BUF_ReadVarS64(&buf, &s64), 2);
+  EXPECT_EQ(s64, -300);
+  EXPECT_EQ(buf.read_index, buf.write_index);
+
+  EXPECT_EQ(BUF_ReadVarU32(&buf, &u32), 0);
+  EXPECT_EQ(BUF_ReadVarU32(nullptr, &u32), 0);
+  EXPECT_EQ(BUF_ReadVarU32(&buf, nullptr), 0);
+  EXPECT_EQ(BUF_ReadVarU64(nullptr, &u64), 0);
+  EXPECT_EQ(BUF_ReadVarS32(nullptr, &s32), 0);
+  EXPECT_EQ(BUF_ReadVarS64(nullptr, &s64), 0);
+}
+
+/** \brief Truncated, too long or too wide varints are rejected */
+TEST_F(BUF_Varint_UT, ReadVar_002)
+{
+  std::uint32_t u32 = 0x55;
+  std::uint64_t u64 = 0x55;
+
+  data = {0x80, 0x80};
+  BUF_InitFull(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_ReadVarU32(&buf, &u32), 0);
+  EXPECT_EQ(buf.read_index, 0);
+
+  data = {0xFF, 0xFF, 0xFF, 0xFF, 0x1F};
+  BUF_InitFull(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_ReadVarU32(&buf, &u32), 0);
+  EXPECT_EQ(BUF_ReadVarU64(&buf, &u64), 5);
+  EXPECT_EQ(u64, 0x1FFFFFFFF);
+
+  data = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+  BUF_InitFull(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_ReadVarU32(&buf, &u32), 0);
+  EXPECT_EQ(u32, 0x55);
+
+  data = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02};
+  BUF_InitFull(&buf, data.data(), data.size());
+  EXPECT_EQ(BUF_ReadVarU64(&buf, &u64), 0);
+  EXPECT_EQ(buf.read_index, 0);
+}
+
+/** \brief Batch decoding matches one by one decoding, SIMD and tail paths */
+TEST_F(BUF_Varint_UT, ReadVarU32Array_001)
+{
+  std::mt19937 rng(1234);
+  std::vector<std::uint32_t> values;
+  for (int i = 0; i < 40; i++)
+  {
+    values.push_back(rng() & 0x7F);
+  }
+  for (int i = 0; i < 500; i++)
+  {
+    values.push_back(rng() >> (rng() % 32));
+  }
+  values.push_back(0xFFFFFFFF);
+
+  data.assign(values.size() * BUF_VARINT32_MAX_SIZE, 0x00);
+  BUF_InitEmpty(&buf, data.data(), data.size());
+  for (auto value : values)
+  {
+    ASSERT_NE(BUF_WriteVarU32(&buf, value), 0);
+  }
+
+  std::vector<std::uint32_t> decoded(values.size() + 4, 0);
+  EXPECT_EQ(BUF_ReadVarU32Array(&buf, decoded.data(), decoded.size()), values.size());
+  EXPECT_EQ(buf.read_index, buf.write_index);
+  decoded.resize(values.size());
+  EXPECT_THAT(decoded, ElementsAreArray(values));
+}
+
+/** \brief Count limit, stop at invalid varint */
+TEST_F(BUF_Varint_UT, ReadVarU32Array_002)
+{
+  data.assign(40, 0x01);
+  data[24] = 0xFF;
+  data[25] = 0xFF;
+  data[26] = 0xFF;
+  data[27] = 0xFF;
+  data[28] = 0x7F;
+  BUF_InitFull(&buf, data.data(), data.size());
+
+  std::vector<std::uint32_t> decoded(40, 0);
+  EXPECT_EQ(BUF_ReadVarU32Array(&buf, decoded.data(), 3), 3);
+  EXPECT_EQ(buf.read_index, 3);
+  EXPECT_EQ(BUF_ReadVarU32Array(&buf, decoded.data(), 40), 21);
+  EXPECT_EQ(buf.read_index, 24);
+  EXPECT_EQ(decoded[20], 0x01);
+
+  EXPECT_EQ(BUF_ReadVarU32Array(nullptr, decoded.data(), 1), 0);
+  EXPECT_EQ(BUF_ReadVarU32Array(&buf, nullptr, 1), 0);
+}
@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Generate slicing-by-8 CRC tables of source/buffer_crc_table.h
+
+Usage: python3 tools/gen_crc_table.py > source/buffer_crc_table.h
+"""
+
+
+def reflected_tables(poly):
+    t0 = []
+    for n in range(256):
+        crc = n
+        for _ in range(8):
+            crc = (crc >> 1) ^ (poly if crc & 1 else 0)
+        t0.append(crc)
+    tables = [t0]
+    for _ in range(7):
+        prev = tables[-1]
+        tables.append([(prev[n] >> 8) ^ t0[prev[n] & 0xFF] for n in range(256)])
+    return tables
+
+
+def crc16_tables(poly):
+    t0 = []
+    for n in range(256):
+        crc = n << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ (poly if crc & 0x8000 else 0)) & 0xFFFF
+        t0.append(crc)
+    tables = [t0]
+    for _ in range(7):
+        prev = tables[-1]
+        tables.append([((prev[n] << 8) & 0xFFFF) ^ t0[prev[n] >> 8] for n in range(256)])
+    return tables
+
+
+def emit(name, ctype, digits, tables):
+    print()
+    print(f"static const {ctype} {name}[8][256] = {{")
+    for table in tables:
+        print("  {")
+        for i in range(0, 256, 8):
+            row = ", ".join(f"0x{v:0{digits}X}U" for v in table[i:i + 8])
+            print(f"    {row},")
+        print("  },")
+    print("};")
+
+
+print("""/**
+ * \\file buffer_crc_table.h
+ * \\brief Buffer for MCU, slicing-by-8 CRC tables
+ * \\date 2024-04
+ * \\author Nicolas Boutin
+ * \\details Generated by tools/gen_crc_table.py, do not edit.
+ * table[0] is the classic bytewise table, table[k][n] is the CRC of byte n
+ * followed by k zero bytes.
+ */
+
+#pragma once
+
+#include <stdint.h>""")
+emit("buf_crc16_ccitt_table", "uint16_t", 4, crc16_tables(0x1021))
+emit("buf_crc32_table", "uint32_t", 8, reflected_tables(0xEDB88320))
+emit("buf_crc32c_table", "uint32_t", 8, reflected_tables(0x82F63B78))